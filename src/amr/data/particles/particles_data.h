@@ -1,6 +1,9 @@
 #ifndef PHARE_SRC_AMR_DATA_PARTICLES_PARTICLES_DATA_H
 #define PHARE_SRC_AMR_DATA_PARTICLES_PARTICLES_DATA_H
 
+#include <array>
+#include <cstdint>
+#include <limits>
 #include <numeric>
 #include <stdexcept>
 
@@ -14,79 +17,33 @@
 #include "data/ions/ion_population/particle_pack.h"
 #include "data/particles/particle.h"
 #include "data/particles/particle_array.h"
+#include "data/particles/particle_memory.h"
 #include "tools/amr_utils.h"
+#include "utilities/memory/memory_pool.h"
 
 namespace PHARE
 {
-template<std::size_t dim>
-static bool isInBox(SAMRAI::hier::Box const& box, Particle<dim> const& particle);
-
-template<>
-bool isInBox(SAMRAI::hier::Box const& box, Particle<1> const& particle)
-{
-    auto const& iCell = particle.iCell;
-
-    auto const& lower = box.lower();
-    auto const& upper = box.upper();
-
-    if (iCell[0] >= lower(0) && iCell[0] <= upper(0))
-    {
-        return true;
-    }
-    return false;
-}
-
-template<>
-inline bool isInBox(SAMRAI::hier::Box const& box, Particle<2> const& particle)
+/** @brief isInBox returns true if the iCell of the particle is in the given box
+ * the particle can be a Particle or a ParticleProxy obtained from a ParticleArray
+ */
+template<typename Particle>
+bool isInBox(SAMRAI::hier::Box const& box, Particle const& particle)
 {
     auto const& iCell = particle.iCell;
 
     auto const& lower = box.lower();
     auto const& upper = box.upper();
 
-
-    if (iCell[0] >= lower(0) && iCell[0] <= upper(0))
+    for (auto iDim = 0u; iDim < Particle::dimension; ++iDim)
     {
-        if (iCell[1] >= lower(1) && iCell[1] <= upper(1))
+        if (iCell[iDim] < lower(iDim) || iCell[iDim] > upper(iDim))
         {
-            return true;
+            return false;
         }
     }
-    return false;
+    return true;
 }
 
-template<>
-inline bool isInBox(SAMRAI::hier::Box const& box, Particle<3> const& particle)
-{
-    auto const& iCell = particle.iCell;
-
-    auto const& lower = box.lower();
-    auto const& upper = box.upper();
-
-
-    if (iCell[0] >= lower(0) && iCell[0] <= upper(0))
-    {
-        if (iCell[1] >= lower(1) && iCell[1] <= upper(1))
-        {
-            if (iCell[2] >= lower(2) && iCell[2] <= upper(2))
-            {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-
-/*template<>
-bool isInBox(SAMRAI::hier::Box const& box, Particle<1> const& particle);
-
-template<>
-bool isInBox(SAMRAI::hier::Box const& box, Particle<1> const& particle);
-
-template<>
-bool isInBox(SAMRAI::hier::Box const& box, Particle<1> const& particle);*/
-
 
 /** @brief ParticlesData is a concrete SAMRAI::hier::PatchData subclass to store Particle data
  *
@@ -118,6 +75,16 @@ template<std::size_t dim>
 class ParticlesData : public SAMRAI::hier::PatchData
 {
 public:
+    //! version of the particle message format written by packStream()
+    static constexpr std::uint32_t streamFormatVersion = 1;
+
+    /** if true, packStream() sends the particle velocities in single precision.
+     * Particles stored in single precision always send their velocities in single precision.
+     */
+    static inline bool streamVelocitiesAsFloat = false;
+
+
+
     ParticlesData(SAMRAI::hier::Box const& box, SAMRAI::hier::IntVector const& ghost)
         : SAMRAI::hier::PatchData::PatchData(box, ghost)
         , pack{&domainParticles, &ghostParticles, &coarseToFineParticles}
@@ -283,9 +250,24 @@ public:
         SAMRAI::pdat::CellOverlap const* pOverlap{
             dynamic_cast<SAMRAI::pdat::CellOverlap const*>(&overlap)};
 
-        std::size_t numberParticles = countNumberParticlesIn_(*pOverlap);
+        TBOX_ASSERT(pOverlap != nullptr);
 
-        return SAMRAI::tbox::MemoryUtilities::align(numberParticles * sizeof(ParticleArray<dim>));
+        if (pOverlap->isOverlapEmpty())
+        {
+            return 0;
+        }
+
+        std::size_t numberParticles = 0;
+        std::size_t numberSegments  = 0;
+
+        forEachStreamBox_(*pOverlap, [&](SAMRAI::hier::Box const& intersectionBox,
+                                         SAMRAI::hier::Transformation const& transformation) {
+            ++numberSegments;
+            forEachParticleToStream_(intersectionBox, transformation,
+                                     [&numberParticles](auto const&) { ++numberParticles; });
+        });
+
+        return SAMRAI::tbox::MemoryUtilities::align(streamSize_(numberSegments, numberParticles));
     }
 
 
@@ -328,6 +310,11 @@ public:
      * at this point with iCell=1 we know the particle should be placed into the interior particle
      * buffer
      *
+     * The stream is made of a header (format version, flags and number of segments) followed
+     * by one segment per destination box of the overlap. A segment has the number of particles,
+     * the lower corner of the intersection box, and then one contiguous array per attribute.
+     * iCell is sent as an int16 offset from the lower corner of the intersection box, and
+     * velocities are sent in single precision if streamVelocitiesAsFloat is set.
      */
     virtual void packStream(SAMRAI::tbox::MessageStream& stream,
                             SAMRAI::hier::BoxOverlap const& overlap) const final
@@ -337,41 +324,29 @@ public:
 
         TBOX_ASSERT(pOverlap != nullptr);
 
-        std::vector<Particle<dim>> specie;
-
         if (pOverlap->isOverlapEmpty())
         {
-            constexpr std::size_t zero = 0;
-            stream << zero;
+            return;
         }
-        else
-        {
-            SAMRAI::hier::Transformation const& transformation = pOverlap->getTransformation();
-            if (transformation.getRotation() == SAMRAI::hier::Transformation::NO_ROTATE)
-            {
-                SAMRAI::hier::BoxContainer const& boxContainer
-                    = pOverlap->getDestinationBoxContainer();
 
-                auto const& sourceBox = getGhostBox();
+        std::uint32_t const flags        = velocitiesAsFloat_() ? floatVelocitiesFlag_ : 0;
+        std::size_t const numberSegments = pOverlap->getDestinationBoxContainer().size();
 
-                SAMRAI::hier::Box transformedSource{sourceBox};
-                transformation.transform(transformedSource);
+        stream << streamFormatVersion;
+        stream << flags;
+        stream << numberSegments;
 
+        ParticleArray<dim> segment;
 
-                for (auto const& destinationBox : boxContainer)
-                {
-                    SAMRAI::hier::Box intersectionBox{transformedSource * destinationBox};
+        forEachStreamBox_(*pOverlap, [&](SAMRAI::hier::Box const& intersectionBox,
+                                         SAMRAI::hier::Transformation const& transformation) {
+            segment.clear();
+            forEachParticleToStream_(
+                intersectionBox, transformation,
+                [&segment](auto const& particle) { segment.push_back(particle); });
 
-                    pack_(specie, intersectionBox, sourceBox, transformation);
-                }
-            }
-            else
-            {
-                throw std::runtime_error("Error - rotations not handled in PHARE");
-            }
-            stream << specie.size();
-            stream.pack(specie.data(), specie.size());
-        }
+            packSegment_(stream, segment, intersectionBox);
+        });
     }
 
 
@@ -396,80 +371,62 @@ public:
             = dynamic_cast<SAMRAI::pdat::CellOverlap const*>(&overlap);
         TBOX_ASSERT(pOverlap != nullptr);
 
-        std::vector<Particle<dim>> particleArray;
+        if (pOverlap->isOverlapEmpty())
+        {
+            return;
+        }
 
-        if (!pOverlap->isOverlapEmpty())
+        if (pOverlap->getTransformation().getRotation()
+            != SAMRAI::hier::Transformation::NO_ROTATE)
         {
-            // unpack particles into a particle array
-            size_t numberParticles = 0;
-            stream >> numberParticles;
-            particleArray.resize(numberParticles);
-            stream.unpack(particleArray.data(), numberParticles);
+            throw std::runtime_error("Error - rotations not handled in PHARE");
+        }
 
-            // ok now our goal is to put the particles we have just unpacked
-            // into the particleData and in the proper particleArray : interior or ghost
+        std::uint32_t version = 0;
+        std::uint32_t flags   = 0;
+        std::size_t numberSegments{0};
 
-            SAMRAI::hier::Transformation const& transformation = pOverlap->getTransformation();
-            if (transformation.getRotation() == SAMRAI::hier::Transformation::NO_ROTATE)
-            {
-                // we loop over all boxes in the overlap
-                // we have to first take the intersection of each of these boxes
-                // with our ghostBox. This is where unpacked particles should go.
+        stream >> version;
+        if (version != streamFormatVersion)
+        {
+            throw std::runtime_error("Error - unknown particle stream format version");
+        }
+        stream >> flags;
+        stream >> numberSegments;
 
-                SAMRAI::hier::BoxContainer const& destinationBoxes
-                    = pOverlap->getDestinationBoxContainer();
+        SAMRAI::hier::BoxContainer const& destinationBoxes = pOverlap->getDestinationBoxContainer();
+        if (numberSegments != static_cast<std::size_t>(destinationBoxes.size()))
+        {
+            throw std::runtime_error("Error - particle stream does not match the overlap");
+        }
 
-                auto myBox      = getBox();
-                auto myGhostBox = getGhostBox();
+        bool const floatVelocities = (flags & floatVelocitiesFlag_) != 0;
 
-                for (auto const& box : destinationBoxes)
-                {
-                    // our goal here is :
-                    // 1/ to check if the each particle is in the intersect of the overlap boxes and
-                    // our ghostBox 2/ if yes, check if these particles should go within the
-                    // interior array or ghost array
-
-                    // first we need to calculate the intersect between our ghostBox and the
-                    // overlapBox these and the resulting intersect are in AMR index space unpacked
-                    // particles have their iCell in our AMR index space. we could :
-                    //  1- compare their iCell with the intersect right away, if within shit them to
-                    //  local indexing and push them in proper array
-                    // or
-                    // 2- translate the intersect from  AMR to local indexing, shift the particles
-                    // from AMR to local, and do the comparison in local index space and then push
-                    // them in the proper array
-
-                    auto const intersect = getGhostBox() * box;
-
-
-                    // we chose first option, so get the intersect in local index space
-                    // and get the vector to shift a particle from our AMR space to local index
-                    // space
-                    // auto intersectLocalSource = AMRToLocal(intersect, getGhostBox());
-                    // auto particleShift        = AMRToLocal(getGhostBox());
-
-                    for (auto const& particle : particleArray)
-                    {
-                        // shift the particle to local index space
-                        // and if it is in intersection, decide in which array to push it.
-                        // auto shiftedParticle{particle};
-                        // shiftParticle_(particleShift, shiftedParticle);
+        auto const myBox      = getBox();
+        auto const myGhostBox = getGhostBox();
 
-                        if (isInBox(intersect, particle))
-                        {
-                            if (isInBox(myBox, particle))
-                            {
-                                domainParticles.push_back(std::move(particle));
-                            }
-                            else
-                            {
-                                ghostParticles.push_back(std::move(particle));
-                            }
-                        }
-                    } // end species loop
-                }     // end box loop
-            }         // end no rotation
-        }             // end overlap not empty
+        // there is one segment per destination box, in the order of the container, and
+        // the particles of a segment are in its box. A segment whose box is in our domain,
+        // or in our ghost layer, is decoded at the end of the array where its particles go.
+        // Otherwise it is decoded at the end of the ghost array, and its particles are then
+        // sorted between the domain and the ghost arrays.
+        for (auto const& box : destinationBoxes)
+        {
+            if (myBox.contains(box))
+            {
+                unpackSegment_(stream, domainParticles, floatVelocities);
+            }
+            else if (myGhostBox.contains(box) && !myBox.intersects(box))
+            {
+                unpackSegment_(stream, ghostParticles, floatVelocities);
+            }
+            else
+            {
+                auto const first = ghostParticles.size();
+                unpackSegment_(stream, ghostParticles, floatVelocities);
+                sortUnpackedGhosts_(first, myGhostBox * box, myBox);
+            }
+        }
     }
 
 
@@ -478,6 +435,57 @@ public:
 
 
 
+
+    /** @brief calls function(name, particleArray) for each particle array of the patch data
+     */
+    template<typename Function>
+    void forEachParticleArray(Function&& function)
+    {
+        function("domain", domainParticles);
+        function("ghost", ghostParticles);
+        function("coarseToFine", coarseToFineParticles);
+        function("coarseToFineOld", coarseToFineParticlesOld);
+        function("coarseToFineNew", coarseToFineParticlesNew);
+    }
+
+    template<typename Function>
+    void forEachParticleArray(Function&& function) const
+    {
+        function("domain", domainParticles);
+        function("ghost", ghostParticles);
+        function("coarseToFine", coarseToFineParticles);
+        function("coarseToFineOld", coarseToFineParticlesOld);
+        function("coarseToFineNew", coarseToFineParticlesNew);
+    }
+
+
+
+
+    //! memory used by all the particle arrays of the patch data
+    ParticleMemoryUsage memoryUsage() const
+    {
+        ParticleMemoryUsage usage;
+        forEachParticleArray(
+            [&usage](auto const&, auto const& particles) { usage += memoryUsageOf(particles); });
+        return usage;
+    }
+
+
+    //! applies the shrink policy to all particle arrays, returns the number of shrunk arrays
+    std::size_t shrink(ParticleShrinkPolicy const& policy)
+    {
+        std::size_t nbrShrunk = 0;
+        forEachParticleArray([&nbrShrunk, &policy](auto const&, auto& particles) {
+            if (PHARE::shrink(particles, policy))
+            {
+                ++nbrShrunk;
+            }
+        });
+        return nbrShrunk;
+    }
+
+
+
     // Core interface
     // these particles arrays are public because core module is free to use
     // them easily
@@ -558,7 +566,7 @@ private:
                 // the particle is only copied if it is in the intersectionBox
                 // but before its iCell must be shifted by the transformation offset
 
-                auto newParticle{particle};
+                Particle<dim> newParticle = particle;
                 for (auto iDir = 0; iDir < newParticle.iCell.size(); ++iDir)
                 {
                     newParticle.iCell[iDir] += offset[iDir];
@@ -596,81 +604,224 @@ private:
 
 
     /**
-     * @brief countNumberParticlesIn_ counts the number of interior particles that lie
-     * within the boxes of an overlap
+     * @brief forEachStreamBox_ calls function(intersectionBox, transformation) for each
+     * destination box of the overlap, intersectionBox being the intersection of the
+     * destination box with our transformed ghost box.
      */
-    std::size_t countNumberParticlesIn_(SAMRAI::pdat::CellOverlap const& overlap) const
+    template<typename Function>
+    void forEachStreamBox_(SAMRAI::pdat::CellOverlap const& overlap, Function&& function) const
     {
-        std::size_t numberParticles = 0;
-
-        if (overlap.isOverlapEmpty())
+        SAMRAI::hier::Transformation const& transformation = overlap.getTransformation();
+        if (transformation.getRotation() != SAMRAI::hier::Transformation::NO_ROTATE)
         {
-            return numberParticles;
+            throw std::runtime_error("Error - rotations not handled in PHARE");
         }
 
-        auto const& boxes = overlap.getDestinationBoxContainer();
+        SAMRAI::hier::Box transformedSource{getGhostBox()};
+        transformation.transform(transformedSource);
 
-        for (auto const& box : boxes)
+        for (auto const& destinationBox : overlap.getDestinationBoxContainer())
         {
-            SAMRAI::hier::Box shiftedBox{box};
-            SAMRAI::hier::Transformation const& transformation = overlap.getTransformation();
-            transformation.transform(shiftedBox);
-            SAMRAI::hier::Box intersectionBox{shiftedBox * getBox()};
-
-            numberParticles += countNumberParticlesIn_(intersectionBox);
+            SAMRAI::hier::Box intersectionBox{transformedSource * destinationBox};
+            function(intersectionBox, transformation);
         }
-        return numberParticles;
     }
 
 
+
+
     /**
-     * @brief countNumberParticlesIn_ returns the number of interior particles within a given box
-     *
-     * the box given is in AMR index space so the function first needs to put it in
-     * local indexing relative to the domain box
+     * @brief forEachParticleToStream_ calls function(shiftedParticle) for each of our
+     * domain and ghost particles which, shifted by the offset of the transformation,
+     * lies in the intersection box
      */
-    std::size_t countNumberParticlesIn_(SAMRAI::hier::Box const& box) const
+    template<typename Function>
+    void forEachParticleToStream_(SAMRAI::hier::Box const& intersectionBox,
+                                  SAMRAI::hier::Transformation const& transformation,
+                                  Function&& function) const
     {
-        std::size_t numberParticles{0};
+        std::array<decltype(domainParticles) const*, 2> particlesArrays{&domainParticles,
+                                                                        &ghostParticles};
 
-        auto localSourceBox = AMRToLocal(box, getBox());
+        auto const& offset = transformation.getOffset();
 
-        for (auto const& particle : domainParticles)
+        for (auto const& sourceParticlesArray : particlesArrays)
         {
-            if (isInBox(localSourceBox, particle))
+            for (auto const& particle : *sourceParticlesArray)
             {
-                ++numberParticles;
+                Particle<dim> shiftedParticle = particle;
+                for (auto i = 0u; i < dim; ++i)
+                {
+                    shiftedParticle.iCell[i] += offset[i];
+                }
+                if (isInBox(intersectionBox, shiftedParticle))
+                {
+                    function(shiftedParticle);
+                }
             }
         }
-        return numberParticles;
     }
 
 
 
 
-    void pack_(std::vector<Particle<dim>>& buffer, SAMRAI::hier::Box const& intersectionBox,
-               SAMRAI::hier::Box const& sourceBox,
-               SAMRAI::hier::Transformation const& transformation) const
+    using weight_type   = typename ParticleArray<dim>::weight_type;
+    using velocity_type = typename ParticleArray<dim>::velocity_type;
+
+    static constexpr std::uint32_t floatVelocitiesFlag_ = 1;
+
+
+    static bool velocitiesAsFloat_()
     {
-        std::array<decltype(domainParticles) const*, 2> particlesArrays{&domainParticles,
-                                                                        &ghostParticles};
+        return streamVelocitiesAsFloat || std::is_same_v<velocity_type, float>;
+    }
 
-        for (auto const& sourceParticlesArray : particlesArrays)
+
+    //! upper bound of the number of bytes packStream writes for these numbers of particles
+    static std::size_t streamSize_(std::size_t numberSegments, std::size_t numberParticles)
+    {
+        std::size_t const headerSize  = 2 * sizeof(std::uint32_t) + sizeof(std::size_t);
+        std::size_t const segmentSize = sizeof(std::size_t) + sizeof(std::array<int, dim>);
+
+        std::size_t const velocitySize = velocitiesAsFloat_() ? sizeof(float) : sizeof(double);
+        std::size_t const particleSize = sizeof(weight_type) + dim * sizeof(std::int16_t)
+                                         + dim * sizeof(float) + 3 * velocitySize;
+
+        return headerSize + numberSegments * segmentSize + numberParticles * particleSize;
+    }
+
+
+
+
+    static void packSegment_(SAMRAI::tbox::MessageStream& stream,
+                             ParticleArray<dim> const& segment,
+                             SAMRAI::hier::Box const& intersectionBox)
+    {
+        auto const numberParticles = segment.size();
+
+        std::array<int, dim> origin;
+        for (auto iDim = 0u; iDim < dim; ++iDim)
         {
-            for (auto const& particle : *sourceParticlesArray)
+            origin[iDim] = intersectionBox.lower(iDim);
+        }
+
+        stream << numberParticles;
+        stream.pack(origin.data(), dim);
+
+        stream.pack(segment.weights().data(), numberParticles);
+
+        // particles are in the intersection box, so their iCell is a small positive
+        // offset from its lower corner
+        PooledVector<std::array<std::int16_t, dim>> relativeCells(numberParticles);
+        for (auto iPart = 0u; iPart < numberParticles; ++iPart)
+        {
+            for (auto iDim = 0u; iDim < dim; ++iDim)
             {
-                auto shiftedParticle{particle};
-                auto offset = transformation.getOffset();
-                for (auto i = 0; i < dim; ++i)
+                auto relativeCell = segment.iCells()[iPart][iDim] - origin[iDim];
+                if (relativeCell < 0 || relativeCell > std::numeric_limits<std::int16_t>::max())
                 {
-                    shiftedParticle.iCell[i] += offset[i];
+                    throw std::runtime_error("Error - particle iCell cannot be streamed as int16");
                 }
-                if (isInBox(intersectionBox, shiftedParticle))
+                relativeCells[iPart][iDim] = static_cast<std::int16_t>(relativeCell);
+            }
+        }
+        stream.pack(relativeCells.data(), numberParticles);
+
+        stream.pack(segment.deltas().data(), numberParticles);
+
+        if (velocitiesAsFloat_() && !std::is_same_v<velocity_type, float>)
+        {
+            auto const& sourceVelocities = segment.velocities();
+
+            PooledVector<std::array<float, 3>> velocities(numberParticles);
+            for (auto iPart = 0u; iPart < numberParticles; ++iPart)
+            {
+                for (auto iComp = 0u; iComp < 3; ++iComp)
+                {
+                    velocities[iPart][iComp] = static_cast<float>(sourceVelocities[iPart][iComp]);
+                }
+            }
+            stream.pack(velocities.data(), numberParticles);
+        }
+        else
+        {
+            stream.pack(segment.velocities().data(), numberParticles);
+        }
+    }
+
+
+
+
+    /** moves the particles unpacked at the end of the ghost array from index first that are
+     * in our domain to the domain array, and drops those outside of the intersection of the
+     * destination box with our ghost box
+     */
+    void sortUnpackedGhosts_(std::size_t first, SAMRAI::hier::Box const& intersect,
+                             SAMRAI::hier::Box const& myBox)
+    {
+        auto kept = first;
+        for (auto iPart = first; iPart < ghostParticles.size(); ++iPart)
+        {
+            auto const particle = ghostParticles[iPart];
+            if (isInBox(intersect, particle))
+            {
+                if (isInBox(myBox, particle))
+                {
+                    domainParticles.push_back(particle);
+                }
+                else
                 {
-                    buffer.push_back(shiftedParticle);
+                    ghostParticles[kept++] = particle;
                 }
             }
         }
+        ghostParticles.resize(kept);
+    }
+
+
+    //! decodes a segment written by packSegment_ at the end of 'particles'
+    static void unpackSegment_(SAMRAI::tbox::MessageStream& stream, ParticleArray<dim>& particles,
+                               bool floatVelocities)
+    {
+        std::size_t numberParticles{0};
+        std::array<int, dim> origin;
+
+        stream >> numberParticles;
+        stream.unpack(origin.data(), dim);
+
+        auto const first = particles.size();
+        particles.resize(first + numberParticles);
+
+        stream.unpack(particles.weights().data() + first, numberParticles);
+
+        PooledVector<std::array<std::int16_t, dim>> relativeCells(numberParticles);
+        stream.unpack(relativeCells.data(), numberParticles);
+        for (auto iPart = 0u; iPart < numberParticles; ++iPart)
+        {
+            for (auto iDim = 0u; iDim < dim; ++iDim)
+            {
+                particles.iCells()[first + iPart][iDim] = origin[iDim] + relativeCells[iPart][iDim];
+            }
+        }
+
+        stream.unpack(particles.deltas().data() + first, numberParticles);
+
+        if (floatVelocities && !std::is_same_v<velocity_type, float>)
+        {
+            PooledVector<std::array<float, 3>> velocities(numberParticles);
+            stream.unpack(velocities.data(), numberParticles);
+            for (auto iPart = 0u; iPart < numberParticles; ++iPart)
+            {
+                for (auto iComp = 0u; iComp < 3; ++iComp)
+                {
+                    particles.velocities()[first + iPart][iComp] = velocities[iPart][iComp];
+                }
+            }
+        }
+        else
+        {
+            stream.unpack(particles.velocities().data() + first, numberParticles);
+        }
     }
 };
 
@@ -171,6 +171,9 @@ private:
 
         SplitT split{Point<int32, dim>{ratio}, refinedParticleNbr};
 
+        // the buffer of the split particles is reused for all coarse particles
+        PooledVector<Particle<dim>> refinedParticles;
+
 
         // The PatchLevelFillPattern had compute boxes that correspond to the expected filling.
         // In case of a coarseBoundary it will most likely give multiple boxes
@@ -184,13 +187,12 @@ private:
             auto isInDest = [&destinationBox](auto const& particle) //
             { return isInBox(destinationBox, particle); };
 
-
             for (auto const& sourceParticlesArray : particlesArrays)
             {
                 for (auto const& particle : *sourceParticlesArray)
                 {
-                    std::vector<Particle<dim>> refinedParticles;
-                    auto particleRefinedPos{particle};
+                    refinedParticles.clear();
+                    Particle<dim> particleRefinedPos = particle;
 
                     for (int iDim = 0; iDim < dim; ++iDim)
                     {
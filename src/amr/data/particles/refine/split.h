@@ -10,6 +10,7 @@
 #include "data/grid/gridlayout.h"
 #include "data/particles/particle.h"
 #include "utilities/box/box.h"
+#include "utilities/memory/memory_pool.h"
 #include "utilities/types.h"
 
 namespace PHARE
@@ -147,7 +148,7 @@ public:
 
 
     inline void operator()(Particle<dimension> const& coarsePartOnRefinedGrid,
-                           std::vector<Particle<dimension>>& refinedParticles) const
+                           PooledVector<Particle<dimension>>& refinedParticles) const
     {
         for (uint32 refinedParticleIndex = 0; refinedParticleIndex < refinedParticlesNbr_;
              ++refinedParticleIndex)
@@ -166,11 +167,8 @@ public:
                 delta -= integra;
                 icell += static_cast<int32>(integra);
 
-                refinedParticles.push_back({weight,
-                                            coarsePartOnRefinedGrid.charge,
-                                            {{icell}},
-                                            {{delta}},
-                                            coarsePartOnRefinedGrid.v});
+                refinedParticles.push_back(
+                    {weight, {{icell}}, {{delta}}, coarsePartOnRefinedGrid.v});
             }
             else // unsupported dimension
             {
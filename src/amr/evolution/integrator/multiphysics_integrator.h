@@ -23,6 +23,7 @@
 #include "evolution/messengers/messenger_initializer.h"
 #include "evolution/messengers/mhd_messenger.h"
 #include "utilities/algorithm.h"
+#include "utilities/memory/memory_pool.h"
 
 
 
@@ -245,7 +246,8 @@ public:
      * - the messenger (the messenger has data defined on patches for internal reasons)
      *
      *
-     * then the level needs to be registered to the messenger.
+     * then the level needs to be registered to the messenger, and the solver told that the level
+     * is new.
      *
      * Then data initialization per se begins and one can be on one of the following cases:
      *
@@ -280,6 +282,7 @@ public:
 
 
         messenger.registerLevel(hierarchy, levelNumber);
+        solver.initializeLevel(levelNumber);
 
 
         // on est en train de changer la hierarchy soit en créant un nouveau niveau (finest)
@@ -319,6 +322,10 @@ public:
     resetHierarchyConfiguration(const std::shared_ptr<SAMRAI::hier::PatchHierarchy>& hierarchy,
                                 const int coarsestLevel, const int finestLevel) override
     {
+        // the particle arrays of the levels replaced by the regrid are gone, and the next
+        // steps will not need the same buffers, the memory cached for them by the pools
+        // goes back to the system
+        MemoryPool::releaseAll();
     }
 
 
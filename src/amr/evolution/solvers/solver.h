@@ -80,6 +80,15 @@ public:
 
 
 
+    /**
+     * @brief initializeLevel is called when the given level is created or regridded, so that
+     * the ISolver resets what it keeps about the previous level with that number.
+     */
+    virtual void initializeLevel(int const levelNumber) = 0;
+
+
+
+
     virtual ~ISolver() = default;
 
 
@@ -36,6 +36,8 @@ public:
     {
     }
 
+    virtual void initializeLevel(int const levelNumber) override {}
+
     virtual void advanceLevel(std::shared_ptr<SAMRAI::hier::PatchHierarchy> const& hierarchy,
                               int const levelNumber, IPhysicalModel& model, IMessenger& fromCoarser,
                               const double currentTime, const double newTime) override
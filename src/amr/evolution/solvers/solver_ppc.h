@@ -3,12 +3,18 @@
 #ifndef PHARE_SOLVER_PPC_H
 #define PHARE_SOLVER_PPC_H
 
+#include <unordered_map>
+
 #include <SAMRAI/hier/Patch.h>
+#include <SAMRAI/hier/PatchLevel.h>
 
 
 #include "evolution/messengers/hybrid_messenger.h"
 #include "evolution/messengers/hybrid_messenger_info.h"
 #include "evolution/solvers/solver.h"
+#include "data/particles/particle_memory.h"
+#include "numerics/moments/moments.h"
+#include "utilities/types.h"
 
 namespace PHARE
 {
@@ -20,9 +26,19 @@ private:
     using IonsT      = decltype(std::declval<HybridModel>().state.ions);
     using VecFieldT  = decltype(std::declval<HybridModel>().state.electromag.E);
 
+    using GridLayout = typename HybridModel::gridLayout_type;
+
     Electromag electromagPred_{"EMPred"};
     Electromag electromagAvg_{"EMAvg"};
 
+    IonMoments<GridLayout> ionMoments_;
+
+    //! number of times each level has been advanced, tells which ion populations are pushed
+    std::unordered_map<int, uint32> levelSteps_;
+
+    //! applied to the particle arrays of the ions at the end of each step
+    ParticleShrinkPolicy particleShrinkPolicy_;
+
 
 public:
     explicit SolverPPC()
@@ -73,6 +89,20 @@ public:
 
 
 
+    void setParticleShrinkPolicy(ParticleShrinkPolicy const& policy)
+    {
+        particleShrinkPolicy_ = policy;
+    }
+
+
+
+
+    //! the first step of a new or regridded level pushes all the ion populations
+    virtual void initializeLevel(int const levelNumber) override { levelSteps_[levelNumber] = 0; }
+
+
+
+
     virtual void advanceLevel(std::shared_ptr<SAMRAI::hier::PatchHierarchy> const& hierarchy,
                               int const levelNumber, IPhysicalModel& model,
                               IMessenger& fromCoarserMessenger, const double currentTime,
@@ -84,6 +114,11 @@ public:
         auto& hybridState = hybridModel.state;
         auto& fromCoarser = dynamic_cast<HybridMessenger<HybridModel>&>(fromCoarserMessenger);
 
+        // subcycled populations are only pushed at some steps, their moments
+        // before the push are saved to interpolate them until the next push
+        auto const step = levelSteps_[levelNumber]++;
+        saveSubcycledMoments_(hybridModel, *hierarchy->getPatchLevel(levelNumber), step);
+
 
         /*
          * PREDICTOR 1
@@ -121,6 +156,9 @@ public:
         //  - coarse to fine ghost region
         // accumulate those that are within the domain after being pushed (before pivot)
         // see particle design code
+        // only populations for which pop.isPushedAt(step) are moved, with
+        // pop.pushTimeStep(newTime - currentTime). The moments of the others are
+        // interpolated with pop.addDensityAt(step, ...) and pop.addFluxAt(step, ...)
 
         // now some of the nodes close to the boundary of the patches (and level)
         // are incomplete because they may have recieved contributions from particles outside
@@ -128,7 +166,9 @@ public:
         // therefore we need to re-fill the purple region and accumulate that density
         // this is done by calling a messenger to fill the moments.
 
+        computeIonMoments_(hybridModel, *hierarchy->getPatchLevel(levelNumber), step);
         fromCoarser.fillIonMomentGhosts(hybridState.ions, levelNumber, newTime);
+        computeBulkVelocity_(hybridModel, *hierarchy->getPatchLevel(levelNumber));
 
 
 
@@ -169,7 +209,9 @@ public:
         // same as for predictor 1, except that we will updates the ions
         // populations
 
+        computeIonMoments_(hybridModel, *hierarchy->getPatchLevel(levelNumber), step);
         fromCoarser.fillIonMomentGhosts(hybridState.ions, levelNumber, newTime);
+        computeBulkVelocity_(hybridModel, *hierarchy->getPatchLevel(levelNumber));
 
 
         // needs predictor2 boolean
@@ -196,9 +238,62 @@ public:
         fromCoarser.fillElectricGhosts(E, levelNumber, newTime);
 
 
+        // the particle arrays of the ions may have grown far beyond their number of
+        // particles during the step, the memory they do not need goes back to the system
+        hybridModel.resourcesManager->shrinkParticles(
+            hybridState.ions, *hierarchy->getPatchLevel(levelNumber), particleShrinkPolicy_);
+
+
         // double newTime = 0.0;
         // return newTime;
     }
+
+
+private:
+    void saveSubcycledMoments_(HybridModel& model, SAMRAI::hier::PatchLevel& level, uint32 step)
+    {
+        auto& ions = model.state.ions;
+        for (auto& patch : level)
+        {
+            auto dataOnPatch = model.resourcesManager->setOnPatch(*patch, ions);
+
+            for (auto& pop : ions)
+            {
+                if (pop.isSubcycled() && pop.isPushedAt(step))
+                {
+                    pop.saveMoments();
+                }
+            }
+        }
+    }
+
+
+    /** deposits the moments of the ions of each patch of the level, populations and totals
+     * in one pass over the particles, see IonMoments
+     */
+    void computeIonMoments_(HybridModel& model, SAMRAI::hier::PatchLevel& level, uint32 step)
+    {
+        auto& ions = model.state.ions;
+        for (auto& patch : level)
+        {
+            auto dataOnPatch = model.resourcesManager->setOnPatch(*patch, ions);
+            ionMoments_(ions, step);
+        }
+    }
+
+
+    //! the bulk velocity needs the moments on the ghost nodes, which must have been filled
+    void computeBulkVelocity_(HybridModel& model, SAMRAI::hier::PatchLevel& level)
+    {
+        auto& ions = model.state.ions;
+        for (auto& patch : level)
+        {
+            auto dataOnPatch = model.resourcesManager->setOnPatch(*patch, ions);
+            ions.computeBulkVelocity();
+        }
+    }
+
+
     /*
     template<typename HybridMessenger>
     void syncLevel(HybridMessenger& toCoarser)
@@ -9,6 +9,7 @@
 
 
 #include <SAMRAI/hier/Patch.h>
+#include <SAMRAI/hier/PatchLevel.h>
 #include <SAMRAI/hier/VariableDatabase.h>
 
 
@@ -262,6 +263,39 @@ public:
 
 
 
+    /** @brief particleMemoryUsage sums the memory used by the particle arrays of the
+     * ResourcesUser on all patches of the level.
+     */
+    template<typename ResourcesUser>
+    ParticleMemoryUsage particleMemoryUsage(ResourcesUser& obj,
+                                            SAMRAI::hier::PatchLevel const& level) const
+    {
+        ParticleMemoryUsage usage;
+        forEachParticlesData_(obj, level, [&usage](auto& particlesData) {
+            usage += particlesData.memoryUsage();
+        });
+        return usage;
+    }
+
+
+
+    /** @brief shrinkParticles applies the shrink policy to the particle arrays of the
+     * ResourcesUser on all patches of the level, e.g. after a regrid or at the end of a step.
+     * Returns the number of arrays that have been shrunk.
+     */
+    template<typename ResourcesUser>
+    std::size_t shrinkParticles(ResourcesUser& obj, SAMRAI::hier::PatchLevel const& level,
+                                ParticleShrinkPolicy const& policy) const
+    {
+        std::size_t nbrShrunk = 0;
+        forEachParticlesData_(obj, level, [&nbrShrunk, &policy](auto& particlesData) {
+            nbrShrunk += particlesData.shrink(policy);
+        });
+        return nbrShrunk;
+    }
+
+
+
     ~ResourcesManager()
     {
         for (auto& [key, resourcesInfo] : nameToResourceInfo_)
@@ -331,6 +365,29 @@ private:
     }
 
 
+    //! calls function(particlesData) for all ParticlesData of the ResourcesUser on the level
+    template<typename ResourcesUser, typename Function>
+    void forEachParticlesData_(ResourcesUser& obj, SAMRAI::hier::PatchLevel const& level,
+                               Function&& function) const
+    {
+        using particles_data_type = ParticlesData<GridLayoutT::dimension>;
+
+        auto IDs = getIDs(obj);
+        for (auto const& patch : level)
+        {
+            for (auto const& id : IDs)
+            {
+                auto particlesData
+                    = std::dynamic_pointer_cast<particles_data_type>(patch->getPatchData(id));
+                if (particlesData)
+                {
+                    function(*particlesData);
+                }
+            }
+        }
+    }
+
+
     // The function getResourcesPointer_ is the one that depending
     // on NullOrResourcePtr will choose to return
     // the real pointer or a nullptr to the correct type.
@@ -0,0 +1,45 @@
+#ifndef PHARE_CORE_DATA_ELECTROMAG_ELECTROMAG_AT_PARTICLES_H
+#define PHARE_CORE_DATA_ELECTROMAG_ELECTROMAG_AT_PARTICLES_H
+
+#include <cstddef>
+
+#include "utilities/memory/aligned_allocator.h"
+
+namespace PHARE
+{
+/** @brief ElectromagAtParticles holds the electric and magnetic fields interpolated
+ * at the position of a set of particles.
+ *
+ * The i-th element of each component is the field seen by the i-th particle of the
+ * range given to the Interpolator. These values are only needed between the interpolation
+ * and the acceleration of the particles, so they are not stored in the particles
+ * but in a scratch buffer owned by the pusher and reused chunk after chunk.
+ */
+struct ElectromagAtParticles
+{
+    ElectromagAtParticles() = default;
+
+    explicit ElectromagAtParticles(std::size_t size) { resize(size); }
+
+
+    std::size_t size() const { return Ex.size(); }
+
+
+    void resize(std::size_t size)
+    {
+        Ex.resize(size);
+        Ey.resize(size);
+        Ez.resize(size);
+        Bx.resize(size);
+        By.resize(size);
+        Bz.resize(size);
+    }
+
+
+    AlignedVector<double> Ex, Ey, Ez;
+    AlignedVector<double> Bx, By, Bz;
+};
+
+} // namespace PHARE
+
+#endif
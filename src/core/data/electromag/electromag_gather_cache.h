@@ -0,0 +1,176 @@
+#ifndef PHARE_CORE_DATA_ELECTROMAG_ELECTROMAG_GATHER_CACHE_H
+#define PHARE_CORE_DATA_ELECTROMAG_ELECTROMAG_GATHER_CACHE_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "data/vecfield/vecfield_component.h"
+#include "utilities/memory/aligned_allocator.h"
+
+namespace PHARE
+{
+/** @brief ElectromagGatherCache is a copy of the six components of E and B of a patch where
+ * the values of all components at a given index are next to each other in memory.
+ *
+ * The Interpolator reads, for each particle and each component, the nodes of the support of
+ * the particle. With one array per component, this makes six streams of scattered loads.
+ * In the cache, node (i, j, k) holds Ex(i, j, k), Ey(i, j, k) ... Bz(i, j, k), so the six
+ * components seen by a particle are read from the same few cache lines.
+ *
+ * The cache covers the largest extent of the six components in each direction, nodes
+ * outside of a component (e.g. the last node of a dual component) hold zero.
+ * The cache is a copy: it has to be updated when the fields have changed, and it is read by
+ * Interpolator::gather(), which is only given the cache.
+ */
+template<std::size_t dim>
+class ElectromagGatherCache
+{
+public:
+    static constexpr std::size_t dimension     = dim;
+    static constexpr std::size_t nbrComponents = 6;
+
+
+    //! one component of the cache, read with the same operator() as a Field
+    class ComponentView
+    {
+    public:
+        ComponentView(double const* data, std::array<std::size_t, dim> const& strides)
+            : data_{data}
+            , strides_{strides}
+        {
+        }
+
+        double operator()(std::uint32_t i) const { return data_[i * nbrComponents]; }
+
+        double operator()(std::uint32_t i, std::uint32_t j) const
+        {
+            return data_[i * strides_[0] + j * nbrComponents];
+        }
+
+        double operator()(std::uint32_t i, std::uint32_t j, std::uint32_t k) const
+        {
+            return data_[i * strides_[0] + j * strides_[1] + k * nbrComponents];
+        }
+
+    private:
+        double const* data_;
+        std::array<std::size_t, dim> strides_;
+    };
+
+
+
+
+    /** @brief copies the components of em.E and em.B in the cache, in the order
+     * Ex, Ey, Ez, Bx, By, Bz
+     */
+    template<typename Electromag>
+    void update(Electromag const& em)
+    {
+        auto const fields = fieldsOf_(em);
+
+        std::array<std::uint32_t, dim> shape{};
+        for (auto const* field : fields)
+        {
+            auto const fieldShape = field->shape();
+            for (auto iDim = 0u; iDim < dim; ++iDim)
+            {
+                shape[iDim] = std::max(shape[iDim], fieldShape[iDim]);
+            }
+        }
+
+        if (shape != shape_)
+        {
+            shape_ = shape;
+
+            std::size_t nbrNodes = 1;
+            for (auto iDim = static_cast<int>(dim) - 1; iDim >= 0; --iDim)
+            {
+                strides_[iDim] = nbrNodes * nbrComponents;
+                nbrNodes *= shape_[iDim];
+            }
+
+            // padding nodes are never written, they stay at zero
+            data_.assign(nbrNodes * nbrComponents, 0.);
+        }
+
+        for (auto iComponent = 0u; iComponent < nbrComponents; ++iComponent)
+        {
+            copy_(*fields[iComponent], iComponent);
+        }
+    }
+
+
+
+
+    ComponentView component(std::size_t iComponent) const
+    {
+        return ComponentView{data_.data() + iComponent, strides_};
+    }
+
+
+    std::array<std::uint32_t, dim> const& shape() const { return shape_; }
+
+
+
+private:
+    template<typename Electromag>
+    static auto fieldsOf_(Electromag const& em)
+    {
+        using field_type = typename Electromag::vecfield_type::field_type;
+        return std::array<field_type const*, nbrComponents>{
+            {&em.E.getComponent(Component::X), &em.E.getComponent(Component::Y),
+             &em.E.getComponent(Component::Z), &em.B.getComponent(Component::X),
+             &em.B.getComponent(Component::Y), &em.B.getComponent(Component::Z)}};
+    }
+
+
+    template<typename Field>
+    void copy_(Field const& field, std::size_t iComponent)
+    {
+        auto const shape = field.shape();
+        double* data     = data_.data() + iComponent;
+
+        if constexpr (dim == 1)
+        {
+            for (auto i = 0u; i < shape[0]; ++i)
+            {
+                data[i * strides_[0]] = field(i);
+            }
+        }
+        else if constexpr (dim == 2)
+        {
+            for (auto i = 0u; i < shape[0]; ++i)
+            {
+                for (auto j = 0u; j < shape[1]; ++j)
+                {
+                    data[i * strides_[0] + j * strides_[1]] = field(i, j);
+                }
+            }
+        }
+        else
+        {
+            for (auto i = 0u; i < shape[0]; ++i)
+            {
+                for (auto j = 0u; j < shape[1]; ++j)
+                {
+                    for (auto k = 0u; k < shape[2]; ++k)
+                    {
+                        data[i * strides_[0] + j * strides_[1] + k * strides_[2]] = field(i, j, k);
+                    }
+                }
+            }
+        }
+    }
+
+
+    std::array<std::uint32_t, dim> shape_{};
+    std::array<std::size_t, dim> strides_{};
+    AlignedVector<double> data_;
+};
+
+
+} // namespace PHARE
+
+#endif
@@ -421,6 +421,25 @@ public:
 
 
 
+    /**
+     * @brief nextIndexShift returns nextIndex(centering, index) - index. It is known at
+     * compile time, so that derivative stencils can use constant offsets.
+     */
+    constexpr static int nextIndexShift(QtyCentering centering)
+    {
+        return nextIndexTable_[centering2int(centering)];
+    }
+
+
+
+    //! @brief prevIndexShift returns prevIndex(centering, index) - index
+    constexpr static int prevIndexShift(QtyCentering centering)
+    {
+        return prevIndexTable_[centering2int(centering)];
+    }
+
+
+
     /** @brief returns the local 1st order derivative of the Field operand
      * at a multidimensional index and in a given direction.
      * The function can perform 1D, 2D and 3D 1st order derivatives, depending
@@ -25,7 +25,10 @@ namespace PHARE
  *
  *  - its ParticleInitializer.
  *  - the mass of its particles
+ *  - the charge of its particles
  *  - its name
+ *  - its subcycling factor, i.e. every how many steps it is pushed. The factors can be
+ *    left empty, all populations are then pushed at each step.
  *
  */
 template<typename ParticleArray, typename GridLayout>
@@ -35,7 +38,9 @@ struct IonsInitializer
     std::vector<std::unique_ptr<ParticleInitializer<ParticleArray, GridLayout>>>
         particleInitializers;
     std::vector<double> masses;
+    std::vector<double> charges;
     std::vector<std::string> names;
+    std::vector<uint32> subcycling;
     uint32 nbrPopulations;
 };
 } // namespace PHARE
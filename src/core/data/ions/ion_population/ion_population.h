@@ -1,27 +1,47 @@
 #ifndef PHARE_ION_POPULATION_H
 #define PHARE_ION_POPULATION_H
 
+#include <algorithm>
+#include <array>
+#include <functional>
 #include <stdexcept>
 #include <string>
 #include <tuple>
 #include <vector>
 
 
+#include "data/vecfield/vecfield_component.h"
 #include "hybrid/hybrid_quantities.h"
 #include "particle_pack.h"
+#include "utilities/types.h"
 
 
 namespace PHARE
 {
+/** @brief IonPopulation gathers the particles of one ion species and their moments.
+ *
+ * A population can be subcycled: with a subcycling factor k > 1, it is only pushed at
+ * the steps that are multiples of k (see isPushedAt()), with a time step k times larger
+ * (see pushTimeStep()). This is meant for heavy minor species, whose particles move
+ * slowly compared to the light ones. Between two pushes, the moments of the population
+ * are linearly interpolated in time between the moments before the push, saved by
+ * saveMoments(), and those after the push (see addDensityAt() and addFluxAt()).
+ */
 template<typename ParticleArray, typename VecField>
 class IonPopulation
 {
 public:
-    IonPopulation(std::string name, double mass)
+    IonPopulation(std::string name, double mass, double charge, uint32 subcycling = 1)
         : name_{std::move(name)}
         , mass_{mass}
+        , charge_{charge}
+        , subcycling_{subcycling}
         , flux_{name_ + "_flux", HybridQuantity::Vector::V}
     {
+        if (subcycling_ == 0)
+        {
+            throw std::runtime_error("Error - subcycling factor must be at least 1");
+        }
     }
 
     using field_type                       = typename VecField::field_type;
@@ -32,17 +52,55 @@ public:
 
     double mass() const { return mass_; }
 
+    //! all particles of a population have the same charge, it is not stored in the particles
+    double charge() const { return charge_; }
+
     std::string const& name() const { return name_; }
 
 
+    //! the population is pushed every subcycling() steps
+    uint32 subcycling() const { return subcycling_; }
+
+    bool isSubcycled() const { return subcycling_ > 1; }
+
+    //! steps are counted from 0 on each level, the population is pushed at step 0
+    bool isPushedAt(uint32 step) const { return step % subcycling_ == 0; }
+
+    //! time step to push the population with when the level is advanced with dt
+    double pushTimeStep(double dt) const { return subcycling_ * dt; }
+
+
+    /** @brief weight of the moments computed after the last push in the moments of the
+     * population at the end of the given step, the moments saved before the push
+     * having a weight 1 - momentsWeight(step).
+     */
+    double momentsWeight(uint32 step) const
+    {
+        return static_cast<double>(step % subcycling_ + 1) / subcycling_;
+    }
+
 
 
-    bool isUsable() const { return particles_ != nullptr && rho_ != nullptr && flux_.isUsable(); }
+
+    bool isUsable() const
+    {
+        bool usable = particles_ != nullptr && rho_ != nullptr && flux_.isUsable();
+        if (isSubcycled())
+        {
+            usable = usable && previousRho_ != nullptr
+                     && std::all_of(std::begin(previousFlux_), std::end(previousFlux_),
+                                    [](auto const* component) { return component != nullptr; });
+        }
+        return usable;
+    }
 
 
     bool isSettable() const
     {
-        return particles_ == nullptr && rho_ == nullptr && flux_.isSettable();
+        return particles_ == nullptr && rho_ == nullptr && flux_.isSettable()
+               && previousRho_ == nullptr
+               && std::all_of(std::begin(previousFlux_), std::end(previousFlux_),
+                              [](auto const* component) { return component == nullptr; });
     }
 
 
@@ -119,6 +177,64 @@ public:
 
 
 
+    VecField const& flux() const
+    {
+        if (isUsable())
+        {
+            return flux_;
+        }
+        else
+        {
+            throw std::runtime_error("Error - cannot provide access to flux field");
+        }
+    }
+
+
+    VecField& flux()
+    {
+        return const_cast<VecField&>(static_cast<const IonPopulation*>(this)->flux());
+    }
+
+
+
+    /** @brief saves the current moments of a subcycled population, to be called before
+     * pushing it. Does nothing for a population that is not subcycled.
+     */
+    void saveMoments()
+    {
+        if (isSubcycled())
+        {
+            previousRho_->copyData(density());
+            for (auto component : {Component::X, Component::Y, Component::Z})
+            {
+                previousFlux_[componentIndex_(component)]->copyData(flux_.getComponent(component));
+            }
+        }
+    }
+
+
+
+    //! adds the density of the population at the end of the given step to 'rho'
+    void addDensityAt(uint32 step, field_type& rho) const
+    {
+        addMomentAt_(step, previousRho_, density(), rho);
+    }
+
+
+
+    //! adds the flux of the population at the end of the given step to 'flux'
+    template<typename VecFieldSum>
+    void addFluxAt(uint32 step, VecFieldSum& flux) const
+    {
+        for (auto component : {Component::X, Component::Y, Component::Z})
+        {
+            addMomentAt_(step, previousFlux_[componentIndex_(component)],
+                         flux_.getComponent(component), flux.getComponent(component));
+        }
+    }
+
+
+
     //-------------------------------------------------------------------------
     //                  start the ResourcesUser interface
     //-------------------------------------------------------------------------
@@ -135,9 +251,18 @@ public:
 
 
 
+    //! subcycled populations also need buffers for the moments saved before their push
     MomentProperties getFieldNamesAndQuantities() const
     {
-        return {{{name_ + "_rho", HybridQuantity::Scalar::rho}}};
+        MomentProperties properties{{{name_ + "_rho", HybridQuantity::Scalar::rho}}};
+        if (isSubcycled())
+        {
+            properties.push_back({previousRhoName_(), HybridQuantity::Scalar::rho});
+            properties.push_back({previousFluxName_(0), HybridQuantity::Scalar::Vx});
+            properties.push_back({previousFluxName_(1), HybridQuantity::Scalar::Vy});
+            properties.push_back({previousFluxName_(2), HybridQuantity::Scalar::Vz});
+        }
+        return properties;
     }
 
 
@@ -173,8 +298,20 @@ public:
         {
             rho_ = field;
         }
+        else if (isSubcycled() && bufferName == previousRhoName_())
+        {
+            previousRho_ = field;
+        }
         else
         {
+            for (auto iComp = 0u; iComp < previousFlux_.size(); ++iComp)
+            {
+                if (isSubcycled() && bufferName == previousFluxName_(iComp))
+                {
+                    previousFlux_[iComp] = field;
+                    return;
+                }
+            }
             throw std::runtime_error("Error - invalid density buffer name");
         }
     }
@@ -191,10 +328,50 @@ public:
 
 
 private:
+    std::string previousRhoName_() const { return name_ + "_rhoPrevious"; }
+
+    std::string previousFluxName_(std::size_t iComp) const
+    {
+        return name_ + "_fluxPrevious_" + "xyz"[iComp];
+    }
+
+    static std::size_t componentIndex_(Component component)
+    {
+        return static_cast<std::size_t>(component);
+    }
+
+
+    //! sum += (1 - w) * previous + w * current, w being the weight of the current moment
+    void addMomentAt_(uint32 step, field_type const* previous, field_type const& current,
+                      field_type& sum) const
+    {
+        auto const weight = momentsWeight(step);
+
+        if (weight == 1.)
+        {
+            std::transform(std::begin(sum), std::end(sum), std::begin(current), std::begin(sum),
+                           std::plus<typename field_type::type>{});
+        }
+        else
+        {
+            auto previousValue = std::begin(*previous);
+            auto currentValue  = std::begin(current);
+            for (auto& value : sum)
+            {
+                value += (1. - weight) * *previousValue++ + weight * *currentValue++;
+            }
+        }
+    }
+
+
     std::string name_;
     double mass_;
+    double charge_;
+    uint32 subcycling_;
     VecField flux_;
     field_type* rho_{nullptr};
+    field_type* previousRho_{nullptr};
+    std::array<field_type*, 3> previousFlux_{{nullptr, nullptr, nullptr}};
     ParticlesPack<ParticleArray>* particles_{nullptr};
 };
 
@@ -6,6 +6,7 @@
 #include <iterator>
 
 #include "data/ions/ion_population/ion_population.h"
+#include "data/vecfield/vecfield_component.h"
 #include "hybrid/hybrid_quantities.h"
 #include "ion_initializer.h"
 
@@ -22,6 +23,7 @@ public:
         IonsInitializer<typename IonPopulation::particle_array_type, GridLayout> initializer)
         : name_{std::move(initializer.name)}
         , bulkVelocity_{name_ + "_bulkVel", HybridQuantity::Vector::V}
+        , flux_{name_ + "_flux", HybridQuantity::Vector::V}
         , populations_{}
     {
         // TODO IonPopulation constructor will need to take a ParticleInitializer
@@ -29,8 +31,12 @@ public:
         populations_.reserve(initializer.nbrPopulations);
         for (uint32 ipop = 0; ipop < initializer.nbrPopulations; ++ipop)
         {
-            populations_.push_back(
-                IonPopulation{name_ + "_" + initializer.names[ipop], initializer.masses[ipop]});
+            auto subcycling
+                = initializer.subcycling.empty() ? uint32{1} : initializer.subcycling[ipop];
+
+            populations_.push_back(IonPopulation{name_ + "_" + initializer.names[ipop],
+                                                 initializer.masses[ipop],
+                                                 initializer.charges[ipop], subcycling});
         }
     }
 
@@ -82,6 +88,11 @@ public:
 
     vecfield_type& velocity() { return bulkVelocity_; }
 
+    //! total flux of the populations, from which the bulk velocity is computed
+    vecfield_type const& flux() const { return flux_; }
+
+    vecfield_type& flux() { return flux_; }
+
     std::string densityName() const { return name_ + "_rho"; }
 
 
@@ -96,8 +107,28 @@ public:
             // have to account for the field dimensionality.
 
             auto const& popDensity = pop.density();
-            std::transform(std::begin(rho_), std::end(rho_), std::begin(rho_),
-                           std::plus<typename field_type::type>{});
+            std::transform(std::begin(*rho_), std::end(*rho_), std::begin(popDensity),
+                           std::begin(*rho_), std::plus<typename field_type::type>{});
+        }
+    }
+
+
+
+    /** @brief computes the bulk velocity as the total flux divided by the density, on all
+     * nodes including ghost ones, which must have been filled. The bulk velocity is null
+     * where there is no ion.
+     */
+    void computeBulkVelocity()
+    {
+        for (auto component : {Component::X, Component::Y, Component::Z})
+        {
+            auto const& flux = flux_.getComponent(component);
+            auto& velocity   = bulkVelocity_.getComponent(component);
+
+            std::transform(std::begin(flux), std::end(flux), std::begin(*rho_),
+                           std::begin(velocity), [](auto fluxValue, auto density) {
+                               return density > 0. ? fluxValue / density : 0.;
+                           });
         }
     }
 
@@ -112,7 +143,7 @@ public:
 
     bool isUsable() const
     {
-        bool usable = rho_ != nullptr && bulkVelocity_.isUsable();
+        bool usable = rho_ != nullptr && bulkVelocity_.isUsable() && flux_.isUsable();
         for (auto const& pop : populations_)
         {
             usable = usable && pop.isUsable();
@@ -124,7 +155,7 @@ public:
 
     bool isSettable() const
     {
-        bool settable = rho_ == nullptr && bulkVelocity_.isSettable();
+        bool settable = rho_ == nullptr && bulkVelocity_.isSettable() && flux_.isSettable();
         for (auto const& pop : populations_)
         {
             settable = settable && pop.isSettable();
@@ -168,7 +199,7 @@ public:
 
     std::vector<IonPopulation>& getRunTimeResourcesUserList() { return populations_; }
 
-    auto getCompileTimeResourcesUserList() { return std::forward_as_tuple(bulkVelocity_); }
+    auto getCompileTimeResourcesUserList() { return std::forward_as_tuple(bulkVelocity_, flux_); }
 
 
 
@@ -180,6 +211,7 @@ private:
     std::string name_;
     field_type* rho_{nullptr};
     vecfield_type bulkVelocity_;
+    vecfield_type flux_;
     std::vector<IonPopulation> populations_; // TODO we have to name this so they are unique
                                              // although only 1 Ions should exist.
 };
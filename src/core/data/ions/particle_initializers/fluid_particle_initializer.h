@@ -1,6 +1,7 @@
 #ifndef PHARE_FLUID_PARTICLE_INITIALIZER_H
 #define PHARE_FLUID_PARTICLE_INITIALIZER_H
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <random>
@@ -40,13 +41,11 @@ public:
     FluidParticleInitializer(std::unique_ptr<ScalarFunction<dimension>> density,
                              std::unique_ptr<VectorFunction<dimension>> bulkVelocity,
                              std::unique_ptr<VectorFunction<dimension>> thermalVelocity,
-                             double particleCharge, uint32 nbrParticlesPerCell,
-                             Basis basis = Basis::Cartesian,
+                             uint32 nbrParticlesPerCell, Basis basis = Basis::Cartesian,
                              std::unique_ptr<VectorFunction<dimension>> magneticField = nullptr)
         : density_{std::move(density)}
         , bulkVelocity_{std::move(bulkVelocity)}
         , thermalVelocity_{std::move(thermalVelocity)}
-        , particleCharge_{particleCharge}
         , nbrParticlePerCell_{nbrParticlesPerCell}
         , basis_{basis}
         , magneticField_{std::move(magneticField)}
@@ -150,10 +149,11 @@ private:
 
                 Particle<dimension> tmpParticle;
                 tmpParticle.weight = cellWeight;
-                tmpParticle.charge = particleCharge_;
                 tmpParticle.iCell  = {{static_cast<int32>(ix)}};
                 tmpParticle.delta  = delta;
-                tmpParticle.v      = particleVelocity;
+                // the velocity is converted to the precision of the particles
+                std::copy(std::begin(particleVelocity), std::end(particleVelocity),
+                          std::begin(tmpParticle.v));
 
                 particles.push_back(std::move(tmpParticle));
             }
@@ -241,10 +241,10 @@ private:
 
                     Particle<dimension> tmpParticle;
                     tmpParticle.weight = cellWeight;
-                    tmpParticle.charge = particleCharge_;
                     tmpParticle.iCell  = {{static_cast<int32>(ix), static_cast<int32>(iy)}};
                     tmpParticle.delta  = delta;
-                    tmpParticle.v      = particleVelocity;
+                    std::copy(std::begin(particleVelocity), std::end(particleVelocity),
+                              std::begin(tmpParticle.v));
 
                     particles.push_back(std::move(tmpParticle));
                 }
@@ -339,11 +339,11 @@ private:
 
                         Particle<dimension> tmpParticle;
                         tmpParticle.weight = cellWeight;
-                        tmpParticle.charge = particleCharge_;
                         tmpParticle.iCell  = {{static_cast<int32>(ix), static_cast<int32>(iy),
                                               static_cast<int32>(iz)}};
                         tmpParticle.delta  = delta;
-                        tmpParticle.v      = particleVelocity;
+                        std::copy(std::begin(particleVelocity), std::end(particleVelocity),
+                                  std::begin(tmpParticle.v));
 
                         particles.push_back(std::move(tmpParticle));
                     } // end particle looop
@@ -359,7 +359,6 @@ private:
     std::unique_ptr<VectorFunction<dimension>> bulkVelocity_;
     std::unique_ptr<VectorFunction<dimension>> thermalVelocity_;
 
-    double particleCharge_;
     uint32 nbrParticlePerCell_;
     Basis basis_;
     std::unique_ptr<VectorFunction<dimension>> magneticField_;
@@ -117,6 +117,9 @@ public:
     DataType& operator()(uint32_t i) { return this->data_[i]; }
     DataType const& operator()(uint32_t i) const { return this->data_[i]; }
 
+    //! number of elements in each direction
+    std::array<uint32_t, 1> shape() const { return {{nx_}}; }
+
     static const int dimension = 1;
     using type                 = DataType;
 
@@ -187,6 +190,9 @@ public:
     //! read only access. See read/write.
     DataType const& operator()(uint32_t i, uint32_t j) const { return this->data_[linearIt(i, j)]; }
 
+    //! number of elements in each direction
+    std::array<uint32_t, 2> shape() const { return {{nx_, ny_}}; }
+
     static const int dimension = 2;
     using type                 = DataType;
 
@@ -265,6 +271,9 @@ public:
         return this->data_[linearIt(i, j, k)];
     }
 
+    //! number of elements in each direction
+    std::array<uint32_t, 3> shape() const { return {{nx_, ny_, nz_}}; }
+
     static const int dimension = 3;
     using type                 = DataType;
 
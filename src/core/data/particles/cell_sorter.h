@@ -0,0 +1,232 @@
+#ifndef PHARE_CORE_DATA_PARTICLES_CELL_SORTER_H
+#define PHARE_CORE_DATA_PARTICLES_CELL_SORTER_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "utilities/box/box.h"
+#include "utilities/memory/aligned_allocator.h"
+
+namespace PHARE
+{
+/** @brief CellSorter sorts the particles of a ParticleArray by cell and keeps
+ * the offset of each cell in the sorted array.
+ *
+ * The sorter is built for a box of cells, in the same local index space as the iCell of the
+ * particles. As for isIn(), the box contains the cells from box.lower to box.upper excluded.
+ * Cells are ordered as the elements of an NdArrayVector, the last direction being the fastest.
+ *
+ * sort() is a stable counting sort. After it, the particles of the cell 'iCell' are at
+ * indexes [cellBegin(iCell), cellEnd(iCell)[ and particles outside the box are at the
+ * end of the array, from outsideBegin(). Consecutive particles in the array then use the
+ * same few field nodes in the Interpolator and in deposition kernels.
+ *
+ * Sorting is O(nbrParticles + nbrCells) and the sorter keeps its work arrays, so that
+ * re-sorting particles after each push does not allocate memory after the first sort.
+ */
+template<typename ParticleArray>
+class CellSorter
+{
+public:
+    static constexpr std::size_t dimension = ParticleArray::dimension;
+
+
+    explicit CellSorter(Box<int, dimension> cellBox)
+        : cellBox_{cellBox}
+    {
+        nbrCells_ = 1;
+        for (auto iDim = static_cast<int>(dimension) - 1; iDim >= 0; --iDim)
+        {
+            auto nbrCellsInDir = std::max(0, cellBox_.upper[iDim] - cellBox_.lower[iDim]);
+
+            strides_[iDim] = nbrCells_;
+            nbrCells_ *= static_cast<std::size_t>(nbrCellsInDir);
+        }
+
+        // one more bin, after all cells, for particles outside the box
+        offsets_.assign(nbrCells_ + 2, 0);
+    }
+
+
+
+    /** @brief sorts particles by cell and updates the cell offsets
+     */
+    void sort(ParticleArray& particles)
+    {
+        auto const nbrParticles = particles.size();
+        auto const& iCells      = particles.iCells();
+
+        // count particles per bin. offsets_[bin + 1] is used as the counter
+        // so that the prefix sum below directly gives the first index of each bin
+        std::fill(std::begin(offsets_), std::end(offsets_), 0);
+        binOf_.resize(nbrParticles);
+
+        for (auto iPart = 0u; iPart < nbrParticles; ++iPart)
+        {
+            binOf_[iPart] = bin_(iCells[iPart]);
+            ++offsets_[binOf_[iPart] + 1];
+        }
+
+        for (auto iBin = 1u; iBin < offsets_.size(); ++iBin)
+        {
+            offsets_[iBin] += offsets_[iBin - 1];
+        }
+
+
+        // each particle goes at the next free index of its bin
+        // which keeps the order of particles within a cell
+        nextFree_.assign(std::begin(offsets_), std::end(offsets_) - 1);
+        destination_.resize(nbrParticles);
+
+        for (auto iPart = 0u; iPart < nbrParticles; ++iPart)
+        {
+            destination_[iPart] = nextFree_[binOf_[iPart]]++;
+        }
+
+        particles.permute(destination_, buffer_);
+    }
+
+
+
+
+    std::size_t cellBegin(std::array<int, dimension> const& iCell) const
+    {
+        return offsets_[bin_(iCell)];
+    }
+
+    std::size_t cellEnd(std::array<int, dimension> const& iCell) const
+    {
+        return offsets_[bin_(iCell) + 1];
+    }
+
+    std::size_t nbrParticlesInCell(std::array<int, dimension> const& iCell) const
+    {
+        return cellEnd(iCell) - cellBegin(iCell);
+    }
+
+    //! index of the first particle outside the box of the sorter
+    std::size_t outsideBegin() const { return offsets_[nbrCells_]; }
+
+
+
+
+    /** @brief calls function(first, last) for each contiguous range [first, last[ of
+     * particle indexes whose cells are in the given box.
+     *
+     * Cells of the box that are contiguous in the last direction are contiguous in the
+     * sorted array, so the function is called once per row of the box, and the cost
+     * of the query does not depend on the number of particles.
+     */
+    template<typename Function>
+    void forEachRangeIn(Box<int, dimension> const& box, Function&& function) const
+    {
+        Box<int, dimension> intersection;
+        for (auto iDim = 0u; iDim < dimension; ++iDim)
+        {
+            intersection.lower[iDim] = std::max(box.lower[iDim], cellBox_.lower[iDim]);
+            intersection.upper[iDim] = std::min(box.upper[iDim], cellBox_.upper[iDim]);
+
+            if (intersection.lower[iDim] >= intersection.upper[iDim])
+            {
+                return;
+            }
+        }
+
+        auto const last = dimension - 1;
+
+        auto row = std::array<int, dimension>{};
+        for (auto iDim = 0u; iDim < dimension; ++iDim)
+        {
+            row[iDim] = intersection.lower[iDim];
+        }
+
+        while (true)
+        {
+            auto lastCell  = row;
+            lastCell[last] = intersection.upper[last] - 1;
+
+            auto first = cellBegin(row);
+            auto end   = cellEnd(lastCell);
+            if (first != end)
+            {
+                function(first, end);
+            }
+
+            // next row, the last direction is the fastest
+            if constexpr (dimension == 1)
+            {
+                return;
+            }
+            else
+            {
+                int iDim = static_cast<int>(last) - 1;
+                for (; iDim >= 0; --iDim)
+                {
+                    if (++row[iDim] < intersection.upper[iDim])
+                    {
+                        break;
+                    }
+                    row[iDim] = intersection.lower[iDim];
+                }
+                if (iDim < 0)
+                {
+                    return;
+                }
+            }
+        }
+    }
+
+
+
+
+    std::size_t nbrParticlesIn(Box<int, dimension> const& box) const
+    {
+        std::size_t nbrParticles = 0;
+        forEachRangeIn(box, [&nbrParticles](std::size_t first, std::size_t last) {
+            nbrParticles += last - first;
+        });
+        return nbrParticles;
+    }
+
+
+    //! offsets()[i] is the index of the first particle of the i-th cell of the box,
+    //! offsets()[nbrCells] that of the first particle outside of the box
+    auto const& offsets() const { return offsets_; }
+
+    Box<int, dimension> const& cellBox() const { return cellBox_; }
+
+
+
+private:
+    std::size_t bin_(std::array<int, dimension> const& iCell) const
+    {
+        std::size_t bin = 0;
+        for (auto iDim = 0u; iDim < dimension; ++iDim)
+        {
+            if (iCell[iDim] < cellBox_.lower[iDim] || iCell[iDim] >= cellBox_.upper[iDim])
+            {
+                return nbrCells_;
+            }
+            bin += static_cast<std::size_t>(iCell[iDim] - cellBox_.lower[iDim]) * strides_[iDim];
+        }
+        return bin;
+    }
+
+
+    Box<int, dimension> cellBox_;
+    std::array<std::size_t, dimension> strides_;
+    std::size_t nbrCells_;
+
+    std::vector<std::size_t> offsets_;
+    std::vector<std::size_t> nextFree_;
+    AlignedVector<std::size_t> binOf_;
+    AlignedVector<std::size_t> destination_;
+    ParticleArray buffer_;
+};
+
+
+} // namespace PHARE
+
+#endif
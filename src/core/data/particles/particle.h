@@ -11,64 +11,52 @@
 
 namespace PHARE
 {
-template<std::size_t dim>
-struct Particle
+/** @brief precision policies of the particle attributes.
+ *
+ * The position in the cell (delta) is always stored in single precision. The weight and
+ * the velocity are stored in double precision by default. With MixedPrecision they are
+ * stored in single precision, which halves the memory and the message volume of the
+ * velocities. Field values and moments (density, flux) are accumulated in double precision
+ * whatever the precision of the particles.
+ *
+ * The precision of Particle<dim> is chosen at configure time with the
+ * 'mixedPrecisionParticles' CMake option, which defines PHARE_MIXED_PRECISION_PARTICLES.
+ */
+struct DoublePrecision
 {
+    using weight_type   = double;
+    using velocity_type = double;
 };
 
-
-
-template<>
-struct Particle<1>
+struct MixedPrecision
 {
-    double weight;
-    double charge;
-
-    std::array<int, 1> iCell   = {{0}};
-    std::array<float, 1> delta = {{0.0f}};
-    std::array<double, 3> v    = {{0., 0., 0.}};
-
-    double Ex = 0, Ey = 0, Ez = 0;
-    double Bx = 0, By = 0, Bz = 0;
-
-    static const std::size_t dimension = 1;
+    using weight_type   = float;
+    using velocity_type = float;
 };
 
+#ifdef PHARE_MIXED_PRECISION_PARTICLES
+using DefaultParticlePrecision = MixedPrecision;
+#else
+using DefaultParticlePrecision = DoublePrecision;
+#endif
 
 
 
-template<>
-struct Particle<2>
-{
-    double weight;
-    double charge;
-
-    std::array<int, 2> iCell   = {{0, 0}};
-    std::array<float, 2> delta = {{0.0f, 0.0f}};
-    std::array<double, 3> v    = {{0., 0., 0.}};
-
-    double Ex = 0, Ey = 0, Ez = 0;
-    double Bx = 0, By = 0, Bz = 0;
-
-    static const std::size_t dimension = 2;
-};
-
-
 
-template<>
-struct Particle<3>
+template<std::size_t dim, typename Precision = DefaultParticlePrecision>
+struct Particle
 {
-    double weight;
-    double charge;
+    using precision_type = Precision;
+    using weight_type    = typename Precision::weight_type;
+    using velocity_type  = typename Precision::velocity_type;
 
-    std::array<int, 3> iCell   = {{0, 0, 0}};
-    std::array<float, 3> delta = {{0.f, 0.f, 0.f}};
-    std::array<double, 3> v    = {{0., 0., 0.}};
+    weight_type weight;
 
-    double Ex = 0, Ey = 0, Ez = 0;
-    double Bx = 0, By = 0, Bz = 0;
+    std::array<int, dim> iCell     = {};
+    std::array<float, dim> delta   = {};
+    std::array<velocity_type, 3> v = {};
 
-    static const std::size_t dimension = 3;
+    static const std::size_t dimension = dim;
 };
 
 
@@ -2,16 +2,647 @@
 #define PHARE_CORE_DATA_PARTICLES_PARTICLE_ARRAY_H
 
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
-#include <vector>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 #include "particle.h"
+#include "utilities/memory/memory_pool.h"
 
 namespace PHARE
 {
-// TODO make a real particleArray class that has copy-deleted Ctor
-template<std::size_t dim>
-using ParticleArray = std::vector<Particle<dim>>;
+/** @brief ParticleProxy is the reference type of a ParticleArray.
+ *
+ * A ParticleArray does not store Particle objects but one array per particle attribute.
+ * A ParticleProxy gathers references to the attributes of one particle, so that code written
+ * for a Particle (part.iCell[0], part.v[2], etc.) works unchanged on a ParticleArray element.
+ *
+ * Assigning to a ParticleProxy writes through to the referenced particle. Copying a
+ * ParticleProxy does not copy the particle, the copy refers to the same particle.
+ * To get an independent copy, convert it to a Particle<dim>.
+ *
+ * A ParticleProxy can be assigned from particles of another precision, the weight
+ * and the velocity are then converted to the precision of the referenced particle.
+ */
+template<std::size_t dim, bool isConst, bool uniformWeight = false,
+         typename Precision = DefaultParticlePrecision>
+struct ParticleProxy
+{
+    template<typename T>
+    using ref_t = std::conditional_t<isConst, T const&, T&>;
+
+    using particle_type = Particle<dim, Precision>;
+    using weight_type   = typename particle_type::weight_type;
+    using velocity_type = typename particle_type::velocity_type;
+
+    //! particles of an array with uniform weight cannot change their weight individually
+    std::conditional_t<isConst || uniformWeight, weight_type const&, weight_type&> weight;
+
+    ref_t<std::array<int, dim>> iCell;
+    ref_t<std::array<float, dim>> delta;
+    ref_t<std::array<velocity_type, 3>> v;
+
+    static const std::size_t dimension = dim;
+
+
+
+    ParticleProxy& operator=(ParticleProxy const& other)
+    {
+        assign_(other);
+        return *this;
+    }
+
+    template<bool otherIsConst, bool otherUniformWeight, typename OtherPrecision>
+    ParticleProxy&
+    operator=(ParticleProxy<dim, otherIsConst, otherUniformWeight, OtherPrecision> const& other)
+    {
+        assign_(other);
+        return *this;
+    }
+
+    template<typename OtherPrecision>
+    ParticleProxy& operator=(Particle<dim, OtherPrecision> const& particle)
+    {
+        assign_(particle);
+        return *this;
+    }
+
+
+    operator particle_type() const
+    {
+        particle_type particle;
+        particle.weight = weight;
+        particle.iCell  = iCell;
+        particle.delta  = delta;
+        particle.v      = v;
+        return particle;
+    }
+
+
+    operator ParticleProxy<dim, true, uniformWeight, Precision>() const
+    {
+        return {weight, iCell, delta, v};
+    }
+
+
+    //! swaps the particles the two proxies refer to. Found by ADL from std::iter_swap
+    friend void swap(ParticleProxy lhs, ParticleProxy rhs)
+    {
+        particle_type tmp = lhs;
+        lhs               = rhs;
+        rhs               = tmp;
+    }
+
+
+    /** the weight is not assigned if the particle belongs to an array with uniform weight,
+     * it must then be the weight of the array
+     */
+    template<typename Other>
+    void assign_(Other const& other)
+    {
+        if constexpr (!uniformWeight)
+        {
+            weight = static_cast<weight_type>(other.weight);
+        }
+        else if (static_cast<weight_type>(other.weight) != weight)
+        {
+            throw std::runtime_error("Error - ParticleProxy - cannot give a particle another "
+                                     "weight than the uniform weight of its array");
+        }
+        iCell = other.iCell;
+        delta = other.delta;
+        for (auto iComp = 0u; iComp < 3; ++iComp)
+        {
+            v[iComp] = static_cast<velocity_type>(other.v[iComp]);
+        }
+    }
+};
+
+
+
+
+template<std::size_t dim, bool uniformWeight, typename Precision>
+class ParticleArray;
+
+
+
+/** @brief ParticleArrayIterator is a random access iterator on a ParticleArray.
+ *
+ * Dereferencing it gives a ParticleProxy, not a Particle&. It is a "proxy iterator",
+ * like std::vector<bool>::iterator, algorithms that swap or assign through iterators
+ * (std::partition, std::copy, std::iter_swap...) work with it.
+ */
+template<std::size_t dim, bool isConst, bool uniformWeight = false,
+         typename Precision = DefaultParticlePrecision>
+class ParticleArrayIterator
+{
+    using array_type    = ParticleArray<dim, uniformWeight, Precision>;
+    using array_pointer = std::conditional_t<isConst, array_type const*, array_type*>;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = Particle<dim, Precision>;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = ParticleProxy<dim, isConst, uniformWeight, Precision>;
+
+    //! operator-> needs to return something that has an operator-> itself
+    struct pointer
+    {
+        reference ref;
+        reference* operator->() { return &ref; }
+    };
+
+
+    ParticleArrayIterator() = default;
+
+    ParticleArrayIterator(array_pointer array, std::size_t index)
+        : array_{array}
+        , index_{index}
+    {
+    }
+
+    operator ParticleArrayIterator<dim, true, uniformWeight, Precision>() const
+    {
+        return {array_, index_};
+    }
+
+
+    reference operator*() const { return (*array_)[index_]; }
+
+    pointer operator->() const { return pointer{**this}; }
+
+    reference operator[](difference_type n) const { return (*array_)[index_ + n]; }
+
+
+    ParticleArrayIterator& operator++()
+    {
+        ++index_;
+        return *this;
+    }
+
+    ParticleArrayIterator operator++(int)
+    {
+        auto copy = *this;
+        ++index_;
+        return copy;
+    }
+
+    ParticleArrayIterator& operator--()
+    {
+        --index_;
+        return *this;
+    }
+
+    ParticleArrayIterator operator--(int)
+    {
+        auto copy = *this;
+        --index_;
+        return copy;
+    }
+
+    ParticleArrayIterator& operator+=(difference_type n)
+    {
+        index_ += n;
+        return *this;
+    }
+
+    ParticleArrayIterator& operator-=(difference_type n)
+    {
+        index_ -= n;
+        return *this;
+    }
+
+    friend ParticleArrayIterator operator+(ParticleArrayIterator it, difference_type n)
+    {
+        return it += n;
+    }
+
+    friend ParticleArrayIterator operator+(difference_type n, ParticleArrayIterator it)
+    {
+        return it += n;
+    }
+
+    friend ParticleArrayIterator operator-(ParticleArrayIterator it, difference_type n)
+    {
+        return it -= n;
+    }
+
+    friend difference_type operator-(ParticleArrayIterator const& lhs,
+                                     ParticleArrayIterator const& rhs)
+    {
+        return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+    }
+
+    friend bool operator==(ParticleArrayIterator const& lhs, ParticleArrayIterator const& rhs)
+    {
+        return lhs.index_ == rhs.index_ && lhs.array_ == rhs.array_;
+    }
+
+    friend bool operator!=(ParticleArrayIterator const& lhs, ParticleArrayIterator const& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(ParticleArrayIterator const& lhs, ParticleArrayIterator const& rhs)
+    {
+        return lhs.index_ < rhs.index_;
+    }
+
+    friend bool operator>(ParticleArrayIterator const& lhs, ParticleArrayIterator const& rhs)
+    {
+        return rhs < lhs;
+    }
+
+    friend bool operator<=(ParticleArrayIterator const& lhs, ParticleArrayIterator const& rhs)
+    {
+        return !(rhs < lhs);
+    }
+
+    friend bool operator>=(ParticleArrayIterator const& lhs, ParticleArrayIterator const& rhs)
+    {
+        return !(lhs < rhs);
+    }
+
+
+    //! position of the iterator in the ParticleArray
+    std::size_t index() const { return index_; }
+
+
+private:
+    array_pointer array_{nullptr};
+    std::size_t index_{0};
+};
+
+
+
+//! tells whether Iterator is a ParticleArrayIterator, whose particle attributes are contiguous
+template<typename Iterator>
+struct isParticleArrayIterator : std::false_type
+{
+};
+
+template<std::size_t dim, bool isConst, bool uniformWeight, typename Precision>
+struct isParticleArrayIterator<ParticleArrayIterator<dim, isConst, uniformWeight, Precision>>
+    : std::true_type
+{
+};
+
+
+
+
+/** @brief ParticleArray stores particles with a structure-of-arrays layout
+ *
+ * Each particle attribute (weight, iCell, delta, v) is stored in its own
+ * contiguous and aligned array. Kernels that only need some attributes of the particles
+ * (e.g. the velocity update of the pusher only needs v) then only stream these attributes
+ * through the cache, and can be vectorized over the particles.
+ *
+ * ParticleArray has the interface of a std::vector<Particle<dim>> for what PHARE uses.
+ * Elements are accessed through ParticleProxy objects (see ParticleProxy), and
+ * push_back/insert take Particle<dim> objects. The raw attribute arrays are accessible
+ * for kernels working directly on them.
+ *
+ * Attribute arrays take their memory from the MemoryPool of the thread, so that arrays
+ * that are created and destroyed at each step (e.g. communication and refinement buffers)
+ * reuse the same memory blocks.
+ *
+ * The charge is not a particle attribute, all particles of an IonPopulation have the
+ * same charge, which is stored in the IonPopulation.
+ *
+ * If uniformWeight is true, all particles of the array have the same weight (e.g. quiet
+ * start populations). The weight is then stored once and set with weights(). Pushing or
+ * assigning a particle of another weight into the array throws.
+ *
+ * Precision is the precision policy of the weights and velocities (see DoublePrecision
+ * and MixedPrecision). Particles of another precision can be pushed or assigned into
+ * the array, they are then converted.
+ */
+template<std::size_t dim, bool uniformWeight = false, typename Precision = DefaultParticlePrecision>
+class ParticleArray
+{
+public:
+    using value_type      = Particle<dim, Precision>;
+    using reference       = ParticleProxy<dim, false, uniformWeight, Precision>;
+    using const_reference = ParticleProxy<dim, true, uniformWeight, Precision>;
+    using iterator        = ParticleArrayIterator<dim, false, uniformWeight, Precision>;
+    using const_iterator  = ParticleArrayIterator<dim, true, uniformWeight, Precision>;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using weight_type     = typename value_type::weight_type;
+    using velocity_type   = typename value_type::velocity_type;
+
+    static constexpr std::size_t dimension = dim;
+    static constexpr bool hasUniformWeight = uniformWeight;
+
+
+    ParticleArray() = default;
+
+    explicit ParticleArray(std::size_t size) { resize(size); }
+
+
+    std::size_t size() const { return iCell_.size(); }
+
+    bool empty() const { return iCell_.empty(); }
+
+    std::size_t capacity() const { return iCell_.capacity(); }
+
+
+    void reserve(std::size_t newCapacity)
+    {
+        forEachAttribute_([newCapacity](auto& attribute) { attribute.reserve(newCapacity); });
+    }
+
+    void resize(std::size_t newSize)
+    {
+        forEachAttribute_([newSize](auto& attribute) { attribute.resize(newSize); });
+        updateHighWaterMark_();
+    }
+
+    void clear()
+    {
+        forEachAttribute_([](auto& attribute) { attribute.clear(); });
+    }
+
+
+    void push_back(value_type const& particle)
+    {
+        if constexpr (!uniformWeight)
+        {
+            weight_.push_back(particle.weight);
+        }
+        else
+        {
+            checkUniformWeight_(particle.weight);
+        }
+        iCell_.push_back(particle.iCell);
+        delta_.push_back(particle.delta);
+        v_.push_back(particle.v);
+        updateHighWaterMark_();
+    }
+
+    template<typename OtherPrecision>
+    void push_back(Particle<dim, OtherPrecision> const& particle)
+    {
+        if constexpr (uniformWeight)
+        {
+            checkUniformWeight_(static_cast<weight_type>(particle.weight));
+        }
+        resize(size() + 1);
+        (*this)[size() - 1] = particle;
+    }
+
+
+    reference operator[](std::size_t i) { return {weightOf_(i), iCell_[i], delta_[i], v_[i]}; }
+
+    const_reference operator[](std::size_t i) const
+    {
+        return {weightOf_(i), iCell_[i], delta_[i], v_[i]};
+    }
+
+
+    iterator begin() { return {this, 0}; }
+    iterator end() { return {this, size()}; }
+
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, size()}; }
+
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+
+
+    /** @brief removes the particles in [first, last[ and returns an iterator
+     * on the particle that followed the last removed one
+     */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        auto const iFirst = static_cast<difference_type>(first.index());
+        auto const iLast  = static_cast<difference_type>(last.index());
+
+        forEachAttribute_([iFirst, iLast](auto& attribute) {
+            attribute.erase(std::begin(attribute) + iFirst, std::begin(attribute) + iLast);
+        });
+
+        return {this, first.index()};
+    }
+
+    iterator erase(const_iterator position) { return erase(position, position + 1); }
+
+
+
+    /** @brief inserts the particles of [first, last[ before position
+     */
+    template<typename ParticleIterator>
+    iterator insert(const_iterator position, ParticleIterator first, ParticleIterator last)
+    {
+        auto const index = static_cast<difference_type>(position.index());
+        auto const count = static_cast<std::size_t>(std::distance(first, last));
+
+        forEachAttribute_([index, count](auto& attribute) {
+            using attribute_type = typename std::decay_t<decltype(attribute)>::value_type;
+            attribute.insert(std::begin(attribute) + index, count, attribute_type{});
+        });
+        updateHighWaterMark_();
+
+        for (auto inserted = begin() + index; first != last; ++first, ++inserted)
+        {
+            *inserted = *first;
+        }
+
+        return {this, position.index()};
+    }
+
+
+    /** @brief moves the particle at index i to index destination[i].
+     *
+     * destination must be a permutation of [0, size()[. The particles are copied into
+     * buffer, which then gets the previous storage of this array, so that a caller
+     * permuting particles repeatedly (e.g. sorting them) does not allocate memory each time.
+     */
+    template<typename IndexArray>
+    void permute(IndexArray const& destination, ParticleArray& buffer)
+    {
+        buffer.resize(size());
+        if constexpr (uniformWeight)
+        {
+            buffer.weight_ = weight_;
+        }
+
+        for (auto iPart = 0u; iPart < size(); ++iPart)
+        {
+            buffer[destination[iPart]] = (*this)[iPart];
+        }
+
+        swap(buffer);
+    }
+
+
+    void swap(ParticleArray& other)
+    {
+        std::swap(weight_, other.weight_);
+        iCell_.swap(other.iCell_);
+        delta_.swap(other.delta_);
+        v_.swap(other.v_);
+        std::swap(highWaterMark_, other.highWaterMark_);
+    }
+
+
+
+    //! largest number of particles the array has held since the last resetHighWaterMark()
+    std::size_t highWaterMark() const { return highWaterMark_; }
+
+    void resetHighWaterMark() { highWaterMark_ = size(); }
+
+
+    //! number of bytes of the memory blocks held by the attribute arrays, see memoryBytes(capacity)
+    std::size_t memoryBytes() const { return memoryBytes(capacity()); }
+
+    /** @brief number of bytes of the memory blocks the attribute arrays hold with the given
+     * capacity, which the MemoryPool rounds up to its block sizes
+     */
+    std::size_t memoryBytes(std::size_t capacity) const
+    {
+        std::size_t bytes = 0;
+        forEachAttribute_([&bytes, capacity](auto const& attribute) {
+            using attribute_type = typename std::decay_t<decltype(attribute)>::value_type;
+            bytes += MemoryPool::allocatedSize(capacity * sizeof(attribute_type));
+        });
+        return bytes;
+    }
+
+    //! number of bytes used by the particles of the array
+    std::size_t usedBytes() const
+    {
+        std::size_t bytes = 0;
+        forEachAttribute_([&bytes](auto const& attribute) {
+            using attribute_type = typename std::decay_t<decltype(attribute)>::value_type;
+            bytes += attribute.size() * sizeof(attribute_type);
+        });
+        return bytes;
+    }
+
+
+    /** @brief reallocates the attribute arrays with the given capacity, which cannot
+     * be smaller than size(). Unlike std::vector::shrink_to_fit, the capacity is guaranteed.
+     * The blocks of the previous arrays are given back to the system, not kept by the
+     * MemoryPool of the thread, whose other cached blocks are left untouched.
+     */
+    void shrinkTo(std::size_t newCapacity)
+    {
+        newCapacity = std::max(newCapacity, size());
+
+        forEachAttribute_([newCapacity](auto& attribute) {
+            using Attribute     = std::decay_t<decltype(attribute)>;
+            auto const oldBytes = attribute.capacity() * sizeof(typename Attribute::value_type);
+            void* oldBlock      = attribute.data();
+
+            Attribute shrunk;
+            shrunk.reserve(newCapacity);
+            shrunk.assign(std::begin(attribute), std::end(attribute));
+            attribute.swap(shrunk);
+            Attribute{}.swap(shrunk);
+
+            if (auto pool = MemoryPool::threadLocal())
+            {
+                pool->releaseBlock(oldBlock, oldBytes);
+            }
+        });
+    }
+
+
+
+    // direct access to the attribute arrays, for kernels working on
+    // contiguous attributes of all particles.
+    // weights() is the weight of all particles if uniformWeight is true
+
+    auto& weights() { return weight_; }
+    auto& iCells() { return iCell_; }
+    auto& deltas() { return delta_; }
+    auto& velocities() { return v_; }
+
+    auto const& weights() const { return weight_; }
+    auto const& iCells() const { return iCell_; }
+    auto const& deltas() const { return delta_; }
+    auto const& velocities() const { return v_; }
+
+
+
+private:
+    template<typename Function>
+    void forEachAttribute_(Function&& function)
+    {
+        if constexpr (!uniformWeight)
+        {
+            function(weight_);
+        }
+        function(iCell_);
+        function(delta_);
+        function(v_);
+    }
+
+    template<typename Function>
+    void forEachAttribute_(Function&& function) const
+    {
+        if constexpr (!uniformWeight)
+        {
+            function(weight_);
+        }
+        function(iCell_);
+        function(delta_);
+        function(v_);
+    }
+
+
+    void updateHighWaterMark_() { highWaterMark_ = std::max(highWaterMark_, size()); }
+
+
+    void checkUniformWeight_(weight_type weight) const
+    {
+        if (weight != weight_)
+        {
+            throw std::runtime_error("Error - ParticleArray - cannot push a particle of another "
+                                     "weight than the uniform weight of the array");
+        }
+    }
+
+
+    auto& weightOf_([[maybe_unused]] std::size_t i)
+    {
+        if constexpr (uniformWeight)
+        {
+            return weight_;
+        }
+        else
+        {
+            return weight_[i];
+        }
+    }
+
+    auto const& weightOf_([[maybe_unused]] std::size_t i) const
+    {
+        if constexpr (uniformWeight)
+        {
+            return weight_;
+        }
+        else
+        {
+            return weight_[i];
+        }
+    }
+
+
+    std::conditional_t<uniformWeight, weight_type, PooledVector<weight_type>> weight_{};
+    PooledVector<std::array<int, dim>> iCell_;
+    PooledVector<std::array<float, dim>> delta_;
+    PooledVector<std::array<velocity_type, 3>> v_;
+    std::size_t highWaterMark_{0};
+};
+
+
 } // namespace PHARE
 
 
@@ -0,0 +1,93 @@
+#ifndef PHARE_CORE_DATA_PARTICLES_PARTICLE_MEMORY_H
+#define PHARE_CORE_DATA_PARTICLES_PARTICLE_MEMORY_H
+
+#include <cstddef>
+
+
+namespace PHARE
+{
+/** @brief ParticleMemoryUsage reports the memory held by one or several particle arrays.
+ *
+ * Usages of several arrays (e.g. all arrays of a patch, or of all patches of a level)
+ * are aggregated with operator+=. The high water mark of an aggregate is then the sum of
+ * the high water marks of the arrays, i.e. an upper bound of the peak number of particles.
+ */
+struct ParticleMemoryUsage
+{
+    std::size_t size{0};
+    std::size_t capacity{0};
+    std::size_t highWaterMark{0};
+    std::size_t bytes{0};
+    std::size_t usedBytes{0};
+
+
+    //! bytes held but not used by particles, e.g. after a vector doubling
+    std::size_t slackBytes() const { return bytes - usedBytes; }
+
+
+    ParticleMemoryUsage& operator+=(ParticleMemoryUsage const& other)
+    {
+        size += other.size;
+        capacity += other.capacity;
+        highWaterMark += other.highWaterMark;
+        bytes += other.bytes;
+        usedBytes += other.usedBytes;
+        return *this;
+    }
+};
+
+
+
+template<typename ParticleArray>
+ParticleMemoryUsage memoryUsageOf(ParticleArray const& particles)
+{
+    return {particles.size(), particles.capacity(), particles.highWaterMark(),
+            particles.memoryBytes(), particles.usedBytes()};
+}
+
+
+
+
+/** @brief ParticleShrinkPolicy tells when the capacity of a particle array is given back.
+ *
+ * An array is shrunk when its capacity is larger than (1 + maxSlack) times its number of
+ * particles, when it holds at least minBytes and when its memory blocks would be smaller.
+ * It is then reallocated with (1 + headroom) times its number of particles, so that the
+ * next push does not immediately grow it again. Its high water mark is kept.
+ */
+struct ParticleShrinkPolicy
+{
+    double maxSlack{0.5};
+    double headroom{0.1};
+    std::size_t minBytes{std::size_t{1} << 20};
+};
+
+
+
+//! applies the policy to the array, returns true if the array has been shrunk
+template<typename ParticleArray>
+bool shrink(ParticleArray& particles, ParticleShrinkPolicy const& policy)
+{
+    auto const size     = static_cast<double>(particles.size());
+    auto const capacity = static_cast<double>(particles.capacity());
+
+    if (particles.memoryBytes() < policy.minBytes || capacity <= (1. + policy.maxSlack) * size)
+    {
+        return false;
+    }
+
+    // blocks are rounded up to a power of two, a smaller capacity may still need the same blocks
+    auto const newCapacity = static_cast<std::size_t>((1. + policy.headroom) * size);
+    if (particles.memoryBytes(newCapacity) >= particles.memoryBytes())
+    {
+        return false;
+    }
+
+    particles.shrinkTo(newCapacity);
+    return true;
+}
+
+
+} // namespace PHARE
+
+#endif
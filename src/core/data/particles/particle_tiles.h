@@ -0,0 +1,293 @@
+#ifndef PHARE_CORE_DATA_PARTICLES_PARTICLE_TILES_H
+#define PHARE_CORE_DATA_PARTICLES_PARTICLE_TILES_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "utilities/box/box.h"
+
+namespace PHARE
+{
+/** @brief ParticleTiles splits the particles of a patch into one ParticleArray per tile
+ * of cells, so that tiles can be pushed and deposited independently, e.g. one thread per tile.
+ *
+ * The box of cells is cut into tiles of tileShape cells (the last tiles of each direction
+ * may be smaller). Tiles are ordered as the elements of an NdArrayVector, the last direction
+ * being the fastest. Particles whose cell is not in the box are kept in the leaving() array.
+ *
+ * After particles of the tiles have been moved, migrate() puts each particle back in the
+ * tile of its new cell, so that tile(i) only contains particles of tileBox(i).
+ *
+ * Tiles also have a color: two tiles of the same color are never neighbors, so if the
+ * tile shape is at least as large as the number of nodes a particle deposits on in each
+ * direction, all tiles of one color can deposit on the same fields concurrently.
+ */
+template<typename ParticleArray>
+class ParticleTiles
+{
+public:
+    static constexpr std::size_t dimension = ParticleArray::dimension;
+    static constexpr std::size_t nbrColors = std::size_t{1} << dimension;
+
+    using particle_type = typename ParticleArray::value_type;
+
+
+    ParticleTiles(Box<int, dimension> cellBox, std::array<int, dimension> tileShape)
+        : cellBox_{cellBox}
+        , tileShape_{tileShape}
+    {
+        std::size_t nbrTiles = 1;
+        for (auto iDim = static_cast<int>(dimension) - 1; iDim >= 0; --iDim)
+        {
+            if (tileShape_[iDim] <= 0)
+            {
+                throw std::runtime_error("Error - tile shape must be strictly positive");
+            }
+
+            auto nbrCells = std::max(0, cellBox_.upper[iDim] - cellBox_.lower[iDim]);
+
+            auto nbrTilesInDir = (nbrCells + tileShape_[iDim] - 1) / tileShape_[iDim];
+
+            tileStrides_[iDim] = nbrTiles;
+            nbrTiles *= static_cast<std::size_t>(nbrTilesInDir);
+        }
+
+        tiles_.resize(nbrTiles);
+    }
+
+
+
+    std::size_t nbrTiles() const { return tiles_.size(); }
+
+    Box<int, dimension> const& cellBox() const { return cellBox_; }
+
+    std::array<int, dimension> const& tileShape() const { return tileShape_; }
+
+    ParticleArray& tile(std::size_t iTile) { return tiles_[iTile]; }
+
+    ParticleArray const& tile(std::size_t iTile) const { return tiles_[iTile]; }
+
+    //! particles whose cell is not in the box of the tiles
+    ParticleArray& leaving() { return leaving_; }
+
+    ParticleArray const& leaving() const { return leaving_; }
+
+
+
+
+    //! box of the cells of the tile, upper excluded as for the box of the tiles
+    Box<int, dimension> tileBox(std::size_t iTile) const
+    {
+        auto coords = tileCoords_(iTile);
+
+        Box<int, dimension> box;
+        for (auto iDim = 0u; iDim < dimension; ++iDim)
+        {
+            box.lower[iDim] = cellBox_.lower[iDim] + coords[iDim] * tileShape_[iDim];
+            box.upper[iDim] = std::min(box.lower[iDim] + tileShape_[iDim], cellBox_.upper[iDim]);
+        }
+        return box;
+    }
+
+
+
+    //! index of the tile containing the cell, nbrTiles() if the cell is not in the box
+    std::size_t tileOf(std::array<int, dimension> const& iCell) const
+    {
+        std::size_t iTile = 0;
+        for (auto iDim = 0u; iDim < dimension; ++iDim)
+        {
+            if (iCell[iDim] < cellBox_.lower[iDim] || iCell[iDim] >= cellBox_.upper[iDim])
+            {
+                return nbrTiles();
+            }
+            auto coord = (iCell[iDim] - cellBox_.lower[iDim]) / tileShape_[iDim];
+            iTile += static_cast<std::size_t>(coord) * tileStrides_[iDim];
+        }
+        return iTile;
+    }
+
+
+
+    std::size_t colorOf(std::size_t iTile) const
+    {
+        auto coords       = tileCoords_(iTile);
+        std::size_t color = 0;
+        for (auto iDim = 0u; iDim < dimension; ++iDim)
+        {
+            color |= static_cast<std::size_t>(coords[iDim] % 2) << iDim;
+        }
+        return color;
+    }
+
+
+
+
+    std::size_t size() const
+    {
+        std::size_t nbrParticles = leaving_.size();
+        for (auto const& tile : tiles_)
+        {
+            nbrParticles += tile.size();
+        }
+        return nbrParticles;
+    }
+
+
+    void clear()
+    {
+        for (auto& tile : tiles_)
+        {
+            tile.clear();
+        }
+        leaving_.clear();
+    }
+
+
+    void push_back(particle_type const& particle) { arrayOf_(particle.iCell).push_back(particle); }
+
+
+    template<typename ParticleIterator>
+    void insert(ParticleIterator first, ParticleIterator last)
+    {
+        for (; first != last; ++first)
+        {
+            particle_type particle = *first;
+            push_back(particle);
+        }
+    }
+
+
+    //! appends the particles of all tiles, then the leaving ones, to 'particles'
+    void gather(ParticleArray& particles) const
+    {
+        particles.reserve(particles.size() + size());
+        for (auto const& tile : tiles_)
+        {
+            particles.insert(std::end(particles), std::begin(tile), std::end(tile));
+        }
+        particles.insert(std::end(particles), std::begin(leaving_), std::end(leaving_));
+    }
+
+
+
+
+    /** @brief moves the particles that are not in the box of their tile anymore
+     * to the tile of their cell, or to leaving() if they left the box.
+     *
+     * Particles staying in their tile keep their order. Returns the number of
+     * particles that changed tile.
+     */
+    std::size_t migrate()
+    {
+        migrants_.clear();
+
+        for (auto iTile = 0u; iTile < tiles_.size(); ++iTile)
+        {
+            auto& tile     = tiles_[iTile];
+            auto const box = tileBox(iTile);
+
+            std::size_t nbrStaying = 0;
+            for (auto iPart = 0u; iPart < tile.size(); ++iPart)
+            {
+                if (isInTile_(tile.iCells()[iPart], box))
+                {
+                    if (nbrStaying != iPart)
+                    {
+                        tile[nbrStaying] = tile[iPart];
+                    }
+                    ++nbrStaying;
+                }
+                else
+                {
+                    migrants_.push_back(tile[iPart]);
+                }
+            }
+            tile.resize(nbrStaying);
+        }
+
+        insert(std::begin(migrants_), std::end(migrants_));
+
+        return migrants_.size();
+    }
+
+
+
+
+    //! calls function(tile, tileBox) for all tiles
+    template<typename Function>
+    void forEachTile(Function&& function)
+    {
+        for (auto iTile = 0u; iTile < tiles_.size(); ++iTile)
+        {
+            function(tiles_[iTile], tileBox(iTile));
+        }
+    }
+
+
+    /** @brief calls function(tile, tileBox) for the tiles of the given color. Calls on
+     * different tiles are independent and can be made concurrently.
+     */
+    template<typename Function>
+    void forEachTileOfColor(std::size_t color, Function&& function)
+    {
+        for (auto iTile = 0u; iTile < tiles_.size(); ++iTile)
+        {
+            if (colorOf(iTile) == color)
+            {
+                function(tiles_[iTile], tileBox(iTile));
+            }
+        }
+    }
+
+
+
+private:
+    std::array<int, dimension> tileCoords_(std::size_t iTile) const
+    {
+        std::array<int, dimension> coords;
+        for (auto iDim = 0u; iDim < dimension; ++iDim)
+        {
+            coords[iDim] = static_cast<int>(iTile / tileStrides_[iDim]);
+            iTile %= tileStrides_[iDim];
+        }
+        return coords;
+    }
+
+
+    static bool isInTile_(std::array<int, dimension> const& iCell, Box<int, dimension> const& box)
+    {
+        for (auto iDim = 0u; iDim < dimension; ++iDim)
+        {
+            if (iCell[iDim] < box.lower[iDim] || iCell[iDim] >= box.upper[iDim])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+
+    ParticleArray& arrayOf_(std::array<int, dimension> const& iCell)
+    {
+        auto iTile = tileOf(iCell);
+        return iTile < tiles_.size() ? tiles_[iTile] : leaving_;
+    }
+
+
+    Box<int, dimension> cellBox_;
+    std::array<int, dimension> tileShape_;
+    std::array<std::size_t, dimension> tileStrides_;
+
+    std::vector<ParticleArray> tiles_;
+    ParticleArray leaving_;
+    ParticleArray migrants_;
+};
+
+
+} // namespace PHARE
+
+#endif
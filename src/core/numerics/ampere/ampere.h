@@ -1,12 +1,20 @@
 #ifndef PHARE_CORE_NUMERICS_AMPERE_AMPERE_H
 #define PHARE_CORE_NUMERICS_AMPERE_AMPERE_H
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
-#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <utility>
 
 #include "data/grid/gridlayoutdefs.h"
 #include "data/vecfield/vecfield_component.h"
+#include "hybrid/hybrid_quantities.h"
+#include "numerics/stencil/for_each_in_box.h"
+#include "numerics/stencil/row_stencil.h"
 #include "utilities/index/index.h"
+#include "utilities/types.h"
 
 namespace PHARE
 {
@@ -43,6 +51,9 @@ public:
     bool hasLayoutSet() const { return (layout_ == nullptr) ? false : true; }
 
 
+    GridLayout const &layout() const { return *layout_; }
+
+
     /**
      * @brief setLayout is used to give Ampere a pointer to a gridlayout
      */
@@ -62,15 +73,23 @@ public:
 
 
 /** @brief 1D specialization of the ampere equation solver implementation
+ *
+ * Specializations compute the current density row by row, see RowDerivative, the
+ * centering of each component being known at compile time.
  */
 template<typename GridLayout>
 class AmpereImpl<GridLayout, 1> : public AmpereImplInternals<GridLayout>
 {
     static_assert(GridLayout::dimension == 1, "Error: Passed non-1D GridLayout to 1D AmpereImpl");
 
+    using Scalar = HybridQuantity::Scalar;
+
+    template<Scalar quantity, Direction direction>
+    using Deriv = RowDerivative<GridLayout, quantity, direction>;
+
 public:
-    template<typename VecField>
-    void operator()(VecField const &B, VecField &J)
+    template<typename VecField, typename RowsOf>
+    void operator()(VecField const &B, VecField &J, RowsOf &&rowsOf)
     {
         //auto &Jx = J.getComponent(Component::X); // =  0
         auto &Jy = J.getComponent(Component::Y); // = -dxBz
@@ -80,23 +99,27 @@ public:
         auto const &By = B.getComponent(Component::Y);
         auto const &Bz = B.getComponent(Component::Z);
 
-        // TODO Direction should not be in gridlayoutdef but in utilities somehow
-        // TODO 1st arg of physicalStartIndex( could be QtyCentering::primal ?
-        auto start = this->layout_->physicalStartIndex(Jy, Direction::X);
-        auto end   = this->layout_->physicalEndIndex(Jy, Direction::X);
+        auto const &layout = *this->layout_;
 
-        for (auto ix = start; ix <= end; ++ix)
-        {
-            Jy(ix) = -this->layout_->deriv(Bz, make_index(ix), DirectionTag<Direction::X>{});
-        }
+        rowsOf(QuantityTag<Scalar::Jy>{}, [&](auto const &first, uint32 size) {
+            Deriv<Scalar::Bz, Direction::X> dxBz{layout, Bz, first};
 
-        start = this->layout_->physicalStartIndex(Jz, Direction::X);
-        end   = this->layout_->physicalEndIndex(Jz, Direction::X);
+            auto *jy = &nodeAt(Jy, first);
+            for (uint32 i = 0; i < size; ++i)
+            {
+                jy[i] = -dxBz[i];
+            }
+        });
 
-        for (auto ix = start; ix <= end; ++ix)
-        {
-            Jz(ix) = this->layout_->deriv(By, make_index(ix), DirectionTag<Direction::X>{});
-        }
+        rowsOf(QuantityTag<Scalar::Jz>{}, [&](auto const &first, uint32 size) {
+            Deriv<Scalar::By, Direction::X> dxBy{layout, By, first};
+
+            auto *jz = &nodeAt(Jz, first);
+            for (uint32 i = 0; i < size; ++i)
+            {
+                jz[i] = dxBy[i];
+            }
+        });
     }
 };
 
@@ -107,9 +130,14 @@ class AmpereImpl<GridLayout, 2> : public AmpereImplInternals<GridLayout>
 {
     static_assert(GridLayout::dimension == 2, "Error: Passed non-2D GridLayout to 2D AmpereImpl");
 
+    using Scalar = HybridQuantity::Scalar;
+
+    template<Scalar quantity, Direction direction>
+    using Deriv = RowDerivative<GridLayout, quantity, direction>;
+
 public:
-    template<typename VecField>
-    void operator()(VecField const &B, VecField &J)
+    template<typename VecField, typename RowsOf>
+    void operator()(VecField const &B, VecField &J, RowsOf &&rowsOf)
     {
         auto &Jx = J.getComponent(Component::X); // =  dyBz
         auto &Jy = J.getComponent(Component::Y); // = -dxBz
@@ -119,45 +147,38 @@ public:
         auto const &By = B.getComponent(Component::Y);
         auto const &Bz = B.getComponent(Component::Z);
 
-        auto psi_X = this->layout_->physicalStartIndex(Jx, Direction::X);
-        auto pei_X = this->layout_->physicalEndIndex(Jx, Direction::X);
-        auto psi_Y = this->layout_->physicalStartIndex(Jx, Direction::Y);
-        auto pei_Y = this->layout_->physicalEndIndex(Jx, Direction::Y);
+        auto const &layout = *this->layout_;
 
-        for (auto ix = psi_X; ix <= pei_X; ++ix)
-        {
-            for (auto iy = psi_Y; iy <= pei_Y; ++iy)
+        rowsOf(QuantityTag<Scalar::Jx>{}, [&](auto const &first, uint32 size) {
+            Deriv<Scalar::Bz, Direction::Y> dyBz{layout, Bz, first};
+
+            auto *jx = &nodeAt(Jx, first);
+            for (uint32 i = 0; i < size; ++i)
             {
-                Jx(ix, iy) = this->layout_->deriv(Bz, make_index(ix, iy), DirectionTag<Direction::Y>{});
+                jx[i] = dyBz[i];
             }
-        }
+        });
 
-        psi_X = this->layout_->physicalStartIndex(Jy, Direction::X);
-        pei_X = this->layout_->physicalEndIndex(Jy, Direction::X);
-        psi_Y = this->layout_->physicalStartIndex(Jy, Direction::Y);
-        pei_Y = this->layout_->physicalEndIndex(Jy, Direction::Y);
+        rowsOf(QuantityTag<Scalar::Jy>{}, [&](auto const &first, uint32 size) {
+            Deriv<Scalar::Bz, Direction::X> dxBz{layout, Bz, first};
 
-        for (auto ix = psi_X; ix <= pei_X; ++ix)
-        {
-            for (auto iy = psi_Y; iy <= pei_Y; ++iy)
+            auto *jy = &nodeAt(Jy, first);
+            for (uint32 i = 0; i < size; ++i)
             {
-                Jy(ix, iy) = -this->layout_->deriv(Bz, make_index(ix, iy), DirectionTag<Direction::X>{});
+                jy[i] = -dxBz[i];
             }
-        }
+        });
 
-        psi_X = this->layout_->physicalStartIndex(Jz, Direction::X);
-        pei_X = this->layout_->physicalEndIndex(Jz, Direction::X);
-        psi_Y = this->layout_->physicalStartIndex(Jz, Direction::Y);
-        pei_Y = this->layout_->physicalEndIndex(Jz, Direction::Y);
+        rowsOf(QuantityTag<Scalar::Jz>{}, [&](auto const &first, uint32 size) {
+            Deriv<Scalar::By, Direction::X> dxBy{layout, By, first};
+            Deriv<Scalar::Bx, Direction::Y> dyBx{layout, Bx, first};
 
-        for (uint32 ix = psi_X; ix <= pei_X; ++ix)
-        {
-            for (uint32 iy = psi_Y; iy <= pei_Y; ++iy)
+            auto *jz = &nodeAt(Jz, first);
+            for (uint32 i = 0; i < size; ++i)
             {
-                Jz(ix, iy) = this->layout_->deriv(By, make_index(ix, iy), DirectionTag<Direction::X>{})
-                            -this->layout_->deriv(Bx, make_index(ix, iy), DirectionTag<Direction::Y>{});
+                jz[i] = dxBy[i] - dyBx[i];
             }
-        }
+        });
     }
 };
 
@@ -168,11 +189,16 @@ class AmpereImpl<GridLayout, 3> : public AmpereImplInternals<GridLayout>
 {
     static_assert(GridLayout::dimension == 3, "Error: Passed non-3D GridLayout to 3D AmpereImpl");
 
+    using Scalar = HybridQuantity::Scalar;
+
+    template<Scalar quantity, Direction direction>
+    using Deriv = RowDerivative<GridLayout, quantity, direction>;
+
 public:
-    template<typename VecField>
-    void operator()(VecField const &B, VecField &J)
+    template<typename VecField, typename RowsOf>
+    void operator()(VecField const &B, VecField &J, RowsOf &&rowsOf)
     {
-        auto &Jx = J.getComponent(Component::X); // =  dyBz - dzBx
+        auto &Jx = J.getComponent(Component::X); // =  dyBz - dzBy
         auto &Jy = J.getComponent(Component::Y); // =  dzBx - dxBz
         auto &Jz = J.getComponent(Component::Z); // =  dxBy - dyBx
 
@@ -180,90 +206,128 @@ public:
         auto const &By = B.getComponent(Component::Y);
         auto const &Bz = B.getComponent(Component::Z);
 
-        auto psi_X = this->layout_->physicalStartIndex(Jx, Direction::X);
-        auto pei_X = this->layout_->physicalEndIndex(Jx, Direction::X);
-        auto psi_Y = this->layout_->physicalStartIndex(Jx, Direction::Y);
-        auto pei_Y = this->layout_->physicalEndIndex(Jx, Direction::Y);
-        auto psi_Z = this->layout_->physicalStartIndex(Jx, Direction::Z);
-        auto pei_Z = this->layout_->physicalEndIndex(Jx, Direction::Z);
+        auto const &layout = *this->layout_;
 
-        for (auto ix = psi_X; ix <= pei_X; ++ix)
-        {
-            for (auto iy = psi_Y; iy <= pei_Y; ++iy)
+        rowsOf(QuantityTag<Scalar::Jx>{}, [&](auto const &first, uint32 size) {
+            Deriv<Scalar::Bz, Direction::Y> dyBz{layout, Bz, first};
+            Deriv<Scalar::By, Direction::Z> dzBy{layout, By, first};
+
+            auto *jx = &nodeAt(Jx, first);
+            for (uint32 i = 0; i < size; ++i)
             {
-                for (auto iz = psi_Z; iz <= pei_Z; ++iz)
-                {
-                    Jx(ix, iy, iz) = this->layout_->deriv(Bz, make_index(ix, iy, iz), DirectionTag<Direction::Y>{})
-                                    -this->layout_->deriv(By, make_index(ix, iy, iz), DirectionTag<Direction::Z>{});
-                }
+                jx[i] = dyBz[i] - dzBy[i];
             }
-        }
+        });
 
-        psi_X = this->layout_->physicalStartIndex(Jy, Direction::X);
-        pei_X = this->layout_->physicalEndIndex(Jy, Direction::X);
-        psi_Y = this->layout_->physicalStartIndex(Jy, Direction::Y);
-        pei_Y = this->layout_->physicalEndIndex(Jy, Direction::Y);
-        psi_Z = this->layout_->physicalStartIndex(Jy, Direction::Z);
-        pei_Z = this->layout_->physicalEndIndex(Jy, Direction::Z);
+        rowsOf(QuantityTag<Scalar::Jy>{}, [&](auto const &first, uint32 size) {
+            Deriv<Scalar::Bx, Direction::Z> dzBx{layout, Bx, first};
+            Deriv<Scalar::Bz, Direction::X> dxBz{layout, Bz, first};
 
-        for (auto ix = psi_X; ix <= pei_X; ++ix)
-        {
-            for (auto iy = psi_Y; iy <= pei_Y; ++iy)
+            auto *jy = &nodeAt(Jy, first);
+            for (uint32 i = 0; i < size; ++i)
             {
-                for (auto iz = psi_Z; iz <= pei_Z; ++iz)
-                {
-                    Jy(ix, iy, iz) = this->layout_->deriv(Bx, make_index(ix, iy, iz), DirectionTag<Direction::Z>{})
-                                    -this->layout_->deriv(Bz, make_index(ix, iy, iz), DirectionTag<Direction::X>{});
-                }
+                jy[i] = dzBx[i] - dxBz[i];
             }
-        }
+        });
 
-        psi_X = this->layout_->physicalStartIndex(Jz, Direction::X);
-        pei_X = this->layout_->physicalEndIndex(Jz, Direction::X);
-        psi_Y = this->layout_->physicalStartIndex(Jz, Direction::Y);
-        pei_Y = this->layout_->physicalEndIndex(Jz, Direction::Y);
-        psi_Z = this->layout_->physicalStartIndex(Jz, Direction::Z);
-        pei_Z = this->layout_->physicalEndIndex(Jz, Direction::Z);
+        rowsOf(QuantityTag<Scalar::Jz>{}, [&](auto const &first, uint32 size) {
+            Deriv<Scalar::By, Direction::X> dxBy{layout, By, first};
+            Deriv<Scalar::Bx, Direction::Y> dyBx{layout, Bx, first};
 
-        for (auto ix = psi_X; ix <= pei_X; ++ix)
-        {
-            for (auto iy = psi_Y; iy <= pei_Y; ++iy)
+            auto *jz = &nodeAt(Jz, first);
+            for (uint32 i = 0; i < size; ++i)
             {
-                for (auto iz = psi_Z; iz <= pei_Z; ++iz)
-                {
-                    Jz(ix, iy, iz) = this->layout_->deriv(By, make_index(ix, iy, iz), DirectionTag<Direction::X>{})
-                                    -this->layout_->deriv(Bx, make_index(ix, iy, iz), DirectionTag<Direction::Y>{});
-                }
+                jz[i] = dxBy[i] - dyBx[i];
             }
-        }
+        });
     }
 };
 
 
 
 
-template<typename GridLayout>
+/** @brief Ampere computes J = curl B on the physical nodes of J. Each component is computed
+ * tile by tile, the tiles being run by Policy, see forEachTile. Default tiles cover whole
+ * rows, and defaultTileSize nodes in the other directions.
+ */
+template<typename GridLayout, typename Policy = SerialPolicy>
 class Ampere
 {
 private:
+    static constexpr std::size_t dimension = GridLayout::dimension;
+
     AmpereImpl<GridLayout, GridLayout::dimension> impl_;
+    Policy policy_;
+    std::array<uint32, dimension> tileShape_;
 
 public:
+    static constexpr uint32 defaultTileSize = 8;
+
+
+    Ampere()
+    {
+        tileShape_.fill(defaultTileSize);
+        tileShape_[dimension - 1] = std::numeric_limits<uint32>::max();
+    }
+
+
     template<typename VecField>
     void operator()(VecField const &B, VecField &J)
+    {
+        checkLayout_();
+
+        impl_(B, J, physicalRows_());
+    }
+
+
+    /** @brief computes J only on the rows given by rowsOf, instead of all physical nodes.
+     * rowsOf(QuantityTag<quantity>{}, rowFunction) must call rowFunction(first, size) for
+     * each row of nodes of the quantity to compute, see PhysicalRows.
+     */
+    template<typename VecField, typename RowsOf>
+    void operator()(VecField const &B, VecField &J, RowsOf &&rowsOf)
+    {
+        checkLayout_();
+
+        impl_(B, J, std::forward<RowsOf>(rowsOf));
+    }
+
+
+    void setLayout(GridLayout *layout) { impl_.setLayout(layout); }
+
+
+    //! policy running the tiles, e.g. a ThreadPoolPolicy to compute them on several threads
+    void setPolicy(Policy const &policy) { policy_ = policy; }
+
+
+    void setTileShape(std::array<uint32, dimension> const &tileShape)
+    {
+        if (std::any_of(std::begin(tileShape), std::end(tileShape),
+                        [](uint32 tileSize) { return tileSize == 0; }))
+        {
+            throw std::runtime_error("Error - Ampere - tiles need at least one cell");
+        }
+        tileShape_ = tileShape;
+    }
+
+    std::array<uint32, dimension> const &tileShape() const { return tileShape_; }
+
+
+private:
+    void checkLayout_() const
     {
         if (!impl_.hasLayoutSet())
         {
             throw std::runtime_error(
                 "Error - Ampere - GridLayout not set, cannot proceed to calculate ampere()");
         }
-        std::cout << "I'm solving ampere " << GridLayout::dimension << "\n";
-
-        impl_(B, J);
     }
 
 
-    void setLayout(GridLayout *layout) { impl_.setLayout(layout); }
+    TiledPhysicalRows<GridLayout, Policy> physicalRows_() const
+    {
+        return {impl_.layout(), tileShape_, policy_};
+    }
 };
 } // namespace PHARE
 
@@ -1,12 +1,20 @@
-#ifndef PHARE_CORE_NUMERICS_AMPERE_AMPERE_H
-#define PHARE_CORE_NUMERICS_AMPERE_AMPERE_H
+#ifndef PHARE_CORE_NUMERICS_FARADAY_FARADAY_H
+#define PHARE_CORE_NUMERICS_FARADAY_FARADAY_H
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
-#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <utility>
 
 #include "data/grid/gridlayoutdefs.h"
 #include "data/vecfield/vecfield_component.h"
+#include "hybrid/hybrid_quantities.h"
+#include "numerics/stencil/for_each_in_box.h"
+#include "numerics/stencil/row_stencil.h"
 #include "utilities/index/index.h"
+#include "utilities/types.h"
 
 namespace PHARE
 {
@@ -35,7 +43,6 @@ class FaradayImplInternals
 {
 protected:
     GridLayout *layout_{nullptr};
-    const double dt_ = 1.0; // TODO is it where time step should be ?
 
 public:
     /**
@@ -44,6 +51,9 @@ public:
     bool hasLayoutSet() const { return (layout_ == nullptr) ? false : true; }
 
 
+    GridLayout const &layout() const { return *layout_; }
+
+
     /**
      * @brief setLayout is used to give Ampere a pointer to a gridlayout
      */
@@ -62,51 +72,62 @@ public:
 };
 
 
-/** @brief 1D specialization of the ampere equation solver implementation
+/** @brief 1D specialization of the faraday equation solver implementation
+ *
+ * Specializations compute the new magnetic field row by row, see RowDerivative, the
+ * centering of each component being known at compile time.
  */
 template<typename GridLayout>
 class FaradayImpl<GridLayout, 1> : public FaradayImplInternals<GridLayout>
 {
     static_assert(GridLayout::dimension == 1, "Error: Passed non-1D GridLayout to 1D FaradayImpl");
 
+    using Scalar = HybridQuantity::Scalar;
+
+    template<Scalar quantity, Direction direction>
+    using Deriv = RowDerivative<GridLayout, quantity, direction>;
+
 public:
-    template<typename VecField>
-    void operator()(VecField const &B, VecField const &E, VecField &Bnew)
+    template<typename VecField, typename RowsOf>
+    void operator()(VecField const &B, VecField const &E, VecField &Bnew, double dt,
+                    RowsOf &&rowsOf)
     {
         // dBxdt =  0
         // dBydt =  dxEz
         // dBzdt = -dxEy
 
-        auto const &Bx = B.getComponent(Component::X);
         auto const &By = B.getComponent(Component::Y);
         auto const &Bz = B.getComponent(Component::Z);
 
-        auto const &Ex = E.getComponent(Component::X);
         auto const &Ey = E.getComponent(Component::Y);
         auto const &Ez = E.getComponent(Component::Z);
 
-        auto &Bxnew = Bnew.getComponent(Component::X);
         auto &Bynew = Bnew.getComponent(Component::Y);
         auto &Bznew = Bnew.getComponent(Component::Z);
 
-        // Direction should not be in gridlayoutdef but in utilities somehow
-        auto start = this->layout_->physicalStartIndex(Bynew, Direction::X);
-        auto end   = this->layout_->physicalEndIndex(Bynew, Direction::X);
+        auto const &layout = *this->layout_;
 
-        for (auto ix = start; ix <= end; ++ix)
-        {
-            Bynew(ix)
-                = By(ix) + this->dt_*this->layout_->deriv(Ez, make_index(ix), DirectionTag<Direction::X>{});
-        }
+        rowsOf(QuantityTag<Scalar::By>{}, [&](auto const &first, uint32 size) {
+            Deriv<Scalar::Ez, Direction::X> dxEz{layout, Ez, first};
+
+            auto *bynew    = &nodeAt(Bynew, first);
+            auto const *by = &nodeAt(By, first);
+            for (uint32 i = 0; i < size; ++i)
+            {
+                bynew[i] = by[i] + dt * dxEz[i];
+            }
+        });
 
-        start = this->layout_->physicalStartIndex(Bznew, Direction::X);
-        end   = this->layout_->physicalEndIndex(Bznew, Direction::X);
+        rowsOf(QuantityTag<Scalar::Bz>{}, [&](auto const &first, uint32 size) {
+            Deriv<Scalar::Ey, Direction::X> dxEy{layout, Ey, first};
 
-        for (auto ix = start; ix <= end; ++ix)
-        {
-            Bznew(ix)
-                = Bz(ix) - this->dt_*this->layout_->deriv(Ey, make_index(ix), DirectionTag<Direction::X>{});
-        }
+            auto *bznew    = &nodeAt(Bznew, first);
+            auto const *bz = &nodeAt(Bz, first);
+            for (uint32 i = 0; i < size; ++i)
+            {
+                bznew[i] = bz[i] - dt * dxEy[i];
+            }
+        });
     }
 };
 
@@ -117,9 +138,15 @@ class FaradayImpl<GridLayout, 2> : public FaradayImplInternals<GridLayout>
 {
     static_assert(GridLayout::dimension == 2, "Error: Passed non-2D GridLayout to 2D FaradayImpl");
 
+    using Scalar = HybridQuantity::Scalar;
+
+    template<Scalar quantity, Direction direction>
+    using Deriv = RowDerivative<GridLayout, quantity, direction>;
+
 public:
-    template<typename VecField>
-    void operator()(VecField const &B, VecField const &E, VecField &Bnew)
+    template<typename VecField, typename RowsOf>
+    void operator()(VecField const &B, VecField const &E, VecField &Bnew, double dt,
+                    RowsOf &&rowsOf)
     {
         // dBxdt =  -dyEz
         // dBydt =  dxEz
@@ -137,48 +164,41 @@ public:
         auto &Bynew = Bnew.getComponent(Component::Y);
         auto &Bznew = Bnew.getComponent(Component::Z);
 
-        auto psi_X = this->layout_->physicalStartIndex(Bxnew, Direction::X);
-        auto pei_X = this->layout_->physicalEndIndex(Bxnew, Direction::X);
-        auto psi_Y = this->layout_->physicalStartIndex(Bxnew, Direction::Y);
-        auto pei_Y = this->layout_->physicalEndIndex(Bxnew, Direction::Y);
+        auto const &layout = *this->layout_;
 
-        for (auto ix = psi_X; ix <= pei_X; ++ix)
-        {
-            for (auto iy = psi_Y; iy <= pei_Y; ++iy)
+        rowsOf(QuantityTag<Scalar::Bx>{}, [&](auto const &first, uint32 size) {
+            Deriv<Scalar::Ez, Direction::Y> dyEz{layout, Ez, first};
+
+            auto *bxnew    = &nodeAt(Bxnew, first);
+            auto const *bx = &nodeAt(Bx, first);
+            for (uint32 i = 0; i < size; ++i)
             {
-                Bxnew(ix, iy) = Bx(ix, iy)
-                    - this->dt_*this->layout_->deriv(Ez, make_index(ix, iy), DirectionTag<Direction::Y>{});
+                bxnew[i] = bx[i] - dt * dyEz[i];
             }
-        }
+        });
 
-        psi_X = this->layout_->physicalStartIndex(Bynew, Direction::X);
-        pei_X = this->layout_->physicalEndIndex(Bynew, Direction::X);
-        psi_Y = this->layout_->physicalStartIndex(Bynew, Direction::Y);
-        pei_Y = this->layout_->physicalEndIndex(Bynew, Direction::Y);
+        rowsOf(QuantityTag<Scalar::By>{}, [&](auto const &first, uint32 size) {
+            Deriv<Scalar::Ez, Direction::X> dxEz{layout, Ez, first};
 
-        for (auto ix = psi_X; ix <= pei_X; ++ix)
-        {
-            for (auto iy = psi_Y; iy <= pei_Y; ++iy)
+            auto *bynew    = &nodeAt(Bynew, first);
+            auto const *by = &nodeAt(By, first);
+            for (uint32 i = 0; i < size; ++i)
             {
-                Bynew(ix, iy) = By(ix, iy)
-                    + this->dt_*this->layout_->deriv(Ez, make_index(ix, iy), DirectionTag<Direction::X>{});
+                bynew[i] = by[i] + dt * dxEz[i];
             }
-        }
+        });
 
-        psi_X = this->layout_->physicalStartIndex(Bznew, Direction::X);
-        pei_X = this->layout_->physicalEndIndex(Bznew, Direction::X);
-        psi_Y = this->layout_->physicalStartIndex(Bznew, Direction::Y);
-        pei_Y = this->layout_->physicalEndIndex(Bznew, Direction::Y);
+        rowsOf(QuantityTag<Scalar::Bz>{}, [&](auto const &first, uint32 size) {
+            Deriv<Scalar::Ey, Direction::X> dxEy{layout, Ey, first};
+            Deriv<Scalar::Ex, Direction::Y> dyEx{layout, Ex, first};
 
-        for (auto ix = psi_X; ix <= pei_X; ++ix)
-        {
-            for (auto iy = psi_Y; iy <= pei_Y; ++iy)
+            auto *bznew    = &nodeAt(Bznew, first);
+            auto const *bz = &nodeAt(Bz, first);
+            for (uint32 i = 0; i < size; ++i)
             {
-                Bznew(ix, iy) = Bz(ix, iy)
-                    - this->dt_*this->layout_->deriv(Ey, make_index(ix, iy), DirectionTag<Direction::X>{})
-                    + this->dt_*this->layout_->deriv(Ex, make_index(ix, iy), DirectionTag<Direction::Y>{});
+                bznew[i] = bz[i] - dt * dxEy[i] + dt * dyEx[i];
             }
-        }
+        });
     }
 };
 
@@ -189,9 +209,15 @@ class FaradayImpl<GridLayout, 3> : public FaradayImplInternals<GridLayout>
 {
     static_assert(GridLayout::dimension == 3, "Error: Passed non-3D GridLayout to 3D FaradayImpl");
 
+    using Scalar = HybridQuantity::Scalar;
+
+    template<Scalar quantity, Direction direction>
+    using Deriv = RowDerivative<GridLayout, quantity, direction>;
+
 public:
-    template<typename VecField>
-    void operator()(VecField const &B, VecField const &E, VecField &Bnew)
+    template<typename VecField, typename RowsOf>
+    void operator()(VecField const &B, VecField const &E, VecField &Bnew, double dt,
+                    RowsOf &&rowsOf)
     {
         // dBxdt = -dyEz + dzEy
         // dBydt = -dzEx + dxEz
@@ -209,92 +235,185 @@ public:
         auto &Bynew = Bnew.getComponent(Component::Y);
         auto &Bznew = Bnew.getComponent(Component::Z);
 
-        auto psi_X = this->layout_->physicalStartIndex(Bxnew, Direction::X);
-        auto pei_X = this->layout_->physicalEndIndex(Bxnew, Direction::X);
-        auto psi_Y = this->layout_->physicalStartIndex(Bxnew, Direction::Y);
-        auto pei_Y = this->layout_->physicalEndIndex(Bxnew, Direction::Y);
-        auto psi_Z = this->layout_->physicalStartIndex(Bxnew, Direction::Z);
-        auto pei_Z = this->layout_->physicalEndIndex(Bxnew, Direction::Z);
+        auto const &layout = *this->layout_;
 
-        for (auto ix = psi_X; ix <= pei_X; ++ix)
-        {
-            for (auto iy = psi_Y; iy <= pei_Y; ++iy)
+        rowsOf(QuantityTag<Scalar::Bx>{}, [&](auto const &first, uint32 size) {
+            Deriv<Scalar::Ez, Direction::Y> dyEz{layout, Ez, first};
+            Deriv<Scalar::Ey, Direction::Z> dzEy{layout, Ey, first};
+
+            auto *bxnew    = &nodeAt(Bxnew, first);
+            auto const *bx = &nodeAt(Bx, first);
+            for (uint32 i = 0; i < size; ++i)
             {
-                for (auto iz = psi_Z; iz <= pei_Z; ++iz)
-                {
-                    Bxnew(ix, iy, iz) = Bx(ix, iy, iz)
-                        - this->dt_*this->layout_->deriv(Ez, make_index(ix, iy, iz), DirectionTag<Direction::Y>{})
-                        + this->dt_*this->layout_->deriv(Ey, make_index(ix, iy, iz), DirectionTag<Direction::Z>{});
-                }
+                bxnew[i] = bx[i] - dt * dyEz[i] + dt * dzEy[i];
             }
-        }
+        });
 
-        psi_X = this->layout_->physicalStartIndex(Bynew, Direction::X);
-        pei_X = this->layout_->physicalEndIndex(Bynew, Direction::X);
-        psi_Y = this->layout_->physicalStartIndex(Bynew, Direction::Y);
-        pei_Y = this->layout_->physicalEndIndex(Bynew, Direction::Y);
-        psi_Z = this->layout_->physicalStartIndex(Bynew, Direction::Z);
-        pei_Z = this->layout_->physicalEndIndex(Bynew, Direction::Z);
+        rowsOf(QuantityTag<Scalar::By>{}, [&](auto const &first, uint32 size) {
+            Deriv<Scalar::Ex, Direction::Z> dzEx{layout, Ex, first};
+            Deriv<Scalar::Ez, Direction::X> dxEz{layout, Ez, first};
 
-        for (auto ix = psi_X; ix <= pei_X; ++ix)
-        {
-            for (auto iy = psi_Y; iy <= pei_Y; ++iy)
+            auto *bynew    = &nodeAt(Bynew, first);
+            auto const *by = &nodeAt(By, first);
+            for (uint32 i = 0; i < size; ++i)
             {
-                for (auto iz = psi_Z; iz <= pei_Z; ++iz)
-                {
-                    Bynew(ix, iy, iz) = By(ix, iy, iz)
-                        - this->dt_*this->layout_->deriv(Ex, make_index(ix, iy, iz), DirectionTag<Direction::Z>{})
-                        + this->dt_*this->layout_->deriv(Ez, make_index(ix, iy, iz), DirectionTag<Direction::X>{});
-                }
+                bynew[i] = by[i] - dt * dzEx[i] + dt * dxEz[i];
             }
-        }
+        });
 
-        psi_X = this->layout_->physicalStartIndex(Bznew, Direction::X);
-        pei_X = this->layout_->physicalEndIndex(Bznew, Direction::X);
-        psi_Y = this->layout_->physicalStartIndex(Bznew, Direction::Y);
-        pei_Y = this->layout_->physicalEndIndex(Bznew, Direction::Y);
-        psi_Z = this->layout_->physicalStartIndex(Bznew, Direction::Z);
-        pei_Z = this->layout_->physicalEndIndex(Bznew, Direction::Z);
+        rowsOf(QuantityTag<Scalar::Bz>{}, [&](auto const &first, uint32 size) {
+            Deriv<Scalar::Ey, Direction::X> dxEy{layout, Ey, first};
+            Deriv<Scalar::Ex, Direction::Y> dyEx{layout, Ex, first};
 
-        for (auto ix = psi_X; ix <= pei_X; ++ix)
-        {
-            for (auto iy = psi_Y; iy <= pei_Y; ++iy)
+            auto *bznew    = &nodeAt(Bznew, first);
+            auto const *bz = &nodeAt(Bz, first);
+            for (uint32 i = 0; i < size; ++i)
             {
-                for (auto iz = psi_Z; iz <= pei_Z; ++iz)
-                {
-                    Bznew(ix, iy, iz) = Bz(ix, iy, iz)
-                        - this->dt_*this->layout_->deriv(Ey, make_index(ix, iy, iz), DirectionTag<Direction::X>{})
-                        + this->dt_*this->layout_->deriv(Ex, make_index(ix, iy, iz), DirectionTag<Direction::Y>{});
-                }
+                bznew[i] = bz[i] - dt * dxEy[i] + dt * dyEx[i];
             }
-        }
+        });
     }
 };
 
 
 
 
-template<typename GridLayout>
+/** @brief Faraday computes the new magnetic field on the physical nodes tile by tile, with
+ * the Policy of forEachTile. By default, tiles have defaultTileSize nodes in each direction
+ * but the last one, in which rows are left whole so that they stay vectorized.
+ */
+template<typename GridLayout, typename Policy = SerialPolicy>
 class Faraday
 {
 private:
+    static constexpr std::size_t dimension = GridLayout::dimension;
+
     FaradayImpl<GridLayout, GridLayout::dimension> impl_;
+    double dt_{1.};
+    uint32 nbrSubsteps_{1};
+    Policy policy_;
+    std::array<uint32, dimension> tileShape_;
 
 public:
+    static constexpr uint32 defaultTileSize = 8;
+
+
+    Faraday()
+    {
+        tileShape_.fill(defaultTileSize);
+        tileShape_[dimension - 1] = std::numeric_limits<uint32>::max();
+    }
+
+
+    //! computes Bnew = B - dt curl E on the physical nodes of Bnew, dt being timeStep()
     template<typename VecField>
     void operator()(VecField const &B, VecField const &E, VecField &Bnew)
+    {
+        checkLayout_();
+
+        impl_(B, E, Bnew, dt_, physicalRows_());
+    }
+
+
+    /** @brief computes Bnew only on the rows given by rowsOf, instead of all physical nodes.
+     * rowsOf(QuantityTag<quantity>{}, rowFunction) must call rowFunction(first, size) for
+     * each row of nodes of the quantity to compute, see PhysicalRows.
+     */
+    template<typename VecField, typename RowsOf>
+    void operator()(VecField const &B, VecField const &E, VecField &Bnew, RowsOf &&rowsOf)
+    {
+        checkLayout_();
+
+        impl_(B, E, Bnew, dt_, std::forward<RowsOf>(rowsOf));
+    }
+
+
+    /** @brief advances B to Bnew over timeStep() in nbrSubsteps() substeps, E being updated
+     * from the magnetic field of the previous substep in between.
+     *
+     * The first substep computes Bnew from B and E, the next ones advance Bnew from itself.
+     * Between two substeps, updateE(Bnew, E) is called: it must fill the ghost nodes of Bnew
+     * that it needs, and compute E from Bnew (Ampere, Ohm, and the ghost nodes of E), so that
+     * the fields are advanced with a time step fitting their own stability constraint while
+     * the particles are pushed once over timeStep(). E is not updated after the last substep.
+     * With a single substep, this is operator()(B, E, Bnew).
+     */
+    template<typename VecField, typename UpdateE>
+    void subcycle(VecField const &B, VecField &E, VecField &Bnew, UpdateE &&updateE)
+    {
+        checkLayout_();
+
+        auto const substep = dt_ / nbrSubsteps_;
+
+        impl_(B, E, Bnew, substep, physicalRows_());
+        for (auto iSubstep = 1u; iSubstep < nbrSubsteps_; ++iSubstep)
+        {
+            updateE(static_cast<VecField const &>(Bnew), E);
+            impl_(Bnew, E, Bnew, substep, physicalRows_());
+        }
+    }
+
+
+    void setLayout(GridLayout *layout) { impl_.setLayout(layout); }
+
+
+    void setTimeStep(double dt)
+    {
+        if (!(dt > 0.))
+        {
+            throw std::runtime_error("Error - Faraday - the time step must be positive");
+        }
+        dt_ = dt;
+    }
+
+    double timeStep() const { return dt_; }
+
+
+    //! number of substeps of subcycle(), each of timeStep() / nbrSubsteps()
+    void setNbrSubsteps(uint32 nbrSubsteps)
+    {
+        if (nbrSubsteps == 0)
+        {
+            throw std::runtime_error("Error - Faraday - needs at least one substep");
+        }
+        nbrSubsteps_ = nbrSubsteps;
+    }
+
+    uint32 nbrSubsteps() const { return nbrSubsteps_; }
+
+
+    //! policy running the tiles, e.g. a ThreadPoolPolicy to compute them on several threads
+    void setPolicy(Policy const &policy) { policy_ = policy; }
+
+
+    void setTileShape(std::array<uint32, dimension> const &tileShape)
+    {
+        if (std::any_of(std::begin(tileShape), std::end(tileShape),
+                        [](uint32 tileSize) { return tileSize == 0; }))
+        {
+            throw std::runtime_error("Error - Faraday - tiles need at least one cell");
+        }
+        tileShape_ = tileShape;
+    }
+
+    std::array<uint32, dimension> const &tileShape() const { return tileShape_; }
+
+
+private:
+    void checkLayout_() const
     {
         if (!impl_.hasLayoutSet())
         {
             throw std::runtime_error(
                 "Error - Faraday - GridLayout not set, cannot proceed to calculate faraday()");
         }
-
-        impl_(B, E, Bnew);
     }
 
 
-    void setLayout(GridLayout *layout) { impl_.setLayout(layout); }
+    TiledPhysicalRows<GridLayout, Policy> physicalRows_() const
+    {
+        return {impl_.layout(), tileShape_, policy_};
+    }
 };
 } // namespace PHARE
 
@@ -0,0 +1,274 @@
+#ifndef PHARE_CORE_NUMERICS_FARADAY_AMPERE_FARADAY_AMPERE_H
+#define PHARE_CORE_NUMERICS_FARADAY_AMPERE_FARADAY_AMPERE_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+#include "data/grid/gridlayoutdefs.h"
+#include "hybrid/hybrid_quantities.h"
+#include "numerics/ampere/ampere.h"
+#include "numerics/faraday/faraday.h"
+#include "numerics/stencil/for_each_in_box.h"
+#include "numerics/stencil/row_stencil.h"
+#include "utilities/box/box.h"
+#include "utilities/types.h"
+
+
+namespace PHARE
+{
+/** @brief FaradayAmpere computes Bnew with Faraday and J = curl Bnew with Ampere in a single
+ * sweep over the patch, tile by tile, so that the Bnew of a tile is still in cache when the
+ * current of the tile is computed from it.
+ *
+ * Tiles are boxes of tileShape() cells. For each tile, Bnew is computed on the nodes of the
+ * tile and on one more node above it in each direction, which the current of the tile needs.
+ * The nodes below the tile were computed with the previous tiles. By default, tiles have
+ * defaultTileSize cells in each direction but the last one, in which they cover the whole
+ * patch, so that the rows computed by Faraday and Ampere stay long and vectorized.
+ *
+ * The current on the nodes at the boundary of the patch needs the ghost nodes of Bnew, which
+ * are only known once they are filled by the messengers. operator() does not compute it, the
+ * current is completed with completeCurrent() once the ghost nodes of Bnew are filled:
+ *
+ *     faradayAmpere(B, E, Bnew, J);
+ *     // fill the ghost nodes of Bnew
+ *     faradayAmpere.completeCurrent(Bnew, J);
+ *
+ * gives the same Bnew and J as Faraday, then the ghost filling of Bnew, then Ampere.
+ */
+template<typename GridLayout>
+class FaradayAmpere
+{
+public:
+    static constexpr std::size_t dimension     = GridLayout::dimension;
+    static constexpr uint32 defaultTileSize    = 8;
+    static constexpr std::size_t nbrComponents = 3;
+
+
+    FaradayAmpere()
+    {
+        tileShape_.fill(defaultTileSize);
+        tileShape_[dimension - 1] = std::numeric_limits<uint32>::max();
+    }
+
+
+    void setLayout(GridLayout* layout)
+    {
+        faraday_.setLayout(layout);
+        ampere_.setLayout(layout);
+        layout_ = layout;
+    }
+
+
+    void setTileShape(std::array<uint32, dimension> const& tileShape)
+    {
+        if (std::any_of(std::begin(tileShape), std::end(tileShape),
+                        [](uint32 tileSize) { return tileSize == 0; }))
+        {
+            throw std::runtime_error("Error - FaradayAmpere - tiles need at least one cell");
+        }
+        tileShape_ = tileShape;
+    }
+
+
+    std::array<uint32, dimension> const& tileShape() const { return tileShape_; }
+
+
+    //! time step of Faraday, see Faraday::setTimeStep()
+    void setTimeStep(double dt) { faraday_.setTimeStep(dt); }
+
+    double timeStep() const { return faraday_.timeStep(); }
+
+
+
+
+    /** @brief computes Bnew on all its physical nodes, and J on the physical nodes that do not
+     * need the ghost nodes of Bnew, see completeCurrent()
+     */
+    template<typename VecField>
+    void operator()(VecField const& B, VecField const& E, VecField& Bnew, VecField& J)
+    {
+        checkLayout_();
+
+        auto const nbrCells = layout_->nbrCells();
+
+        Box<uint32, dimension> cells;
+        for (auto iDir = 0u; iDir < dimension; ++iDir)
+        {
+            cells.lower[iDir] = 0;
+            cells.upper[iDir] = nbrCells[iDir];
+        }
+
+        auto const currentInnerBoxes = currentInnerBoxes_();
+
+        forEachTile(cells, tileShape_, SerialPolicy{}, [&](Box<uint32, dimension> const& tile) {
+            // lower and upper cells of the tile, the last tiles also have the last primal node
+            std::array<uint32, dimension> lower;
+            std::array<uint32, dimension> upper;
+            for (auto iDir = 0u; iDir < dimension; ++iDir)
+            {
+                lower[iDir] = tile.lower[iDir];
+                upper[iDir] = tile.upper[iDir] == nbrCells[iDir] ? nbrCells[iDir] + 1
+                                                                 : tile.upper[iDir];
+            }
+
+            faraday_(B, E, Bnew, [&](auto quantityTag, auto&& rowFunction) {
+                constexpr auto quantity = decltype(quantityTag)::quantity;
+                auto box                = tileBox_<quantity>(lower, upper, 1);
+
+                forEachRow(box, rowFunction);
+            });
+
+            ampere_(Bnew, J, [&](auto quantityTag, auto&& rowFunction) {
+                constexpr auto quantity = decltype(quantityTag)::quantity;
+                auto box                = tileBox_<quantity>(lower, upper, 0);
+
+                forEachRow(intersection_(box, currentInnerBoxes[componentIndex_(quantity)]),
+                           rowFunction);
+            });
+        });
+    }
+
+
+
+
+    /** @brief computes J on the physical nodes left by operator(), at the boundary of the
+     * patch. The ghost nodes of Bnew must have been filled.
+     */
+    template<typename VecField>
+    void completeCurrent(VecField const& Bnew, VecField& J)
+    {
+        checkLayout_();
+
+        auto const currentInnerBoxes = currentInnerBoxes_();
+
+        ampere_(Bnew, J, [&](auto quantityTag, auto&& rowFunction) {
+            constexpr auto quantity = decltype(quantityTag)::quantity;
+
+            auto const physical = physicalBox<quantity>(*layout_);
+            auto const inner    = currentInnerBoxes[componentIndex_(quantity)];
+
+            // the physical box minus the inner box, as slabs below and above the inner box in
+            // each direction, the previous directions being restricted to the inner box
+            auto slab = physical;
+            for (auto iDir = 0u; iDir < dimension; ++iDir)
+            {
+                auto below        = slab;
+                below.upper[iDir] = inner.lower[iDir];
+                auto above        = slab;
+                above.lower[iDir] = inner.upper[iDir];
+                slab.lower[iDir]  = inner.lower[iDir];
+                slab.upper[iDir]  = inner.upper[iDir];
+
+                forEachRow(below, rowFunction);
+                forEachRow(above, rowFunction);
+            }
+        });
+    }
+
+
+
+
+private:
+    using Scalar   = HybridQuantity::Scalar;
+    using IndexBox = Box<uint32, dimension>;
+
+
+    void checkLayout_() const
+    {
+        if (layout_ == nullptr)
+        {
+            throw std::runtime_error("Error - FaradayAmpere - GridLayout not set, cannot proceed "
+                                     "to calculate faraday and ampere");
+        }
+    }
+
+
+    static std::size_t componentIndex_(Scalar quantity)
+    {
+        switch (quantity)
+        {
+            case Scalar::Jx: return 0;
+            case Scalar::Jy: return 1;
+            case Scalar::Jz: return 2;
+            default: throw std::runtime_error("Error - FaradayAmpere - not a current component");
+        }
+    }
+
+
+
+
+    /** nodes of a quantity from the lower cell of a tile to its upper cell, plus extension
+     * nodes above, restricted to the physical nodes. Node index and cell index differ by the
+     * physical start index of the quantity.
+     */
+    template<Scalar quantity>
+    IndexBox tileBox_(std::array<uint32, dimension> const& lower,
+                      std::array<uint32, dimension> const& upper, uint32 extension) const
+    {
+        auto box = physicalBox<quantity>(*layout_);
+        for (auto iDir = 0u; iDir < dimension; ++iDir)
+        {
+            auto const start = box.lower[iDir];
+            box.lower[iDir]  = start + lower[iDir];
+            box.upper[iDir]  = std::min(box.upper[iDir], start + upper[iDir] + extension);
+        }
+        return box;
+    }
+
+
+
+
+    /** physical nodes of each current component that do not need the ghost nodes of Bnew.
+     * A current component primal in a direction is derived from dual nodes of B, and its
+     * first and last physical nodes need the dual ghost nodes around the patch.
+     */
+    std::array<IndexBox, nbrComponents> currentInnerBoxes_() const
+    {
+        return {{innerBox_(physicalBox<Scalar::Jx>(*layout_), GridLayout::centering(Scalar::Jx)),
+                 innerBox_(physicalBox<Scalar::Jy>(*layout_), GridLayout::centering(Scalar::Jy)),
+                 innerBox_(physicalBox<Scalar::Jz>(*layout_),
+                           GridLayout::centering(Scalar::Jz))}};
+    }
+
+
+    static IndexBox innerBox_(IndexBox box, std::array<QtyCentering, dimension> const& centering)
+    {
+        for (auto iDir = 0u; iDir < dimension; ++iDir)
+        {
+            if (centering[iDir] == QtyCentering::primal)
+            {
+                box.lower[iDir] += 1;
+                box.upper[iDir] = std::max(box.lower[iDir], box.upper[iDir] - 1);
+            }
+        }
+        return box;
+    }
+
+
+    static IndexBox intersection_(IndexBox box, IndexBox const& other)
+    {
+        for (auto iDir = 0u; iDir < dimension; ++iDir)
+        {
+            box.lower[iDir] = std::max(box.lower[iDir], other.lower[iDir]);
+            box.upper[iDir] = std::min(box.upper[iDir], other.upper[iDir]);
+        }
+        return box;
+    }
+
+
+
+
+    GridLayout* layout_{nullptr};
+    Faraday<GridLayout> faraday_;
+    Ampere<GridLayout> ampere_;
+    std::array<uint32, dimension> tileShape_;
+};
+
+
+} // namespace PHARE
+
+#endif
@@ -1,11 +1,17 @@
 #ifndef PHARE_CORE_NUMERICS_INTERPOLATOR_INTERPOLATOR_H
 #define PHARE_CORE_NUMERICS_INTERPOLATOR_INTERPOLATOR_H
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
+#include <iterator>
+#include <utility>
 
+#include "data/electromag/electromag_at_particles.h"
+#include "data/electromag/electromag_gather_cache.h"
 #include "data/grid/gridlayout.h"
 #include "data/vecfield/vecfield_component.h"
+#include "utilities/memory/aligned_allocator.h"
 
 namespace PHARE
 {
@@ -36,13 +42,17 @@ int computeStartIndex(double normalizedPos)
  *  This class assumes the interpolation order is known at compile-time
  *  thus there are three specialization for orders 1, 2 and 3.
  *
- *  the class has only one method called computeWeight that takes three arguments:
+ *  the class has a method called computeWeight that takes three arguments:
  *
  *  \param[in] normalized position is the particle position in the cell normalized by grid spacing
  *  \param[in] startIndex first grid index where to interpolate the field
  *  \param[out] weights contains the nbrPointsSupport weights calculated
  *
  *  these three parameters are given for a specific direction (x, y or z)
+ *
+ *  computeWeights does the same for nbrParticles positions at once, and also computes
+ *  their start indexes. weights[ik][iPart] is the ik-th weight of the iPart-th particle,
+ *  so that the loop runs over particles and is vectorized.
  */
 template<std::size_t interpOrder>
 class Weighter
@@ -64,6 +74,23 @@ public:
         weights[0] = 1. - weights[1];
     }
 
+    inline void computeWeights(double const* normalizedPos, std::size_t nbrParticles,
+                               int* startIndex, std::array<double*, nbrPointsSupport(1)> weights)
+    {
+        auto* weights0 = weights[0];
+        auto* weights1 = weights[1];
+
+        for (std::size_t iPart = 0; iPart < nbrParticles; ++iPart)
+        {
+            auto const index = computeStartIndex<1>(normalizedPos[iPart]);
+            auto const w1    = normalizedPos[iPart] - static_cast<double>(index);
+
+            startIndex[iPart] = index;
+            weights1[iPart]   = w1;
+            weights0[iPart]   = 1. - w1;
+        }
+    }
+
     static const int interp_order = 1;
 };
 
@@ -89,6 +116,30 @@ public:
         weights[2] = 0.5 * coef3 * coef3;
     }
 
+    inline void computeWeights(double const* normalizedPos, std::size_t nbrParticles,
+                               int* startIndex, std::array<double*, nbrPointsSupport(2)> weights)
+    {
+        auto* weights0 = weights[0];
+        auto* weights1 = weights[1];
+        auto* weights2 = weights[2];
+
+        for (std::size_t iPart = 0; iPart < nbrParticles; ++iPart)
+        {
+            auto const start = computeStartIndex<2>(normalizedPos[iPart]);
+
+            auto index   = start + 1;
+            auto delta   = static_cast<double>(index) - normalizedPos[iPart];
+            double coef1 = 0.5 + delta;
+            double coef2 = delta;
+            double coef3 = 0.5 - delta;
+
+            startIndex[iPart] = start;
+            weights0[iPart]   = 0.5 * coef1 * coef1;
+            weights1[iPart]   = 0.75 - coef2 * coef2;
+            weights2[iPart]   = 0.5 * coef3 * coef3;
+        }
+    }
+
     static const int interp_order = 2;
 };
 
@@ -121,12 +172,192 @@ public:
         weights[3] = (4. / 3.) * coef4 * coef4 * coef4;
     }
 
+    inline void computeWeights(double const* normalizedPos, std::size_t nbrParticles,
+                               int* startIndex, std::array<double*, nbrPointsSupport(3)> weights)
+    {
+        auto* weights0 = weights[0];
+        auto* weights1 = weights[1];
+        auto* weights2 = weights[2];
+        auto* weights3 = weights[3];
+
+        for (std::size_t iPart = 0; iPart < nbrParticles; ++iPart)
+        {
+            auto const start = computeStartIndex<3>(normalizedPos[iPart]);
+
+            auto index   = static_cast<double>(start) - normalizedPos[iPart];
+            double coef1 = 1. + 0.5 * index;
+            double coef2 = index + 1;
+            double coef3 = index + 2;
+            double coef4 = 1. - 0.5 * (index + 3);
+
+            double coef2_sq  = coef2 * coef2;
+            double coef2_cub = coef2_sq * coef2;
+            double coef3_sq  = coef3 * coef3;
+            double coef3_cub = coef3_sq * coef3;
+
+            startIndex[iPart] = start;
+            weights0[iPart]   = (4. / 3.) * coef1 * coef1 * coef1;
+            weights1[iPart]   = 2. / 3. - coef2_sq - 0.5 * coef2_cub;
+            weights2[iPart]   = 2. / 3. - coef3_sq + 0.5 * coef3_cub;
+            weights3[iPart]   = (4. / 3.) * coef4 * coef4 * coef4;
+        }
+    }
+
     static const int interp_order = 3;
 };
 
 
 
 
+/**
+ * @brief dualOffset returns the offset by which changing the
+ * startIndex for dual node interpolation. This offset depends on
+ * interpolation order. */
+inline constexpr double dualOffset(int order)
+{
+    std::array<double, 3> offsets = {{-0.5, -0.5, 0.5}};
+    return offsets[static_cast<std::array<double, 3>::size_type>(order - 1)];
+}
+
+
+
+
+/** \brief WeightBatch computes the start indexes and the weights of a batch of at most
+ * maxSize particles, for primal and dual nodes in all directions, with
+ * Weighter::computeWeights.
+ *
+ * Values are stored in SoA arrays, one per centering, direction and support point.
+ * startIndexes(iPart) and weights(iPart) are views of the values of the iPart-th particle
+ * of the batch, indexed as [centering][direction] and [centering][direction][point] like
+ * the arrays given to MeshToParticle and ParticleToMesh, which can thus read them directly.
+ */
+template<std::size_t dim, std::size_t interpOrder>
+class WeightBatch
+{
+public:
+    static constexpr std::size_t maxSize   = 128;
+    static constexpr std::size_t nbrPoints = nbrPointsSupport(interpOrder);
+
+
+    //! start indexes of a particle, read as startIndex[centering][direction]
+    struct StartIndexView
+    {
+        struct Directions
+        {
+            int operator[](std::size_t iDim) const { return first[iDim * maxSize]; }
+
+            int const* first;
+        };
+
+        Directions operator[](std::size_t iCentering) const
+        {
+            return Directions{first + iCentering * dim * maxSize};
+        }
+
+        int const* first;
+    };
+
+
+    //! weights of a particle, read as weights[centering][direction][point]
+    struct WeightView
+    {
+        struct Points
+        {
+            double operator[](std::size_t iPoint) const { return first[iPoint * maxSize]; }
+
+            static constexpr std::size_t size() { return nbrPoints; }
+
+            double const* first;
+        };
+
+        struct Directions
+        {
+            Points operator[](std::size_t iDim) const
+            {
+                return Points{first + iDim * nbrPoints * maxSize};
+            }
+
+            double const* first;
+        };
+
+        Directions operator[](std::size_t iCentering) const
+        {
+            return Directions{first + iCentering * dim * nbrPoints * maxSize};
+        }
+
+        double const* first;
+    };
+
+
+
+
+    //! computes the start indexes and weights of the particles in [begin, end[
+    template<typename PartIterator>
+    void compute(PartIterator begin, PartIterator end)
+    {
+        auto constexpr primal = static_cast<std::size_t>(QtyCentering::primal);
+        auto constexpr dual   = static_cast<std::size_t>(QtyCentering::dual);
+
+        size_ = 0;
+        for (auto currPart = begin; currPart != end; ++currPart, ++size_)
+        {
+            for (auto iDim = 0u; iDim < dim; ++iDim)
+            {
+                double normalizedPos = (*currPart).iCell[iDim] + (*currPart).delta[iDim];
+
+                positions_[primal][iDim][size_] = normalizedPos;
+                positions_[dual][iDim][size_]   = normalizedPos + dualOffset(interpOrder);
+            }
+        }
+
+        for (auto iCentering : {primal, dual})
+        {
+            for (auto iDim = 0u; iDim < dim; ++iDim)
+            {
+                std::array<double*, nbrPoints> weights;
+                for (auto iPoint = 0u; iPoint < nbrPoints; ++iPoint)
+                {
+                    weights[iPoint] = weights_[iCentering][iDim][iPoint].data();
+                }
+
+                weighter_.computeWeights(positions_[iCentering][iDim].data(), size_,
+                                         startIndexes_[iCentering][iDim].data(), weights);
+            }
+        }
+    }
+
+
+    std::size_t size() const { return size_; }
+
+    StartIndexView startIndexes(std::size_t iPart) const
+    {
+        return StartIndexView{startIndexes_[0][0].data() + iPart};
+    }
+
+    WeightView weights(std::size_t iPart) const
+    {
+        return WeightView{weights_[0][0][0].data() + iPart};
+    }
+
+
+
+private:
+    template<typename T>
+    using Lanes = std::array<T, maxSize>;
+
+    Weighter<interpOrder> weighter_;
+    std::size_t size_{0};
+
+    // [centering][direction], and [point] for the weights
+    alignas(simdAlignment) std::array<std::array<Lanes<double>, dim>, 2> positions_;
+    alignas(simdAlignment) std::array<std::array<Lanes<int>, dim>, 2> startIndexes_;
+    alignas(simdAlignment) std::array<std::array<std::array<Lanes<double>, nbrPoints>, dim>, 2>
+        weights_;
+};
+
+
+
+
 //! Interpol performs the interpolation of a field using precomputed weights at
 //! indices starting at startIndex. The class is templated by the Dimensionality
 template<std::size_t dim>
@@ -255,8 +486,9 @@ public:
 
 
 
-//! ParticleToMesh projects a particle density and flux to given grids
-template<typename GridLayout, std::size_t dim>
+//! ParticleToMesh projects a particle density and flux to given grids, using
+//! precomputed weights at indices starting at startIndex, as MeshToParticle
+template<std::size_t dim>
 class ParticleToMesh
 {
 };
@@ -265,19 +497,18 @@ class ParticleToMesh
 
 /** \brief specialization of ParticleToMesh for 1D interpolation
  */
-template<typename GridLayout>
-class ParticleToMesh<GridLayout, 1>
+template<>
+class ParticleToMesh<1>
 {
-public: /** Performs the 1D interpolation
-         * \param[in] density is the field that will be interpolated from the particle Particle
-         * \param[in] xFlux is the field that will be interpolated from the particle Particle
-         * \param[in] yFlux is the field that will be interpolated from the particle Particle
-         * \param[in] zFlux is the field that will be interpolated from the particle Particle
-         * \param[in] fieldCentering is the centering (dual or primal) of the field in each
-         * direction \param[in] particle is the single particle used for the interpolation of
-         * density and flux \param[in] startIndex is the first index for which a particle will
-         * contribute \param[in] weights is the arrays of weights for the associated index
-         */
+public:
+    /** Performs the 1D projection
+     * \param[in] density is the grid on which the particle density is projected
+     * \param[in] xFlux, yFlux and zFlux are the grids on which the particle flux is projected
+     * \param[in] fieldCentering is the centering (dual or primal) of the density and flux
+     * \param[in] particle is the particle whose density and flux are projected
+     * \param[in] startIndex is the first of the nbrPointsSupport indices where to project
+     * \param[in] weights are the nbrPointsSupport weights used for the projection
+     */
     template<typename Field, typename Array1, typename Array2, typename Particle>
     inline void operator()(Field& density, Field& xFlux, Field& yFlux, Field& zFlux,
                            std::array<QtyCentering, 1> const& fieldCentering,
@@ -288,10 +519,10 @@ public: /** Performs the 1D interpolation
         auto const& xWeights    = weights[static_cast<int>(fieldCentering[0])][0];
         auto order_size         = xWeights.size();
 
-        auto const partRho   = particle.weights * cellVolumeInverse_;
-        auto const xPartFlux = particle.v[0];
-        auto const yPartFlux = particle.v[1];
-        auto const zPartFlux = particle.v[2];
+        double const partRho   = particle.weight;
+        double const xPartFlux = partRho * particle.v[0];
+        double const yPartFlux = partRho * particle.v[1];
+        double const zPartFlux = partRho * particle.v[2];
 
         for (auto ik = 0u; ik < order_size; ++ik)
         {
@@ -302,10 +533,6 @@ public: /** Performs the 1D interpolation
             zFlux(xStartIndex + ik) += zPartFlux * xWeights[ik];
         }
     }
-
-private:
-    GridLayout* layout_;
-    double cellVolumeInverse_ = layout_->inverseMeshSize_[0];
 };
 
 
@@ -313,22 +540,15 @@ private:
 
 /** \brief specialization of ParticleToMesh for 2D interpolation
  */
-template<typename GridLayout>
-class ParticleToMesh<GridLayout, 2>
+template<>
+class ParticleToMesh<2>
 {
-public: /** Performs the 2D interpolation
-         * \param[in] density is the field that will be interpolated from the particle Particle
-         * \param[in] xFlux is the field that will be interpolated from the particle Particle
-         * \param[in] yFlux is the field that will be interpolated from the particle Particle
-         * \param[in] zFlux is the field that will be interpolated from the particle Particle
-         * \param[in] fieldCentering is the centering (dual or primal) of the field in each
-         * direction \param[in] particle is the single particle used for the interpolation of
-         * density and flux \param[in] startIndex is the first index for which a particle will
-         * contribute \param[in] weights is the arrays of weights for the associated index
-         */
+public:
+    /** Performs the 2D projection, see ParticleToMesh<1>
+     */
     template<typename Field, typename Array1, typename Array2, typename Particle>
     inline void operator()(Field& density, Field& xFlux, Field& yFlux, Field& zFlux,
-                           std::array<QtyCentering, 1> const& fieldCentering,
+                           std::array<QtyCentering, 2> const& fieldCentering,
                            Particle const& particle, Array1 const& startIndex,
                            Array2 const& weights)
     {
@@ -337,32 +557,26 @@ public: /** Performs the 2D interpolation
         auto const& xWeights    = weights[static_cast<int>(fieldCentering[0])][0];
         auto const& yWeights    = weights[static_cast<int>(fieldCentering[1])][1];
 
-        auto const partRho   = particle.weights * cellVolumeInverse_;
-        auto const xPartFlux = particle.v[0];
-        auto const yPartFlux = particle.v[1];
-        auto const zPartFlux = particle.v[2];
+        double const partRho   = particle.weight;
+        double const xPartFlux = partRho * particle.v[0];
+        double const yPartFlux = partRho * particle.v[1];
+        double const zPartFlux = partRho * particle.v[2];
 
         auto order_size = xWeights.size();
         for (auto ix = 0u; ix < order_size; ++ix)
         {
             for (auto iy = 0u; iy < order_size; ++iy)
             {
-                density(xStartIndex + ix, yStartIndex + iy)
-                    += partRho * xWeights[ix] * yWeights[iy];
-
-                xFlux(xStartIndex + ix, yStartIndex + iy)
-                    += xPartFlux * xWeights[ix] * yWeights[iy];
-                yFlux(xStartIndex + ix, yStartIndex + iy)
-                    += yPartFlux * xWeights[ix] * yWeights[iy];
-                zFlux(xStartIndex + ix, yStartIndex + iy)
-                    += zPartFlux * xWeights[ix] * yWeights[iy];
+                auto const weight = xWeights[ix] * yWeights[iy];
+
+                density(xStartIndex + ix, yStartIndex + iy) += partRho * weight;
+
+                xFlux(xStartIndex + ix, yStartIndex + iy) += xPartFlux * weight;
+                yFlux(xStartIndex + ix, yStartIndex + iy) += yPartFlux * weight;
+                zFlux(xStartIndex + ix, yStartIndex + iy) += zPartFlux * weight;
             }
         }
     }
-
-private:
-    GridLayout* layout_;
-    double cellVolumeInverse_ = layout_->inverseMeshSize_[0] * layout_->inverseMeshSize_[1];
 };
 
 
@@ -370,22 +584,15 @@ private:
 
 /** \brief specialization of ParticleToMesh for 3D interpolation
  */
-template<typename GridLayout>
-class ParticleToMesh<GridLayout, 3>
+template<>
+class ParticleToMesh<3>
 {
-public: /** Performs the 3D interpolation
-         * \param[in] density is the field that will be interpolated from the particle Particle
-         * \param[in] xFlux is the field that will be interpolated from the particle Particle
-         * \param[in] yFlux is the field that will be interpolated from the particle Particle
-         * \param[in] zFlux is the field that will be interpolated from the particle Particle
-         * \param[in] fieldCentering is the centering (dual or primal) of the field in each
-         * direction \param[in] particle is the single particle used for the interpolation of
-         * density and flux \param[in] startIndex is the first index for which a particle will
-         * contribute \param[in] weights is the arrays of weights for the associated index
-         */
+public:
+    /** Performs the 3D projection, see ParticleToMesh<1>
+     */
     template<typename Field, typename Array1, typename Array2, typename Particle>
     inline void operator()(Field& density, Field& xFlux, Field& yFlux, Field& zFlux,
-                           std::array<QtyCentering, 1> const& fieldCentering,
+                           std::array<QtyCentering, 3> const& fieldCentering,
                            Particle const& particle, Array1 const& startIndex,
                            Array2 const& weights)
     {
@@ -396,10 +603,10 @@ public: /** Performs the 3D interpolation
         auto const& yWeights    = weights[static_cast<int>(fieldCentering[1])][1];
         auto const& zWeights    = weights[static_cast<int>(fieldCentering[2])][2];
 
-        auto const partRho   = particle.weights * cellVolumeInverse_;
-        auto const xPartFlux = particle.v[0];
-        auto const yPartFlux = particle.v[1];
-        auto const zPartFlux = particle.v[2];
+        double const partRho   = particle.weight;
+        double const xPartFlux = partRho * particle.v[0];
+        double const yPartFlux = partRho * particle.v[1];
+        double const zPartFlux = partRho * particle.v[2];
 
         auto order_size = xWeights.size();
         for (auto ix = 0u; ix < order_size; ++ix)
@@ -408,26 +615,214 @@ public: /** Performs the 3D interpolation
             {
                 for (auto iz = 0u; iz < order_size; ++iz)
                 {
+                    auto const weight = xWeights[ix] * yWeights[iy] * zWeights[iz];
+
                     density(xStartIndex + ix, yStartIndex + iy, zStartIndex + iz)
-                        += partRho * xWeights[ix] * yWeights[iy] * zWeights[iz];
+                        += partRho * weight;
 
                     xFlux(xStartIndex + ix, yStartIndex + iy, zStartIndex + iz)
-                        += xPartFlux * xWeights[ix] * yWeights[iy] * zWeights;
-
+                        += xPartFlux * weight;
                     yFlux(xStartIndex + ix, yStartIndex + iy, zStartIndex + iz)
-                        += yPartFlux * xWeights[ix] * yWeights[iy] * zWeights[iz];
-
+                        += yPartFlux * weight;
                     zFlux(xStartIndex + ix, yStartIndex + iy, zStartIndex + iz)
-                        += zPartFlux * xWeights[ix] * yWeights[iy] * zWeights;
+                        += zPartFlux * weight;
                 }
             }
         }
     }
+};
+
+
+
+
+/** \brief CellAccumulator sums the density and flux deposited by the particles of one cell
+ * on a small block of nodes, and adds the block to the grids once for the whole cell.
+ *
+ * The start index of a particle is the same for all particles of a cell, or one more,
+ * depending on its position in the cell. The block thus has nbrPointsSupport + 1 nodes in
+ * each direction, starting at the start index of a particle at the lower corner of the
+ * cell (see reset()), and flush() only adds the nodes the particles of the cell used.
+ * Nodes of the block are set back to zero by flush().
+ */
+template<std::size_t dim, std::size_t interpOrder>
+class CellAccumulator
+{
+public:
+    static constexpr std::size_t nbrPoints = nbrPointsSupport(interpOrder);
+    static constexpr std::size_t blockSize = nbrPoints + 1;
+    static constexpr std::size_t nbrNodes
+        = dim == 1 ? blockSize
+                   : dim == 2 ? blockSize * blockSize : blockSize * blockSize * blockSize;
+
+
+    CellAccumulator()
+    {
+        for (auto& node : values_)
+        {
+            node.fill(0.);
+        }
+    }
+
+
+    //! starts the accumulation for the particles of a cell, with the given centering
+    void reset(std::array<int, dim> const& iCell, std::array<QtyCentering, dim> const& centering)
+    {
+        for (auto iDim = 0u; iDim < dim; ++iDim)
+        {
+            auto offset = centering[iDim] == QtyCentering::dual ? dualOffset(interpOrder) : 0.;
+
+            blockStart_[iDim] = computeStartIndex<interpOrder>(iCell[iDim] + offset);
+            lower_[iDim]      = 1;
+            upper_[iDim]      = 0;
+        }
+    }
+
+
+
+
+    /** adds the density and flux of the particle, read with its start indexes and weights
+     * as in ParticleToMesh
+     */
+    template<typename Particle, typename Array1, typename Array2>
+    inline void add(Particle const& particle, std::array<QtyCentering, dim> const& centering,
+                    Array1 const& startIndex, Array2 const& weights)
+    {
+        double const partRho = particle.weight;
+        alignas(4 * sizeof(double)) std::array<double, 4> const partValues{
+            {partRho, partRho * particle.v[0], partRho * particle.v[1], partRho * particle.v[2]}};
+
+        std::array<std::size_t, dim> offset;
+        for (auto iDim = 0u; iDim < dim; ++iDim)
+        {
+            auto const iCentering = static_cast<std::size_t>(centering[iDim]);
+            auto const shift      = startIndex[iCentering][iDim] - blockStart_[iDim];
+
+            offset[iDim] = static_cast<std::size_t>(shift);
+            lower_[iDim] = std::min(lower_[iDim], shift);
+            upper_[iDim] = std::max(upper_[iDim], shift);
+        }
+
+        // the 4 values of a node are contiguous, so that they are added at once
+        auto addNode = [&](std::size_t iNode, double weight) {
+            for (auto iQty = 0u; iQty < 4u; ++iQty)
+            {
+                values_[iNode][iQty] += partValues[iQty] * weight;
+            }
+        };
+
+        auto const& xWeights = weights[static_cast<std::size_t>(centering[0])][0];
+
+        if constexpr (dim == 1)
+        {
+            for (auto ix = 0u; ix < nbrPoints; ++ix)
+            {
+                addNode(offset[0] + ix, xWeights[ix]);
+            }
+        }
+        else if constexpr (dim == 2)
+        {
+            auto const& yWeights = weights[static_cast<std::size_t>(centering[1])][1];
+
+            for (auto ix = 0u; ix < nbrPoints; ++ix)
+            {
+                auto const row = (offset[0] + ix) * blockSize + offset[1];
+                for (auto iy = 0u; iy < nbrPoints; ++iy)
+                {
+                    addNode(row + iy, xWeights[ix] * yWeights[iy]);
+                }
+            }
+        }
+        else
+        {
+            auto const& yWeights = weights[static_cast<std::size_t>(centering[1])][1];
+            auto const& zWeights = weights[static_cast<std::size_t>(centering[2])][2];
+
+            for (auto ix = 0u; ix < nbrPoints; ++ix)
+            {
+                for (auto iy = 0u; iy < nbrPoints; ++iy)
+                {
+                    auto const row
+                        = ((offset[0] + ix) * blockSize + offset[1] + iy) * blockSize + offset[2];
+                    for (auto iz = 0u; iz < nbrPoints; ++iz)
+                    {
+                        addNode(row + iz, xWeights[ix] * yWeights[iy] * zWeights[iz]);
+                    }
+                }
+            }
+        }
+    }
+
+
+
+
+    //! adds the nodes used by the particles since the last reset() to the grids
+    template<typename Field>
+    void flush(Field& density, Field& xFlux, Field& yFlux, Field& zFlux)
+    {
+        if (lower_[0] > upper_[0])
+        {
+            return;
+        }
+
+        auto addNode = [&](std::size_t iNode, auto... indexes) {
+            auto& node = values_[iNode];
+            density(indexes...) += node[0];
+            xFlux(indexes...) += node[1];
+            yFlux(indexes...) += node[2];
+            zFlux(indexes...) += node[3];
+            node.fill(0.);
+        };
+
+        auto const first = [this](std::size_t iDim) { return lower_[iDim]; };
+        auto const last  = [this](std::size_t iDim) {
+            return upper_[iDim] + static_cast<int>(nbrPoints);
+        };
+
+        if constexpr (dim == 1)
+        {
+            for (auto ix = first(0); ix < last(0); ++ix)
+            {
+                addNode(static_cast<std::size_t>(ix), blockStart_[0] + ix);
+            }
+        }
+        else if constexpr (dim == 2)
+        {
+            for (auto ix = first(0); ix < last(0); ++ix)
+            {
+                for (auto iy = first(1); iy < last(1); ++iy)
+                {
+                    addNode(static_cast<std::size_t>(ix * blockSize + iy), blockStart_[0] + ix,
+                            blockStart_[1] + iy);
+                }
+            }
+        }
+        else
+        {
+            for (auto ix = first(0); ix < last(0); ++ix)
+            {
+                for (auto iy = first(1); iy < last(1); ++iy)
+                {
+                    for (auto iz = first(2); iz < last(2); ++iz)
+                    {
+                        addNode(static_cast<std::size_t>((ix * blockSize + iy) * blockSize + iz),
+                                blockStart_[0] + ix, blockStart_[1] + iy, blockStart_[2] + iz);
+                    }
+                }
+            }
+        }
+    }
+
+
 
 private:
-    GridLayout* layout_;
-    double cellVolumeInverse_ = layout_->inverseMeshSize_[0] * layout_->inverseMeshSize_[1]
-                                * layout_->inverseMeshSize_[2];
+    std::array<int, dim> blockStart_;
+
+    // lowest and highest shift of the start indexes of the particles, per direction
+    std::array<int, dim> lower_;
+    std::array<int, dim> upper_;
+
+    // [node][density, xFlux, yFlux, zFlux]
+    alignas(simdAlignment) std::array<std::array<double, 4>, nbrNodes> values_;
 };
 
 
@@ -447,154 +842,141 @@ public:
      * order InterpOrder and in dimension dim for dual and primal nodes
      *  - then it uses Interpol<> to calculate the interpolation of E and B components
      * onto the particle.
+     *
+     * The fields seen by the i-th particle of the range are written at index i of
+     * emAtParticles, which must hold at least std::distance(begin, end) elements.
      */
     template<typename PartIterator, typename Electromag>
-    inline void operator()(PartIterator begin, PartIterator end, Electromag const& Em)
+    inline void operator()(PartIterator begin, PartIterator end, Electromag const& Em,
+                           ElectromagAtParticles& emAtParticles)
     {
-        // this lambda calculates the startIndex and the nbrPointsSupport() weights for
-        // dual field interpolation and puts this at the corresponding location
-        // in 'startIndex' and 'weights'. For dual fields, the normalizedPosition
-        // is offseted compared to primal ones.
-        auto indexAndWeightDual = [this](auto const& part) {
-            for (auto iDim = 0u; iDim < GridLayout::dimension; ++iDim)
-            {
-                double normalizedPos
-                    = part.iCell[iDim] + part.delta[iDim] + dualOffset(GridLayout::interp_order);
+        gather_(begin, end, Em.E.getComponent(Component::X), Em.E.getComponent(Component::Y),
+                Em.E.getComponent(Component::Z), Em.B.getComponent(Component::X),
+                Em.B.getComponent(Component::Y), Em.B.getComponent(Component::Z), emAtParticles);
+    }
 
-                startIndex_[centering2int(QtyCentering::dual)][iDim]
-                    = computeStartIndex<GridLayout::interp_order>(normalizedPos);
 
-                weightComputer_.computeWeight(normalizedPos,
-                                              startIndex_[centering2int(QtyCentering::dual)][iDim],
-                                              weights_[centering2int(QtyCentering::dual)][iDim]);
-            }
-        };
 
-        // does the same as above but for a primal field
-        auto indexAndWeightPrimal = [this](auto const& part) {
-            for (auto iDim = 0u; iDim < GridLayout::dimension; ++iDim)
-            {
-                double normalizedPos = part.iCell[iDim] + part.delta[iDim];
 
-                startIndex_[centering2int(QtyCentering::primal)][iDim]
-                    = computeStartIndex<GridLayout::interp_order>(normalizedPos);
+    /** @brief same as operator(), the fields being read from a gather cache (see
+     * ElectromagGatherCache) instead of the Electromag. The caller updates the cache from
+     * the fields to interpolate, e.g. once per patch before pushing its particles.
+     */
+    template<typename PartIterator>
+    inline void gather(PartIterator begin, PartIterator end,
+                       ElectromagGatherCache<GridLayout::dimension> const& cache,
+                       ElectromagAtParticles& emAtParticles)
+    {
+        gather_(begin, end, cache.component(0), cache.component(1), cache.component(2),
+                cache.component(3), cache.component(4), cache.component(5), emAtParticles);
+    }
 
-                weightComputer_.computeWeight(
-                    normalizedPos, startIndex_[centering2int(QtyCentering::primal)][iDim],
-                    weights_[centering2int(QtyCentering::primal)][iDim]);
-            }
-        };
 
-        auto const& Ex = Em.E.getComponent(Component::X);
-        auto const& Ey = Em.E.getComponent(Component::Y);
-        auto const& Ez = Em.E.getComponent(Component::Z);
-        auto const& Bx = Em.B.getComponent(Component::X);
-        auto const& By = Em.B.getComponent(Component::Y);
-        auto const& Bz = Em.B.getComponent(Component::Z);
 
-        auto const ExCentering = GridLayout::centering(HybridQuantity::Scalar::Ex);
-        auto const EyCentering = GridLayout::centering(HybridQuantity::Scalar::Ey);
-        auto const EzCentering = GridLayout::centering(HybridQuantity::Scalar::Ez);
-        auto const BxCentering = GridLayout::centering(HybridQuantity::Scalar::Bx);
-        auto const ByCentering = GridLayout::centering(HybridQuantity::Scalar::By);
-        auto const BzCentering = GridLayout::centering(HybridQuantity::Scalar::Bz);
 
-
-        // for each particle, first calculate the startIndex and weights
-        // for dual and primal quantities.
-        // then, knowing the centering (primal or dual) of each electromagnetic
-        // component, we use Interpol to actually perform the interpolation.
-        // the trick here is that the StartIndex and weights have only been calculated
-        // twice, and not for each E,B component.
-        for (auto currPart = begin; currPart != end; ++currPart)
-        {
-            indexAndWeightPrimal(*currPart);
-            indexAndWeightDual(*currPart);
-
-            currPart->Ex = meshToParticle_(Ex, ExCentering, startIndex_, weights_);
-            currPart->Ey = meshToParticle_(Ey, EyCentering, startIndex_, weights_);
-            currPart->Ez = meshToParticle_(Ez, EzCentering, startIndex_, weights_);
-            currPart->Bx = meshToParticle_(Bx, BxCentering, startIndex_, weights_);
-            currPart->By = meshToParticle_(By, ByCentering, startIndex_, weights_);
-            currPart->Bz = meshToParticle_(Bz, BzCentering, startIndex_, weights_);
-        }
+    /**\brief deposits the density and the flux of all particles in the range
+     *
+     * The density and flux are added to the values already in the fields.
+     */
+    template<typename PartIterator, typename VecField>
+    inline void operator()(PartIterator begin, PartIterator end,
+                           typename VecField::field_type& density, VecField& flux)
+    {
+        deposit(begin, end, density, flux.getComponent(Component::X),
+                flux.getComponent(Component::Y), flux.getComponent(Component::Z));
     }
 
 
 
 
-    /**\brief interpolate electromagnetic fields on all particles in the range
+    /** @brief deposits the density and the flux of all particles in the range on grids that
+     * are indexed as the density and flux fields, but need not be Fields (e.g. the private
+     * grids of ParallelDeposit).
      *
-     * For each particle :
-     *  - The function first calculates the startIndex and weights for interpolation at
-     * order InterpOrder and in dimension dim for dual and primal nodes
-     *  - then it uses Interpol<> to calculate the interpolation of E and B components
-     * onto the particle.
+     * Start indexes and weights are computed by batches of particles with WeightBatch,
+     * then each particle is projected with ParticleToMesh.
      */
-    template<typename PartIterator, typename VecField,
-             typename Field = typename VecField::field_type>
-    inline void operator()(PartIterator begin, PartIterator end, Field& density, VecField& flux)
+    template<typename PartIterator, typename Grid>
+    inline void deposit(PartIterator begin, PartIterator end, Grid& density, Grid& xFlux,
+                        Grid& yFlux, Grid& zFlux)
     {
-        // this lambda calculates the startIndex and the order+1 weights for
-        // dual field interpolation and puts this at the corresponding location
-        // in 'startIndex' and 'weights'. For dual fields, the normalizedPosition
-        // is offseted compared to primal ones.
-        auto indexAndWeightDual = [this](auto const& part) {
-            for (auto iDim = 0u; iDim < GridLayout::dimension; ++iDim)
-            {
-                double normalizedPos
-                    = part.iCell[iDim] + part.delta[iDim] + dualOffset(GridLayout::interp_order);
+        // the flux has the same centering as the density
+        auto const centering = GridLayout::centering(HybridQuantity::Scalar::rho);
 
-                startIndex_[centering2int(QtyCentering::dual)][iDim]
-                    = computeStartIndex<GridLayout::interp_order>(normalizedPos);
+        auto const nbrParticles = static_cast<std::size_t>(std::distance(begin, end));
+        auto batchBegin         = begin;
 
-                weightComputer_.computeWeight(normalizedPos,
-                                              startIndex_[centering2int(QtyCentering::dual)][iDim],
-                                              weights_[centering2int(QtyCentering::dual)][iDim]);
-            }
-        };
+        for (std::size_t first = 0; first < nbrParticles; first += weightBatch_.maxSize)
+        {
+            auto batchSize = std::min(weightBatch_.maxSize, nbrParticles - first);
+            auto batchEnd  = std::next(batchBegin, static_cast<std::ptrdiff_t>(batchSize));
+
+            weightBatch_.compute(batchBegin, batchEnd);
 
-        // does the same as above but for a primal field
-        auto indexAndWeightPrimal = [this](auto const& part) {
-            for (auto iDim = 0u; iDim < GridLayout::dimension; ++iDim)
+            auto currPart = batchBegin;
+            for (auto iPart = 0u; iPart < batchSize; ++iPart, ++currPart)
             {
-                double normalizedPos = part.iCell[iDim] + part.delta[iDim];
+                particleToMesh_(density, xFlux, yFlux, zFlux, centering, *currPart,
+                                weightBatch_.startIndexes(iPart), weightBatch_.weights(iPart));
+            }
 
-                startIndex_[centering2int(QtyCentering::primal)][iDim]
-                    = computeStartIndex<GridLayout::interp_order>(normalizedPos);
+            batchBegin = batchEnd;
+        }
+    }
 
-                weightComputer_.computeWeight(
-                    normalizedPos, startIndex_[centering2int(QtyCentering::primal)][iDim],
-                    weights_[centering2int(QtyCentering::primal)][iDim]);
-            }
-        };
 
-        auto& xFlux = flux.getComponent(Component::X);
-        auto& yFlux = flux.getComponent(Component::Y);
-        auto& zFlux = flux.getComponent(Component::Z);
 
-        auto const densityCentering = GridLayout::centering(HybridQuantity::Scalar::rho);
-        auto const xFluxCentering   = GridLayout::centering(HybridQuantity::Scalar::Vx);
-        auto const yFluxCentering   = GridLayout::centering(HybridQuantity::Scalar::Vy);
-        auto const zFluxCentering   = GridLayout::centering(HybridQuantity::Scalar::Vz);
 
+    /** @brief deposits as deposit(), for particles sorted by cell (see CellSorter).
+     *
+     * Consecutive particles of the same cell are summed by a CellAccumulator, which adds its
+     * block of nodes to the grids once per cell instead of once per particle. Particles that
+     * are not sorted are deposited correctly, but without this gain.
+     */
+    template<typename PartIterator, typename Grid>
+    inline void depositByCell(PartIterator begin, PartIterator end, Grid& density, Grid& xFlux,
+                              Grid& yFlux, Grid& zFlux)
+    {
+        auto const centering = GridLayout::centering(HybridQuantity::Scalar::rho);
 
-        // for each particle, first calculate the startIndex and weights
-        // for dual and primal quantities.
-        // then, knowing the centering (primal or dual) of each electromagnetic
-        // component, we use Interpol to actually perform the interpolation.
-        // the trick here is that the StartIndex and weights have only been calculated
-        // twice, and not for each E,B component.
-        for (auto currPart = begin; currPart != end; ++currPart)
+        auto const nbrParticles = static_cast<std::size_t>(std::distance(begin, end));
+        auto batchBegin         = begin;
+
+        if (nbrParticles == 0)
         {
-            indexAndWeightPrimal(*currPart);
-            indexAndWeightDual(*currPart);
+            return;
+        }
+
+        auto currentCell = (*begin).iCell;
+        cellAccumulator_.reset(currentCell, centering);
+
+        for (std::size_t first = 0; first < nbrParticles; first += weightBatch_.maxSize)
+        {
+            auto batchSize = std::min(weightBatch_.maxSize, nbrParticles - first);
+            auto batchEnd  = std::next(batchBegin, static_cast<std::ptrdiff_t>(batchSize));
+
+            weightBatch_.compute(batchBegin, batchEnd);
+
+            auto currPart = batchBegin;
+            for (auto iPart = 0u; iPart < batchSize; ++iPart, ++currPart)
+            {
+                auto const& particle = *currPart;
+                if (particle.iCell != currentCell)
+                {
+                    cellAccumulator_.flush(density, xFlux, yFlux, zFlux);
+
+                    currentCell = particle.iCell;
+                    cellAccumulator_.reset(currentCell, centering);
+                }
 
-            particleToMesh_(density, densityCentering, *currPart, startIndex_, weights_);
-            particleToMesh_(xFlux, xFluxCentering, *currPart, startIndex_, weights_);
-            particleToMesh_(yFlux, yFluxCentering, *currPart, startIndex_, weights_);
-            particleToMesh_(zFlux, zFluxCentering, *currPart, startIndex_, weights_);
+                cellAccumulator_.add(particle, centering, weightBatch_.startIndexes(iPart),
+                                     weightBatch_.weights(iPart));
+            }
+
+            batchBegin = batchEnd;
         }
+
+        cellAccumulator_.flush(density, xFlux, yFlux, zFlux);
     }
 
 
@@ -605,25 +987,63 @@ private:
                       && GridLayout::interp_order >= 1 && GridLayout::interp_order <= 3,
                   "error");
 
-    Weighter<GridLayout::interp_order> weightComputer_;
     MeshToParticle<GridLayout::dimension> meshToParticle_;
+    ParticleToMesh<GridLayout::dimension> particleToMesh_;
 
-    // array[dual/primal][dim]
-    std::array<std::array<int, GridLayout::dimension>, 2> startIndex_;
-    std::array<std::array<std::array<double, nbrPointsSupport(GridLayout::interp_order)>,
-                          GridLayout::dimension>,
-               2>
-        weights_;
+    WeightBatch<GridLayout::dimension, GridLayout::interp_order> weightBatch_;
+    CellAccumulator<GridLayout::dimension, GridLayout::interp_order> cellAccumulator_;
 
-    /**
-     * @brief dualOffset returns the offset by which changing the
-     * startIndex for dual node interpolation. This offset depends on
-     * interpolation order. */
-    inline constexpr double dualOffset(int order)
+    /** interpolates the six components on the particles of the range. Components are
+     * Fields or views of the gather cache, read with the same operator().
+     */
+    template<typename PartIterator, typename FieldT>
+    inline void gather_(PartIterator begin, PartIterator end, FieldT const& Ex, FieldT const& Ey,
+                        FieldT const& Ez, FieldT const& Bx, FieldT const& By, FieldT const& Bz,
+                        ElectromagAtParticles& emAtParticles)
     {
-        std::array<double, 3> offsets = {{-0.5, -0.5, 0.5}};
-        return offsets[static_cast<std::array<double, 3>::size_type>(order - 1)];
+        auto const ExCentering = GridLayout::centering(HybridQuantity::Scalar::Ex);
+        auto const EyCentering = GridLayout::centering(HybridQuantity::Scalar::Ey);
+        auto const EzCentering = GridLayout::centering(HybridQuantity::Scalar::Ez);
+        auto const BxCentering = GridLayout::centering(HybridQuantity::Scalar::Bx);
+        auto const ByCentering = GridLayout::centering(HybridQuantity::Scalar::By);
+        auto const BzCentering = GridLayout::centering(HybridQuantity::Scalar::Bz);
+
+
+        // for each batch of particles, first calculate the startIndex and weights
+        // for dual and primal quantities, for all particles of the batch at once.
+        // then, knowing the centering (primal or dual) of each electromagnetic
+        // component, we use Interpol to actually perform the interpolation.
+        // the trick here is that the StartIndex and weights have only been calculated
+        // twice, and not for each E,B component.
+        auto const nbrParticles = static_cast<std::size_t>(std::distance(begin, end));
+        auto batchBegin         = begin;
+
+        for (std::size_t first = 0; first < nbrParticles; first += weightBatch_.maxSize)
+        {
+            auto batchSize = std::min(weightBatch_.maxSize, nbrParticles - first);
+            auto batchEnd  = std::next(batchBegin, static_cast<std::ptrdiff_t>(batchSize));
+
+            weightBatch_.compute(batchBegin, batchEnd);
+
+            for (auto iPart = 0u; iPart < batchSize; ++iPart)
+            {
+                auto const startIndex = weightBatch_.startIndexes(iPart);
+                auto const weights    = weightBatch_.weights(iPart);
+                auto const i          = first + iPart;
+
+                emAtParticles.Ex[i] = meshToParticle_(Ex, ExCentering, startIndex, weights);
+                emAtParticles.Ey[i] = meshToParticle_(Ey, EyCentering, startIndex, weights);
+                emAtParticles.Ez[i] = meshToParticle_(Ez, EzCentering, startIndex, weights);
+                emAtParticles.Bx[i] = meshToParticle_(Bx, BxCentering, startIndex, weights);
+                emAtParticles.By[i] = meshToParticle_(By, ByCentering, startIndex, weights);
+                emAtParticles.Bz[i] = meshToParticle_(Bz, BzCentering, startIndex, weights);
+            }
+
+            batchBegin = batchEnd;
+        }
     }
+
+
 };
 
 
@@ -0,0 +1,336 @@
+#ifndef PHARE_CORE_NUMERICS_INTERPOLATOR_PARALLEL_DEPOSIT_H
+#define PHARE_CORE_NUMERICS_INTERPOLATOR_PARALLEL_DEPOSIT_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "data/ndarray/ndarray_vector.h"
+#include "data/particles/particle_tiles.h"
+#include "data/vecfield/vecfield_component.h"
+#include "numerics/interpolator/interpolator.h"
+#include "utilities/thread_pool/thread_pool.h"
+
+
+namespace PHARE
+{
+enum class DepositStrategy { Automatic, PrivateGrids, TileColoring };
+
+
+
+/** @brief ParallelDeposit deposits the density and the flux of particles with the threads
+ * of a ThreadPool, without two threads ever adding to the same node at the same time.
+ *
+ * Two strategies are available:
+ *  - PrivateGrids: the particles are cut into nbrSlots() parts, each deposited on its own
+ *    private copy of the density and flux grids. Private grids are then summed two by two
+ *    (slot i + slot i+1, then i + i+2, ...) and the sum is added to the fields.
+ *  - TileColoring: the tiles of a ParticleTiles are deposited directly on the fields, one
+ *    color after the other. Tiles of one color do not share any node, so they are deposited
+ *    concurrently. This needs tiles of at least nbrPointsSupport(interp_order) cells in each
+ *    direction. Particles that left the box of the tiles are deposited last.
+ *
+ * Automatic uses TileColoring for ParticleTiles covering at least tileColoringMinCells()
+ * cells, and PrivateGrids for smaller patches, for which private grids are small and there
+ * are too few tiles of each color to keep the threads busy. Particles that are not in
+ * ParticleTiles are always deposited with PrivateGrids.
+ *
+ * The order in which contributions are summed depends on the particles, on nbrSlots() and on
+ * the strategy, but not on the number of threads nor on the order in which tasks run, so the
+ * deposited fields are the same bit for bit whatever the size of the pool.
+ */
+template<typename GridLayout>
+class ParallelDeposit
+{
+public:
+    static constexpr std::size_t dimension = GridLayout::dimension;
+
+    static constexpr std::size_t defaultNbrSlots             = 8;
+    static constexpr std::size_t defaultTileColoringMinCells = 4096;
+
+    using grid_type = std::conditional_t<
+        dimension == 1, NdArrayVector1D<>,
+        std::conditional_t<dimension == 2, NdArrayVector2D<>, NdArrayVector3D<>>>;
+
+
+    /** a nullptr pool deposits on the calling thread, with the same result as with a pool
+     */
+    explicit ParallelDeposit(std::shared_ptr<ThreadPool> threadPool,
+                             std::size_t nbrSlots = defaultNbrSlots)
+        : threadPool_{std::move(threadPool)}
+        , nbrSlots_{nbrSlots}
+    {
+        if (nbrSlots_ == 0)
+        {
+            throw std::runtime_error("Error - ParallelDeposit needs at least one slot");
+        }
+    }
+
+
+    std::size_t nbrSlots() const { return nbrSlots_; }
+
+    void setStrategy(DepositStrategy strategy) { strategy_ = strategy; }
+
+    DepositStrategy strategy() const { return strategy_; }
+
+    void setTileColoringMinCells(std::size_t nbrCells) { tileColoringMinCells_ = nbrCells; }
+
+    std::size_t tileColoringMinCells() const { return tileColoringMinCells_; }
+
+
+
+
+    //! deposits the particles of the array, with private grids
+    template<typename ParticleArray, typename VecField>
+    void operator()(ParticleArray const& particles, typename VecField::field_type& density,
+                    VecField& flux)
+    {
+        auto fields = fieldsOf_(density, flux);
+
+        depositWithPrivateGrids_(fields, [&](std::size_t iSlot, auto& grids) {
+            auto const nbrParticles = particles.size();
+            auto const first        = iSlot * nbrParticles / nbrSlots_;
+            auto const last         = (iSlot + 1) * nbrParticles / nbrSlots_;
+
+            auto begin = std::next(std::begin(particles), static_cast<std::ptrdiff_t>(first));
+            auto end   = std::next(std::begin(particles), static_cast<std::ptrdiff_t>(last));
+
+            Interpolator<GridLayout> interpolator;
+            interpolator.deposit(begin, end, *grids[0], *grids[1], *grids[2], *grids[3]);
+        });
+    }
+
+
+
+
+    //! deposits the particles of all tiles and the leaving ones, see DepositStrategy
+    template<typename ParticleArray, typename VecField>
+    void operator()(ParticleTiles<ParticleArray> const& tiles,
+                    typename VecField::field_type& density, VecField& flux)
+    {
+        auto fields = fieldsOf_(density, flux);
+
+        if (useTileColoring_(tiles))
+        {
+            depositWithTileColoring_(tiles, fields);
+        }
+        else
+        {
+            // slot i deposits the tiles i, i + nbrSlots, i + 2 nbrSlots, ...
+            depositWithPrivateGrids_(fields, [&](std::size_t iSlot, auto& grids) {
+                Interpolator<GridLayout> interpolator;
+                for (auto iTile = iSlot; iTile < tiles.nbrTiles(); iTile += nbrSlots_)
+                {
+                    auto const& tile = tiles.tile(iTile);
+                    interpolator.deposit(std::begin(tile), std::end(tile), *grids[0],
+                                         *grids[1], *grids[2], *grids[3]);
+                }
+            });
+        }
+
+        auto const& leaving = tiles.leaving();
+
+        Interpolator<GridLayout> interpolator;
+        interpolator.deposit(std::begin(leaving), std::end(leaving), *fields[0], *fields[1],
+                             *fields[2], *fields[3]);
+    }
+
+
+
+
+private:
+    //! density, xFlux, yFlux and zFlux
+    static constexpr std::size_t nbrQuantities = 4;
+
+    template<typename Grid>
+    using Quantities = std::array<Grid*, nbrQuantities>;
+
+
+    template<typename VecField>
+    static auto fieldsOf_(typename VecField::field_type& density, VecField& flux)
+    {
+        return Quantities<typename VecField::field_type>{
+            {&density, &flux.getComponent(Component::X), &flux.getComponent(Component::Y),
+             &flux.getComponent(Component::Z)}};
+    }
+
+
+    template<typename Task>
+    void parallelFor_(std::size_t nbrTasks, Task&& task)
+    {
+        if (threadPool_)
+        {
+            threadPool_->parallelFor(nbrTasks, std::forward<Task>(task));
+        }
+        else
+        {
+            for (auto iTask = 0u; iTask < nbrTasks; ++iTask)
+            {
+                task(iTask);
+            }
+        }
+    }
+
+
+
+
+    template<typename ParticleArray>
+    bool useTileColoring_(ParticleTiles<ParticleArray> const& tiles) const
+    {
+        bool const tilesAreLargeEnough = std::all_of(
+            std::begin(tiles.tileShape()), std::end(tiles.tileShape()), [](int tileSize) {
+                return tileSize >= static_cast<int>(nbrPointsSupport(GridLayout::interp_order));
+            });
+
+        if (strategy_ == DepositStrategy::TileColoring && !tilesAreLargeEnough)
+        {
+            throw std::runtime_error("Error - tiles are too small to be deposited concurrently");
+        }
+
+        if (strategy_ != DepositStrategy::Automatic)
+        {
+            return strategy_ == DepositStrategy::TileColoring;
+        }
+
+        std::size_t nbrCells = 1;
+        for (auto iDim = 0u; iDim < dimension; ++iDim)
+        {
+            auto const& box = tiles.cellBox();
+            nbrCells *= static_cast<std::size_t>(std::max(0, box.upper[iDim] - box.lower[iDim]));
+        }
+
+        return tilesAreLargeEnough && nbrCells >= tileColoringMinCells_;
+    }
+
+
+
+
+    template<typename ParticleArray, typename Field>
+    void depositWithTileColoring_(ParticleTiles<ParticleArray> const& tiles,
+                                  Quantities<Field> const& fields)
+    {
+        using Tiles = ParticleTiles<ParticleArray>;
+
+        std::array<std::vector<std::size_t>, Tiles::nbrColors> tilesOfColor;
+        for (auto iTile = 0u; iTile < tiles.nbrTiles(); ++iTile)
+        {
+            tilesOfColor[tiles.colorOf(iTile)].push_back(iTile);
+        }
+
+        for (auto const& tileIndexes : tilesOfColor)
+        {
+            parallelFor_(tileIndexes.size(), [&](std::size_t iTask) {
+                auto const& tile = tiles.tile(tileIndexes[iTask]);
+
+                Interpolator<GridLayout> interpolator;
+                interpolator.deposit(std::begin(tile), std::end(tile), *fields[0], *fields[1],
+                                     *fields[2], *fields[3]);
+            });
+        }
+    }
+
+
+
+
+    /** calls depositSlot(iSlot, grids) for each slot, grids being the private grids of the
+     * slot, set to zero, then reduces the private grids and adds them to the fields
+     */
+    template<typename Field, typename DepositSlot>
+    void depositWithPrivateGrids_(Quantities<Field> const& fields, DepositSlot&& depositSlot)
+    {
+        allocatePrivateGrids_(fields);
+
+        parallelFor_(nbrSlots_, [&](std::size_t iSlot) {
+            Quantities<grid_type> grids;
+            for (auto iQty = 0u; iQty < nbrQuantities; ++iQty)
+            {
+                grids[iQty] = &privateGrid_(iSlot, iQty);
+                grids[iQty]->zero();
+            }
+            depositSlot(iSlot, grids);
+        });
+
+
+        // tree reduction, in a fixed order. Each task sums one quantity of two slots
+        for (std::size_t stride = 1; stride < nbrSlots_; stride *= 2)
+        {
+            auto const nbrPairs = (nbrSlots_ + 2 * stride - 1) / (2 * stride);
+
+            parallelFor_(nbrPairs * nbrQuantities, [&](std::size_t iTask) {
+                auto const iSlot = 2 * stride * (iTask / nbrQuantities);
+                auto const iQty  = iTask % nbrQuantities;
+
+                if (iSlot + stride < nbrSlots_)
+                {
+                    addTo_(privateGrid_(iSlot, iQty), privateGrid_(iSlot + stride, iQty));
+                }
+            });
+        }
+
+        parallelFor_(nbrQuantities,
+                     [&](std::size_t iQty) { addTo_(*fields[iQty], privateGrid_(0, iQty)); });
+    }
+
+
+
+
+    //! private grids are kept from one deposit to the next while the fields keep their shape
+    template<typename Field>
+    void allocatePrivateGrids_(Quantities<Field> const& fields)
+    {
+        bool sameShapes = privateGrids_.size() == nbrSlots_ * nbrQuantities;
+        for (auto iQty = 0u; sameShapes && iQty < nbrQuantities; ++iQty)
+        {
+            sameShapes = privateGrid_(0, iQty).shape() == fields[iQty]->shape();
+        }
+
+        if (!sameShapes)
+        {
+            privateGrids_.clear();
+            privateGrids_.reserve(nbrSlots_ * nbrQuantities);
+            for (auto iSlot = 0u; iSlot < nbrSlots_; ++iSlot)
+            {
+                for (auto iQty = 0u; iQty < nbrQuantities; ++iQty)
+                {
+                    privateGrids_.emplace_back(fields[iQty]->shape());
+                }
+            }
+        }
+    }
+
+
+    grid_type& privateGrid_(std::size_t iSlot, std::size_t iQty)
+    {
+        return privateGrids_[iSlot * nbrQuantities + iQty];
+    }
+
+
+    template<typename Grid, typename OtherGrid>
+    static void addTo_(Grid& grid, OtherGrid const& other)
+    {
+        std::transform(std::begin(grid), std::end(grid), std::begin(other), std::begin(grid),
+                       std::plus<double>{});
+    }
+
+
+
+
+    std::shared_ptr<ThreadPool> threadPool_;
+    std::size_t nbrSlots_;
+    DepositStrategy strategy_{DepositStrategy::Automatic};
+    std::size_t tileColoringMinCells_{defaultTileColoringMinCells};
+
+    // [slot][quantity], flattened
+    std::vector<grid_type> privateGrids_;
+};
+
+
+} // namespace PHARE
+
+#endif
@@ -0,0 +1,177 @@
+#ifndef PHARE_CORE_NUMERICS_MOMENTS_MOMENTS_H
+#define PHARE_CORE_NUMERICS_MOMENTS_MOMENTS_H
+
+#include <cstddef>
+#include <iterator>
+
+#include "data/vecfield/vecfield_component.h"
+#include "numerics/interpolator/interpolator.h"
+#include "utilities/types.h"
+
+
+namespace PHARE
+{
+/** @brief PopulationAndTotal is a grid whose nodes add what is deposited on them to the
+ * moment of a population and to the moment of all populations, so that depositing the
+ * particles of a population once computes both. It is indexed as the fields it refers to.
+ */
+template<typename Field>
+class PopulationAndTotal
+{
+public:
+    using data_type = typename Field::type;
+
+    struct Node
+    {
+        void operator+=(data_type value)
+        {
+            population += value;
+            total += value;
+        }
+
+        data_type& population;
+        data_type& total;
+    };
+
+
+    PopulationAndTotal(Field& population, Field& total)
+        : population_{population}
+        , total_{total}
+    {
+    }
+
+
+    template<typename... Indexes>
+    Node operator()(Indexes... indexes)
+    {
+        return Node{population_(indexes...), total_(indexes...)};
+    }
+
+
+private:
+    Field& population_;
+    Field& total_;
+};
+
+
+
+
+/** @brief IonMoments computes the density and flux of the ion populations, and the
+ * density and total flux of the ions, with one deposit of the particles per population.
+ *
+ * Particles of a population that is not subcycled are deposited on PopulationAndTotal
+ * grids, so that the particle loop adds to the moments of the population and to the total
+ * ones at the same time. The bulk velocity is not computed here: the moments on the ghost
+ * nodes are only complete once they have been filled, after which Ions::computeBulkVelocity()
+ * divides the total flux by the density.
+ *
+ * Subcycled populations are only deposited at the steps they are pushed (see
+ * IonPopulation::isPushedAt), and their time interpolated moments are added to the total
+ * ones with IonPopulation::addDensityAt and IonPopulation::addFluxAt.
+ *
+ * The domain, ghost and coarse to fine particles of a population are deposited.
+ */
+template<typename GridLayout>
+class IonMoments
+{
+public:
+    /** @brief computes the moments at the end of the given step of the level, see
+     * IonPopulation::isPushedAt. Subcycled populations must have saved their moments before
+     * being pushed at this step.
+     */
+    template<typename Ions>
+    void operator()(Ions& ions, uint32 step = 0)
+    {
+        auto& rho  = ions.density();
+        auto& flux = ions.flux();
+
+        rho.zero();
+        for (auto component : {Component::X, Component::Y, Component::Z})
+        {
+            flux.getComponent(component).zero();
+        }
+
+        for (auto& pop : ions)
+        {
+            if (!pop.isSubcycled())
+            {
+                depositOnPopulationAndTotal_(pop, rho, flux);
+            }
+            else
+            {
+                if (pop.isPushedAt(step))
+                {
+                    depositOnPopulation_(pop);
+                }
+                pop.addDensityAt(step, rho);
+                pop.addFluxAt(step, flux);
+            }
+        }
+    }
+
+
+
+
+private:
+    template<typename Population, typename Field, typename VecField>
+    void depositOnPopulationAndTotal_(Population& pop, Field& rho, VecField& flux)
+    {
+        zero_(pop);
+
+        auto& popFlux = pop.flux();
+
+        PopulationAndTotal<Field> density{pop.density(), rho};
+        PopulationAndTotal<Field> xFlux{popFlux.getComponent(Component::X),
+                                        flux.getComponent(Component::X)};
+        PopulationAndTotal<Field> yFlux{popFlux.getComponent(Component::Y),
+                                        flux.getComponent(Component::Y)};
+        PopulationAndTotal<Field> zFlux{popFlux.getComponent(Component::Z),
+                                        flux.getComponent(Component::Z)};
+
+        for (auto particles : {&pop.domainParticles(), &pop.ghostParticles(),
+                               &pop.coarseToFineParticles()})
+        {
+            interpolator_.deposit(std::begin(*particles), std::end(*particles), density, xFlux,
+                                  yFlux, zFlux);
+        }
+    }
+
+
+
+
+    template<typename Population>
+    void depositOnPopulation_(Population& pop)
+    {
+        zero_(pop);
+
+        for (auto particles : {&pop.domainParticles(), &pop.ghostParticles(),
+                               &pop.coarseToFineParticles()})
+        {
+            interpolator_(std::begin(*particles), std::end(*particles), pop.density(),
+                          pop.flux());
+        }
+    }
+
+
+
+
+    template<typename Population>
+    static void zero_(Population& pop)
+    {
+        pop.density().zero();
+        for (auto component : {Component::X, Component::Y, Component::Z})
+        {
+            pop.flux().getComponent(component).zero();
+        }
+    }
+
+
+
+
+    Interpolator<GridLayout> interpolator_;
+};
+
+
+} // namespace PHARE
+
+#endif
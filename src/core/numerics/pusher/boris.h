@@ -1,15 +1,35 @@
 #ifndef PHARE_CORE_PUSHER_BORIS_H
 #define PHARE_CORE_PUSHER_BORIS_H
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
 
+#include "data/electromag/electromag_at_particles.h"
+#include "data/particles/particle_array.h"
+#include "numerics/pusher/boris_kernel.h"
 #include "numerics/pusher/pusher.h"
 #include "utilities/range/range.h"
+#include "utilities/thread_pool/thread_pool.h"
 
 namespace PHARE
 {
+/** @brief tells how the pusher puts the leaving particles at the end of the output range
+ *
+ * - Swap: a leaving particle is swapped with the last particle of the range. This is done in
+ * place but the order of the staying particles is not kept.
+ * - Stable: staying particles are compacted in their order and leaving particles, buffered
+ * by the pusher, are copied after them, also in their order. Particles sorted by cell
+ * before the push thus stay (almost) sorted after it.
+ */
+enum class PartitionStrategy { Swap, Stable };
+
+
+
 template<std::size_t dim, typename ParticleIterator, typename Electromag, typename Interpolator,
          typename ParticleSelector, typename BoundaryCondition>
 class BorisPusher : public Pusher<dim, ParticleIterator, Electromag, Interpolator, ParticleSelector,
@@ -18,17 +38,35 @@ class BorisPusher : public Pusher<dim, ParticleIterator, Electromag, Interpolato
 public:
     using ParticleRange = Range<ParticleIterator>;
 
+
+    explicit BorisPusher(PartitionStrategy partitionStrategy = PartitionStrategy::Swap)
+        : partitionStrategy_{partitionStrategy}
+    {
+    }
+
     /** see Pusher::move() domentation*/
     virtual ParticleIterator move(ParticleRange const& rangeIn, ParticleRange& rangeOut,
-                                  Electromag const& emFields, double mass,
+                                  Electromag const& emFields, double mass, double charge,
                                   Interpolator& interpolator,
                                   ParticleSelector const& particleIsNotLeaving,
                                   BoundaryCondition& bc) override
     {
+        if (fused_ || threadPool_)
+        {
+            auto newEnd = chunkedMove_(rangeIn, rangeOut, emFields, mass, charge, interpolator,
+                                       particleIsNotLeaving, [&bc](auto firstLeaving, auto end) {
+                                           return bc.applyOutgoingParticleBC(firstLeaving, end);
+                                       });
+            rangeOut = makeRange(rangeOut.begin(), std::move(newEnd));
+            return rangeOut.end();
+        }
+
+        auto& workspace = workspaces_[0];
+
         // push the particles of half a step
         // rangeIn : t=n, rangeOut : t=n+1/Z
         // get a pointer on the first particle of rangeOut that leaves the patch
-        auto firstLeaving = pushStep_(rangeIn, rangeOut, particleIsNotLeaving);
+        auto firstLeaving = pushStep_(workspace, rangeIn, rangeOut, particleIsNotLeaving);
 
         // apply boundary condition on the particles in [firstLeaving, rangeOut.end[
         // that actually leave through a physical boundary condition
@@ -40,15 +78,12 @@ public:
         rangeOut = makeRange(rangeOut.begin(), std::move(newEnd));
 
         // get electromagnetic fields interpolated on the particles of rangeOut
-        // stop at newEnd.
-        interpolator(rangeOut.begin(), rangeOut.end(), emFields);
-
-        // get the particle velocity from t=n to t=n+1
-        accelerate_(rangeOut, rangeOut, mass);
+        // stop at newEnd, and get the particle velocity from t=n to t=n+1
+        interpolateAndAccelerate_(workspace, rangeOut, emFields, mass, charge, interpolator);
 
         // now advance the particles from t=n+1/2 to t=n+1 using v_{n+1} just calculated
         // and get a pointer to the first leaving particle
-        firstLeaving = pushStep_(rangeOut, rangeOut, particleIsNotLeaving);
+        firstLeaving = pushStep_(workspace, rangeOut, rangeOut, particleIsNotLeaving);
 
         // apply BC on the leaving particles that leave through physical BC
         // and get pointer on new End, discarding particles leaving elsewhere
@@ -63,26 +98,34 @@ public:
     /** see Pusher::move() domentation*/
     virtual decltype(std::declval<ParticleRange>().end())
     move(ParticleRange const& rangeIn, ParticleRange& rangeOut, Electromag const& emFields,
-         double mass, Interpolator& interpolator,
+         double mass, double charge, Interpolator& interpolator,
          ParticleSelector const& particleIsNotLeaving) override
     {
+        if (fused_ || threadPool_)
+        {
+            auto newEnd = chunkedMove_(rangeIn, rangeOut, emFields, mass, charge, interpolator,
+                                       particleIsNotLeaving,
+                                       [](auto firstLeaving, auto) { return firstLeaving; });
+            rangeOut = makeRange(rangeOut.begin(), std::move(newEnd));
+            return rangeOut.end();
+        }
+
+        auto& workspace = workspaces_[0];
+
         // push the particles of half a step
         // rangeIn : t=n, rangeOut : t=n+1/Z
         // get a pointer on the first particle of rangeOut that leaves the patch
-        auto firstLeaving = pushStep_(rangeIn, rangeOut, particleIsNotLeaving);
+        auto firstLeaving = pushStep_(workspace, rangeIn, rangeOut, particleIsNotLeaving);
 
         rangeOut = makeRange(rangeOut.begin(), std::move(firstLeaving));
 
         // get electromagnetic fields interpolated on the particles of rangeOut
-        // stop at newEnd.
-        interpolator(rangeOut.begin(), rangeOut.end(), emFields);
-
-        // get the particle velocity from t=n to t=n+1
-        accelerate_(rangeOut, rangeOut, mass);
+        // stop at newEnd, and get the particle velocity from t=n to t=n+1
+        interpolateAndAccelerate_(workspace, rangeOut, emFields, mass, charge, interpolator);
 
         // now advance the particles from t=n+1/2 to t=n+1 using v_{n+1} just calculated
         // and get a pointer to the first leaving particle
-        firstLeaving = pushStep_(rangeOut, rangeOut, particleIsNotLeaving);
+        firstLeaving = pushStep_(workspace, rangeOut, rangeOut, particleIsNotLeaving);
 
         rangeOut = makeRange(rangeOut.begin(), std::move(firstLeaving));
 
@@ -99,12 +142,65 @@ public:
     }
 
 
+    void setPartitionStrategy(PartitionStrategy strategy) { partitionStrategy_ = strategy; }
+
+    PartitionStrategy partitionStrategy() const { return partitionStrategy_; }
+
+
+    /** in fused mode, move() does all the steps of the push on a chunk of fusedChunkSize
+     * particles before going to the next chunk, instead of doing each step on the whole
+     * range, so that particles are read from memory once per push instead of four times.
+     */
+    void setFused(bool fused) { fused_ = fused; }
+
+    bool isFused() const { return fused_; }
+
+
+    /** with a pool of more than one thread, move() cuts the range of particles into one
+     * contiguous part per thread and the threads push their parts in fused mode, see
+     * threadedMove_(). The pool can be shared with other pushers. nullptr (the default)
+     * makes move() run on the calling thread only.
+     */
+    void setThreadPool(std::shared_ptr<ThreadPool> threadPool)
+    {
+        threadPool_ = std::move(threadPool);
+    }
+
+
 
 private:
+    using particle_type = typename std::iterator_traits<ParticleIterator>::value_type;
+
+    //! number of particles interpolated and accelerated at once
+    static constexpr std::size_t particleChunkSize = 1024;
+
+    //! number of particles pushed at once in fused mode, so that they fit in the L1 cache
+    static constexpr std::size_t fusedChunkSize = 256;
+
+    //! buffers used while pushing particles, one per thread pushing them
+    struct Workspace
+    {
+        ElectromagAtParticles emAtParticles{particleChunkSize};
+        std::vector<particle_type> leavingParticles;
+        std::vector<particle_type> discardedParticles;
+        std::vector<particle_type> keptParticles;
+    };
+
+    //! indexes of the particles pushed by one thread, and where they go (see threadedMove_)
+    struct ThreadPart
+    {
+        std::size_t begin, end;
+        std::size_t nbrKept, keptOffset, discardedOffset;
+        std::size_t nbrHoles, holeOffset, nbrSources, sourceOffset;
+    };
+
+
+
     /** move the particle partIn of half a time step and store it in partOut
+     * partOut can be a ParticleProxy obtained by dereferencing a ParticleArray::iterator
      */
-    template<typename ParticleIter>
-    void advancePosition_(ParticleIter const& partIn, ParticleIter& partOut)
+    template<typename ParticleIn, typename ParticleOut>
+    void advancePosition_(ParticleIn const& partIn, ParticleOut&& partOut)
     {
         // push the particle
         for (std::size_t iDim = 0; iDim < dim; ++iDim)
@@ -126,36 +222,47 @@ private:
      * detected by the ParticleSelector
      */
     template<typename ParticleRangeIn, typename ParticleRangeOut>
-    auto pushStep_(ParticleRangeIn const& rangeIn, ParticleRangeOut& rangeOut,
-                   ParticleSelector const& particleIsNotLeaving)
+    auto pushStep_(Workspace& workspace, ParticleRangeIn const& rangeIn,
+                   ParticleRangeOut& rangeOut, ParticleSelector const& particleIsNotLeaving)
     {
-        auto swapee = rangeOut.end();
-        --swapee;
-        auto newEnd = rangeOut.end();
+        if (partitionStrategy_ == PartitionStrategy::Stable)
+        {
+            return stablePushStep_(workspace, rangeIn, rangeOut, particleIsNotLeaving);
+        }
 
+        auto currentIn  = rangeIn.begin();
         auto currentOut = rangeOut.begin();
+        auto newEnd     = rangeOut.end();
 
-        for (auto currentIn : rangeIn)
+        // true when the particle in currentOut has been swapped from the end of the range
+        // it has not been pushed yet and is not the one currentIn points to
+        bool swappedIn = false;
+
+        while (currentOut != newEnd)
         {
             // push the particle
-            advancePosition_(currentIn, *currentOut);
+            if (swappedIn)
+            {
+                advancePosition_(*currentOut, *currentOut);
+            }
+            else
+            {
+                advancePosition_(*currentIn, *currentOut);
+            }
 
             if (particleIsNotLeaving(*currentOut))
             {
-                // we advance the output iterator
-                // only if currentOut has not been
-                // swapped
                 ++currentOut;
+                ++currentIn;
+                swappedIn = false;
             }
             else
             {
-                // if the particle satisfies the predicate
-                // swap it with the swapee
-                // and decrement the swapee
-
-                std::swap(*currentOut, *swapee);
+                // the leaving particle goes at the end of the range, and the last
+                // particle not pushed yet takes its place, to be pushed at the next iteration
                 --newEnd;
-                --swapee;
+                std::iter_swap(currentOut, newEnd);
+                swappedIn = true;
             }
         }
 
@@ -169,31 +276,337 @@ private:
 
 
 
-    /** Accelerate the particles in rangeIn and put the new velocity in rangeOut
+    /** same as pushStep_ but staying particles keep their relative order in rangeOut,
+     * and so do leaving particles, found after them. rangeIn and rangeOut can be the
+     * same range since a staying particle is never written after the one being read.
      */
     template<typename ParticleRangeIn, typename ParticleRangeOut>
-    void accelerate_(ParticleRangeIn inputParticles, ParticleRangeOut outputParticles, double mass)
+    auto stablePushStep_(Workspace& workspace, ParticleRangeIn const& rangeIn,
+                         ParticleRangeOut& rangeOut, ParticleSelector const& particleIsNotLeaving)
     {
-        double dto2m = 0.5 * dt_ / mass;
+        workspace.leavingParticles.clear();
 
-        auto currentOut = outputParticles.begin();
+        auto currentOut = rangeOut.begin();
 
-        for (auto const& currentIn : inputParticles)
+        for (auto currentIn : rangeIn)
         {
-            double coef1 = currentIn.charge * dto2m;
+            // the particle is copied since currentOut may not be the same particle
+            // as currentIn once some particles have left
+            particle_type particle = currentIn;
+            advancePosition_(particle, particle);
 
+            if (particleIsNotLeaving(particle))
+            {
+                *currentOut = particle;
+                ++currentOut;
+            }
+            else
+            {
+                workspace.leavingParticles.push_back(particle);
+            }
+        }
+
+        std::copy(std::begin(workspace.leavingParticles), std::end(workspace.leavingParticles),
+                  currentOut);
+
+        return currentOut;
+    }
+
+
+
+
+    //! pushes the particles with the thread pool if there is one, in fused mode otherwise
+    template<typename KeepLeaving>
+    ParticleIterator chunkedMove_(ParticleRange const& rangeIn, ParticleRange const& rangeOut,
+                                  Electromag const& emFields, double mass, double charge,
+                                  Interpolator& interpolator,
+                                  ParticleSelector const& particleIsNotLeaving,
+                                  KeepLeaving&& keepLeaving)
+    {
+        if (threadPool_ && threadPool_->size() > 1)
+        {
+            return threadedMove_(rangeIn, rangeOut, emFields, mass, charge, interpolator,
+                                 particleIsNotLeaving, keepLeaving);
+        }
+        return fusedMove_(workspaces_[0], rangeIn, rangeOut, emFields, mass, charge, interpolator,
+                          particleIsNotLeaving, keepLeaving);
+    }
+
+
+
+
+    /** threaded version of move(). rangeIn is cut into one contiguous part per thread and
+     * each thread pushes its part with fusedMove_(), its own workspace and its own copy of
+     * the interpolator. Each part of rangeOut then has its kept particles followed by its
+     * discarded ones. An exclusive prefix sum over the numbers of kept and discarded
+     * particles of the parts tells where they go:
+     * - with PartitionStrategy::Stable, the kept particles of each part are moved right after
+     *   those of the previous parts. They are first copied in the workspace of the part, so
+     *   that no thread overwrites particles another thread has not copied yet.
+     * - with PartitionStrategy::Swap, only the holes left by discarded particles before the
+     *   total number of kept particles are filled, with the kept particles found after it.
+     *   Only as many particles as there are discarded ones move, but not in order.
+     *
+     * Discarded particles are then copied after all kept particles. Each of these steps
+     * is done by all threads, on different particles.
+     */
+    template<typename KeepLeaving>
+    ParticleIterator threadedMove_(ParticleRange const& rangeIn, ParticleRange const& rangeOut,
+                                   Electromag const& emFields, double mass, double charge,
+                                   Interpolator& interpolator,
+                                   ParticleSelector const& particleIsNotLeaving,
+                                   KeepLeaving&& keepLeaving)
+    {
+        auto const nbrParticles = rangeIn.size();
+        auto const nbrParts     = std::max(
+            std::size_t{1}, std::min(threadPool_->size(), nbrParticles / fusedChunkSize));
+
+        if (workspaces_.size() < nbrParts)
+        {
+            workspaces_.resize(nbrParts);
+        }
+        threadParts_.resize(nbrParts);
+
+        for (auto iPart = 0u; iPart < nbrParts; ++iPart)
+        {
+            threadParts_[iPart].begin = iPart * nbrParticles / nbrParts;
+            threadParts_[iPart].end   = (iPart + 1) * nbrParticles / nbrParts;
+        }
+
+        auto const in  = rangeIn.begin();
+        auto const out = rangeOut.begin();
+        auto at        = [](ParticleIterator it, std::size_t index) {
+            return std::next(it, static_cast<std::ptrdiff_t>(index));
+        };
+
+        threadPool_->parallelFor(nbrParts, [&](std::size_t iPart) {
+            auto& part                      = threadParts_[iPart];
+            Interpolator threadInterpolator = interpolator;
+
+            ParticleRange partIn{at(in, part.begin), at(in, part.end)};
+            ParticleRange partOut{at(out, part.begin), at(out, part.end)};
+
+            auto keptEnd = fusedMove_(workspaces_[iPart], partIn, partOut, emFields, mass, charge,
+                                      threadInterpolator, particleIsNotLeaving, keepLeaving);
+
+            part.nbrKept = static_cast<std::size_t>(std::distance(at(out, part.begin), keptEnd));
+        });
+
+
+        std::size_t nbrKept      = 0;
+        std::size_t nbrDiscarded = 0;
+        for (auto& part : threadParts_)
+        {
+            part.keptOffset      = nbrKept;
+            part.discardedOffset = nbrDiscarded;
+            nbrKept += part.nbrKept;
+            nbrDiscarded += part.end - part.begin - part.nbrKept;
+        }
+
+
+        if (partitionStrategy_ == PartitionStrategy::Stable)
+        {
+            threadPool_->parallelFor(nbrParts, [&](std::size_t iPart) {
+                auto& part = threadParts_[iPart];
+                if (part.keptOffset != part.begin)
+                {
+                    workspaces_[iPart].keptParticles.assign(at(out, part.begin),
+                                                            at(out, part.begin + part.nbrKept));
+                }
+            });
+
+            threadPool_->parallelFor(nbrParts, [&](std::size_t iPart) {
+                auto& part = threadParts_[iPart];
+                auto& kept = workspaces_[iPart].keptParticles;
+                if (part.keptOffset != part.begin)
+                {
+                    std::copy(std::begin(kept), std::end(kept), at(out, part.keptOffset));
+                }
+            });
+        }
+        else
+        {
+            // holes are the discarded particles found before nbrKept, sources the kept
+            // particles found after it, there are as many of each
+            std::size_t nbrHoles   = 0;
+            std::size_t nbrSources = 0;
+            for (auto& part : threadParts_)
+            {
+                auto const keptEnd = part.begin + part.nbrKept;
+
+                part.holeOffset   = nbrHoles;
+                part.sourceOffset = nbrSources;
+                part.nbrHoles     = keptEnd < nbrKept ? std::min(part.end, nbrKept) - keptEnd : 0;
+                part.nbrSources   = keptEnd > nbrKept ? keptEnd - std::max(part.begin, nbrKept) : 0;
+                nbrHoles += part.nbrHoles;
+                nbrSources += part.nbrSources;
+            }
+
+            threadPool_->parallelFor(nbrParts, [&](std::size_t iPart) {
+                auto const& part    = threadParts_[iPart];
+                std::size_t iSource = 0;
+
+                for (auto iHole = 0u; iHole < part.nbrHoles; ++iHole)
+                {
+                    // the i-th hole of all parts gets the i-th source of all parts
+                    auto const rank = part.holeOffset + iHole;
+                    while (rank >= threadParts_[iSource].sourceOffset
+                                       + threadParts_[iSource].nbrSources)
+                    {
+                        ++iSource;
+                    }
+                    auto const& sourcePart = threadParts_[iSource];
+                    auto const source
+                        = std::max(sourcePart.begin, nbrKept) + rank - sourcePart.sourceOffset;
+
+                    *at(out, part.begin + part.nbrKept + iHole) = *at(out, source);
+                }
+            });
+        }
+
+
+        threadPool_->parallelFor(nbrParts, [&](std::size_t iPart) {
+            auto const& discarded = workspaces_[iPart].discardedParticles;
+            std::copy(std::begin(discarded), std::end(discarded),
+                      at(out, nbrKept + threadParts_[iPart].discardedOffset));
+        });
+
+        return at(out, nbrKept);
+    }
+
+
+
+
+    /** fused version of move(). Each chunk of rangeIn is pushed of half a step, partitioned,
+     * interpolated, accelerated, pushed of another half step and partitioned again while it
+     * is in the cache. keepLeaving(firstLeaving, end) returns the end of the particles to keep
+     * among the leaving ones of the chunk (see BoundaryCondition::applyOutgoingParticleBC).
+     *
+     * The particles kept from each chunk are then compacted right after those of the previous
+     * chunks, and the others are buffered and copied after all kept particles. Chunks being
+     * processed in order, kept particles are found in the same order as with move().
+     * @return the end of the kept particles
+     */
+    template<typename KeepLeaving>
+    ParticleIterator fusedMove_(Workspace& workspace, ParticleRange const& rangeIn,
+                                ParticleRange const& rangeOut, Electromag const& emFields,
+                                double mass, double charge, Interpolator& interpolator,
+                                ParticleSelector const& particleIsNotLeaving,
+                                KeepLeaving&& keepLeaving)
+    {
+        workspace.discardedParticles.clear();
+
+        auto newEnd     = rangeOut.begin();
+        auto chunkBegin = rangeIn.begin();
+        auto chunkOut   = rangeOut.begin();
+
+        while (chunkBegin != rangeIn.end())
+        {
+            auto chunkSize = std::min(static_cast<std::ptrdiff_t>(fusedChunkSize),
+                                      std::distance(chunkBegin, rangeIn.end()));
+            auto chunkEnd    = std::next(chunkBegin, chunkSize);
+            auto chunkOutEnd = std::next(chunkOut, chunkSize);
+
+            ParticleRange chunkIn{chunkBegin, chunkEnd};
+            ParticleRange kept{chunkOut, chunkOutEnd};
+
+            auto firstLeaving = pushStep_(workspace, chunkIn, kept, particleIsNotLeaving);
+            kept              = ParticleRange{chunkOut, keepLeaving(firstLeaving, chunkOutEnd)};
+
+            interpolateAndAccelerate_(workspace, kept, emFields, mass, charge, interpolator);
+
+            firstLeaving = pushStep_(workspace, kept, kept, particleIsNotLeaving);
+            kept         = ParticleRange{chunkOut, keepLeaving(firstLeaving, kept.end())};
+
+            for (auto discarded = kept.end(); discarded != chunkOutEnd; ++discarded)
+            {
+                workspace.discardedParticles.push_back(*discarded);
+            }
+
+            // kept particles only move if some particles of the previous chunks were discarded
+            // in which case newEnd is before chunkOut and the copy does not overlap its source
+            newEnd = newEnd == chunkOut ? kept.end() : std::copy(kept.begin(), kept.end(), newEnd);
+
+            chunkBegin = chunkEnd;
+            chunkOut   = chunkOutEnd;
+        }
+
+        std::copy(std::begin(workspace.discardedParticles), std::end(workspace.discardedParticles),
+                  newEnd);
+
+        return newEnd;
+    }
+
+
+
+
+    /** interpolate the electromagnetic fields on the particles of the range and
+     * update their velocity, chunk by chunk. The fields seen by the particles of a
+     * chunk are stored in the workspace only the time it takes to accelerate them.
+     */
+    void interpolateAndAccelerate_(Workspace& workspace, ParticleRange const& range,
+                                   Electromag const& emFields, double mass, double charge,
+                                   Interpolator& interpolator)
+    {
+        auto chunkBegin = range.begin();
+
+        while (chunkBegin != range.end())
+        {
+            auto chunkSize = std::min(static_cast<std::ptrdiff_t>(particleChunkSize),
+                                      std::distance(chunkBegin, range.end()));
+            auto chunkEnd  = std::next(chunkBegin, chunkSize);
+
+            interpolator(chunkBegin, chunkEnd, emFields, workspace.emAtParticles);
+            accelerate_(workspace, ParticleRange{chunkBegin, chunkEnd}, mass, charge);
+
+            chunkBegin = chunkEnd;
+        }
+    }
+
+
+
+
+    /** Accelerate the particles in the range using the fields stored in the workspace
+     * The velocities of particles of a ParticleArray are contiguous, they are updated
+     * by the vectorized kernel borisAccelerate(), other particles by the loop below.
+     */
+    void accelerate_(Workspace& workspace, ParticleRange particles, double mass, double charge)
+    {
+        double const coef1 = charge * 0.5 * dt_ / mass;
+
+        if constexpr (isParticleArrayIterator<ParticleIterator>::value)
+        {
+            if (particles.size() > 0)
+            {
+                borisAccelerate(&(*particles.begin()).v, particles.size(),
+                                workspace.emAtParticles, coef1);
+            }
+            return;
+        }
+
+        auto const& Ex = workspace.emAtParticles.Ex;
+        auto const& Ey = workspace.emAtParticles.Ey;
+        auto const& Ez = workspace.emAtParticles.Ez;
+        auto const& Bx = workspace.emAtParticles.Bx;
+        auto const& By = workspace.emAtParticles.By;
+        auto const& Bz = workspace.emAtParticles.Bz;
+
+        std::size_t iPart = 0;
+
+        for (auto&& currentPart : particles)
+        {
             // We now apply the 3 steps of the BORIS PUSHER
 
             // 1st half push of the electric field
-            double velx1 = currentIn.v[0] + coef1 * currentIn.Ex;
-            double vely1 = currentIn.v[1] + coef1 * currentIn.Ey;
-            double velz1 = currentIn.v[2] + coef1 * currentIn.Ez;
+            double velx1 = currentPart.v[0] + coef1 * Ex[iPart];
+            double vely1 = currentPart.v[1] + coef1 * Ey[iPart];
+            double velz1 = currentPart.v[2] + coef1 * Ez[iPart];
 
 
             // preparing variables for magnetic rotation
-            double const rx = coef1 * currentIn.Bx;
-            double const ry = coef1 * currentIn.By;
-            double const rz = coef1 * currentIn.Bz;
+            double const rx = coef1 * Bx[iPart];
+            double const ry = coef1 * By[iPart];
+            double const rz = coef1 * Bz[iPart];
 
             double const rx2  = rx * rx;
             double const ry2  = ry * ry;
@@ -225,24 +638,31 @@ private:
 
 
             // 2nd half push of the electric field
-            velx1 = velx2 + coef1 * currentIn.Ex;
-            vely1 = vely2 + coef1 * currentIn.Ey;
-            velz1 = velz2 + coef1 * currentIn.Ez;
+            velx1 = velx2 + coef1 * Ex[iPart];
+            vely1 = vely2 + coef1 * Ey[iPart];
+            velz1 = velz2 + coef1 * Ez[iPart];
 
             // Update particle velocity
-            currentOut->v[0] = velx1;
-            currentOut->v[1] = vely1;
-            currentOut->v[2] = velz1;
+            currentPart.v[0] = velx1;
+            currentPart.v[1] = vely1;
+            currentPart.v[2] = velz1;
 
-            ++currentOut;
+            ++iPart;
         }
     }
 
 
 
 
+    PartitionStrategy partitionStrategy_;
+    bool fused_{false};
+    std::shared_ptr<ThreadPool> threadPool_;
+
     std::array<double, dim> halfDtOverDl_;
     double dt_;
+
+    std::vector<Workspace> workspaces_ = std::vector<Workspace>(1);
+    std::vector<ThreadPart> threadParts_;
 };
 
 
@@ -0,0 +1,147 @@
+#ifndef PHARE_CORE_NUMERICS_PUSHER_BORIS_KERNEL_H
+#define PHARE_CORE_NUMERICS_PUSHER_BORIS_KERNEL_H
+
+#include <array>
+#include <cstddef>
+
+#include "data/electromag/electromag_at_particles.h"
+#include "utilities/simd/simd.h"
+
+namespace PHARE
+{
+namespace detail
+{
+    /** Boris velocity update of 'nbrLanes' consecutive particles. Velocities are first
+     * copied to one local array per component so that each operation below is the same
+     * on all lanes and with no dependency between them, which the compiler turns into
+     * vector instructions. The operations are those of the scalar kernel, in the same order.
+     */
+    template<std::size_t nbrLanes, typename Velocity>
+    void borisAccelerateLanes(std::array<Velocity, 3>* v, double const* Ex, double const* Ey,
+                              double const* Ez, double const* Bx, double const* By,
+                              double const* Bz, double coef1)
+    {
+        double vx[nbrLanes], vy[nbrLanes], vz[nbrLanes];
+
+        for (auto lane = 0u; lane < nbrLanes; ++lane)
+        {
+            vx[lane] = v[lane][0];
+            vy[lane] = v[lane][1];
+            vz[lane] = v[lane][2];
+        }
+
+        for (auto lane = 0u; lane < nbrLanes; ++lane)
+        {
+            // 1st half push of the electric field
+            double const velx1 = vx[lane] + coef1 * Ex[lane];
+            double const vely1 = vy[lane] + coef1 * Ey[lane];
+            double const velz1 = vz[lane] + coef1 * Ez[lane];
+
+            double const rx = coef1 * Bx[lane];
+            double const ry = coef1 * By[lane];
+            double const rz = coef1 * Bz[lane];
+
+            double const rx2  = rx * rx;
+            double const ry2  = ry * ry;
+            double const rz2  = rz * rz;
+            double const rxry = rx * ry;
+            double const rxrz = rx * rz;
+            double const ryrz = ry * rz;
+
+            double const invDet = 1. / (1. + rx2 + ry2 + rz2);
+
+            double const mxx = 1. + rx2 - ry2 - rz2;
+            double const mxy = 2. * (rxry + rz);
+            double const mxz = 2. * (rxrz - ry);
+
+            double const myx = 2. * (rxry - rz);
+            double const myy = 1. + ry2 - rx2 - rz2;
+            double const myz = 2. * (ryrz + rx);
+
+            double const mzx = 2. * (rxrz + ry);
+            double const mzy = 2. * (ryrz - rx);
+            double const mzz = 1. + rz2 - rx2 - ry2;
+
+            // magnetic rotation
+            double const velx2 = (mxx * velx1 + mxy * vely1 + mxz * velz1) * invDet;
+            double const vely2 = (myx * velx1 + myy * vely1 + myz * velz1) * invDet;
+            double const velz2 = (mzx * velx1 + mzy * vely1 + mzz * velz1) * invDet;
+
+            // 2nd half push of the electric field
+            vx[lane] = velx2 + coef1 * Ex[lane];
+            vy[lane] = vely2 + coef1 * Ey[lane];
+            vz[lane] = velz2 + coef1 * Ez[lane];
+        }
+
+        for (auto lane = 0u; lane < nbrLanes; ++lane)
+        {
+            v[lane][0] = static_cast<Velocity>(vx[lane]);
+            v[lane][1] = static_cast<Velocity>(vy[lane]);
+            v[lane][2] = static_cast<Velocity>(vz[lane]);
+        }
+    }
+} // namespace detail
+
+
+
+
+/** @brief applies the Boris velocity update to nbrParticles contiguous velocities, the i-th
+ * particle seeing the fields emAtParticles.Ex[i], ... emAtParticles.Bz[i].
+ *
+ * coef1 is charge * dt / (2 * mass). Particles are processed by blocks of simdWidth<double>
+ * lanes. The last particles are copied into a full block padded with zero fields, so that
+ * all particles go through the same instructions and a particle gets the same velocity
+ * whatever its position in the array.
+ */
+template<typename Velocity>
+void borisAccelerate(std::array<Velocity, 3>* velocities, std::size_t nbrParticles,
+                     ElectromagAtParticles const& emAtParticles, double coef1)
+{
+    constexpr std::size_t nbrLanes = simdWidth<double>;
+
+    auto const* Ex = emAtParticles.Ex.data();
+    auto const* Ey = emAtParticles.Ey.data();
+    auto const* Ez = emAtParticles.Ez.data();
+    auto const* Bx = emAtParticles.Bx.data();
+    auto const* By = emAtParticles.By.data();
+    auto const* Bz = emAtParticles.Bz.data();
+
+    std::size_t iPart = 0;
+    for (; iPart + nbrLanes <= nbrParticles; iPart += nbrLanes)
+    {
+        detail::borisAccelerateLanes<nbrLanes>(velocities + iPart, Ex + iPart, Ey + iPart,
+                                               Ez + iPart, Bx + iPart, By + iPart, Bz + iPart,
+                                               coef1);
+    }
+
+    auto const nbrRemaining = nbrParticles - iPart;
+    if (nbrRemaining > 0)
+    {
+        std::array<Velocity, 3> v[nbrLanes] = {};
+        double fields[6][nbrLanes]          = {};
+
+        for (auto lane = 0u; lane < nbrRemaining; ++lane)
+        {
+            v[lane]         = velocities[iPart + lane];
+            fields[0][lane] = Ex[iPart + lane];
+            fields[1][lane] = Ey[iPart + lane];
+            fields[2][lane] = Ez[iPart + lane];
+            fields[3][lane] = Bx[iPart + lane];
+            fields[4][lane] = By[iPart + lane];
+            fields[5][lane] = Bz[iPart + lane];
+        }
+
+        detail::borisAccelerateLanes<nbrLanes>(v, fields[0], fields[1], fields[2], fields[3],
+                                               fields[4], fields[5], coef1);
+
+        for (auto lane = 0u; lane < nbrRemaining; ++lane)
+        {
+            velocities[iPart + lane] = v[lane];
+        }
+    }
+}
+
+
+} // namespace PHARE
+
+#endif
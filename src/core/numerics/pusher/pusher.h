@@ -32,6 +32,8 @@ public:
      * must have the same size as rangeIn (nbrParticles(rangeIn) == nbrParticles(rangeOut).
      * @param E: electric vector field used to accelerate particles
      * @param B: magnetic vector field used to accelerate particles
+     * @param mass, charge: mass and charge of the particles, the same for all particles
+     * of the range since they belong to the same population
      * @param selector : used to place particles in rangeOut.
      * @param bc : physical boundary condition. Manage particles that intersect with a physical
      * domain bounday.
@@ -42,8 +44,8 @@ public:
      */
     virtual ParticleIterator
     move(ParticleRange const& rangeIn, ParticleRange& rangeOut, Electromag const& emFields,
-         double mass, Interpolator& interpolator, ParticleSelector const& particleIsNotLeaving,
-         BoundaryCondition& bc)
+         double mass, double charge, Interpolator& interpolator,
+         ParticleSelector const& particleIsNotLeaving, BoundaryCondition& bc)
         = 0;
 
 
@@ -56,7 +58,8 @@ public:
      */
     virtual ParticleIterator // decltype(std::declval<ParticleRange>().end())
     move(ParticleRange const& rangeIn, ParticleRange& rangeOut, Electromag const& emFields,
-         double mass, Interpolator& interpolator, ParticleSelector const& particleIsNotLeaving)
+         double mass, double charge, Interpolator& interpolator,
+         ParticleSelector const& particleIsNotLeaving)
         = 0;
 
 
@@ -2,8 +2,9 @@
 #define PHARE_CORE_NUMERIC_PUSHER_PUSHER_FACTORY_H
 
 #include <cstddef>
-#include <string>
 #include <memory>
+#include <stdexcept>
+#include <string>
 
 #include "pusher.h"
 #include "boris.h"
@@ -14,6 +15,9 @@ namespace PHARE
 class PusherFactory
 {
 public:
+    /** @brief makes the pusher of the given name, only "boris" for now,
+     * throws if the name is unknown.
+     */
     template<std::size_t dim, typename ParticleIterator, typename Electromag, typename Interpolator,
              typename ParticleSelector, typename BoundaryCondition>
     static auto makePusher(std::string pusherName)
@@ -26,7 +30,7 @@ public:
 
         else
         {
-            std::runtime_error("Error : Invalid Pusher name");
+            throw std::runtime_error("Error : Invalid Pusher name");
         }
     }
 };
@@ -0,0 +1,277 @@
+#ifndef PHARE_CORE_NUMERICS_STENCIL_FOR_EACH_IN_BOX_H
+#define PHARE_CORE_NUMERICS_STENCIL_FOR_EACH_IN_BOX_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+
+#include "hybrid/hybrid_quantities.h"
+#include "numerics/stencil/row_stencil.h"
+#include "utilities/box/box.h"
+#include "utilities/thread_pool/thread_pool.h"
+#include "utilities/types.h"
+
+
+namespace PHARE
+{
+/* forEachTile and forEachInBox cut a box into tiles and run a function on each tile, or on
+ * each node of each tile, with one of the following policies. Tiles are numbered in
+ * lexicographic order, the last direction varying fastest, and the node function is called
+ * row by row in each tile, so that the nodes of a tile are visited in memory order.
+ *
+ * With a parallel policy, tiles run concurrently: the function must not write a node that
+ * another tile reads or writes. If it throws, the first exception is rethrown once all
+ * tiles are done.
+ */
+
+
+/** Static: tiles are cut into contiguous chunks, one per thread.
+ *  Dynamic: threads take the tiles one by one as they become free, for tiles that do not
+ *  have the same cost.
+ */
+enum class Schedule { Static, Dynamic };
+
+
+//! runs the tiles on the calling thread, in order
+struct SerialPolicy
+{
+};
+
+
+//! runs the tiles with an OpenMP parallel loop, or serially when not compiled with OpenMP
+struct OpenMPPolicy
+{
+    Schedule schedule = Schedule::Static;
+};
+
+
+//! runs the tiles on the threads of a ThreadPool, or serially with a nullptr pool
+struct ThreadPoolPolicy
+{
+    std::shared_ptr<ThreadPool> threadPool;
+    Schedule schedule = Schedule::Dynamic;
+};
+
+
+
+
+namespace detail
+{
+    template<std::size_t dim>
+    class BoxTiling
+    {
+    public:
+        BoxTiling(Box<uint32, dim> const& box, std::array<uint32, dim> const& tileShape)
+            : box_{box}
+            , tileShape_{tileShape}
+        {
+            for (auto iDir = 0u; iDir < dim; ++iDir)
+            {
+                if (tileShape[iDir] == 0)
+                {
+                    throw std::runtime_error("Error - forEachTile - tiles need at least one cell");
+                }
+
+                auto const size = box.upper[iDir] > box.lower[iDir]
+                                      ? box.upper[iDir] - box.lower[iDir]
+                                      : uint32{0};
+
+                nbrTiles_[iDir] = size / tileShape[iDir] + (size % tileShape[iDir] != 0 ? 1 : 0);
+                nbrTilesTotal_ *= nbrTiles_[iDir];
+            }
+        }
+
+
+        std::size_t size() const { return nbrTilesTotal_; }
+
+
+        //! box of the iTile-th tile, its upper bound excluded
+        Box<uint32, dim> operator[](std::size_t iTile) const
+        {
+            Box<uint32, dim> tile;
+            for (auto iDir = dim; iDir-- > 0;)
+            {
+                auto const tileIndex = static_cast<uint32>(iTile % nbrTiles_[iDir]);
+                iTile /= nbrTiles_[iDir];
+
+                tile.lower[iDir] = box_.lower[iDir] + tileIndex * tileShape_[iDir];
+                auto const left  = box_.upper[iDir] - tile.lower[iDir];
+                tile.upper[iDir] = tile.lower[iDir] + std::min(tileShape_[iDir], left);
+            }
+            return tile;
+        }
+
+
+    private:
+        Box<uint32, dim> box_;
+        std::array<uint32, dim> tileShape_;
+        std::array<std::size_t, dim> nbrTiles_;
+        std::size_t nbrTilesTotal_{1};
+    };
+
+
+
+
+    template<typename Task>
+    void runTasks(std::size_t nbrTasks, SerialPolicy const&, Task&& task)
+    {
+        for (auto iTask = 0u; iTask < nbrTasks; ++iTask)
+        {
+            task(iTask);
+        }
+    }
+
+
+    template<typename Task>
+    void runTasks(std::size_t nbrTasks, OpenMPPolicy const& policy, Task&& task)
+    {
+#ifdef _OPENMP
+        std::exception_ptr exception;
+        auto const ompNbrTasks = static_cast<long>(nbrTasks);
+
+        auto runTask = [&](long iTask) {
+            try
+            {
+                task(static_cast<std::size_t>(iTask));
+            }
+            catch (...)
+            {
+#pragma omp critical(PHARE_forEachTile)
+                if (!exception)
+                {
+                    exception = std::current_exception();
+                }
+            }
+        };
+
+        if (policy.schedule == Schedule::Static)
+        {
+#pragma omp parallel for schedule(static)
+            for (long iTask = 0; iTask < ompNbrTasks; ++iTask)
+            {
+                runTask(iTask);
+            }
+        }
+        else
+        {
+#pragma omp parallel for schedule(dynamic)
+            for (long iTask = 0; iTask < ompNbrTasks; ++iTask)
+            {
+                runTask(iTask);
+            }
+        }
+
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+#else
+        (void)policy;
+        runTasks(nbrTasks, SerialPolicy{}, task);
+#endif
+    }
+
+
+    template<typename Task>
+    void runTasks(std::size_t nbrTasks, ThreadPoolPolicy const& policy, Task&& task)
+    {
+        if (!policy.threadPool)
+        {
+            runTasks(nbrTasks, SerialPolicy{}, task);
+        }
+        else if (policy.schedule == Schedule::Dynamic)
+        {
+            policy.threadPool->parallelFor(nbrTasks, task);
+        }
+        else
+        {
+            auto const nbrChunks = std::min(policy.threadPool->size(), nbrTasks);
+
+            policy.threadPool->parallelFor(nbrChunks, [&](std::size_t iChunk) {
+                auto const end = (iChunk + 1) * nbrTasks / nbrChunks;
+                for (auto iTask = iChunk * nbrTasks / nbrChunks; iTask < end; ++iTask)
+                {
+                    task(iTask);
+                }
+            });
+        }
+    }
+} // namespace detail
+
+
+
+
+/** @brief calls tileFunction(tile) for each tile of a box, tile being the box of the nodes of
+ * the tile. Boxes have their upper bound excluded, the tiles have tileShape nodes in each
+ * direction, but the last ones which stop at the upper bound of the box.
+ */
+template<std::size_t dim, typename Policy, typename TileFunction>
+void forEachTile(Box<uint32, dim> const& box, std::array<uint32, dim> const& tileShape,
+                 Policy const& policy, TileFunction&& tileFunction)
+{
+    detail::BoxTiling<dim> const tiling{box, tileShape};
+
+    detail::runTasks(tiling.size(), policy,
+                     [&](std::size_t iTile) { tileFunction(tiling[iTile]); });
+}
+
+
+
+
+/** @brief calls nodeFunction(index) for each node of a box, index being the
+ * std::array<uint32, dim> index of the node, tile by tile, see forEachTile.
+ *
+ * e.g. a kernel written once for 1D, 2D and 3D fields:
+ *
+ *     forEachInBox(physicalBox<Scalar::Ex>(layout), tileShape, ThreadPoolPolicy{pool},
+ *                  [&](auto const& index) { nodeAt(Ex, index) = 2. * nodeAt(E0, index); });
+ */
+template<std::size_t dim, typename Policy, typename NodeFunction>
+void forEachInBox(Box<uint32, dim> const& box, std::array<uint32, dim> const& tileShape,
+                  Policy const& policy, NodeFunction&& nodeFunction)
+{
+    forEachTile(box, tileShape, policy, [&](Box<uint32, dim> const& tile) {
+        forEachRow(tile, [&](std::array<uint32, dim> first, uint32 size) {
+            auto const end = first[dim - 1] + size;
+            for (; first[dim - 1] < end; ++first[dim - 1])
+            {
+                nodeFunction(static_cast<std::array<uint32, dim> const&>(first));
+            }
+        });
+    });
+}
+
+
+
+
+
+
+/** @brief TiledPhysicalRows(QuantityTag<quantity>{}, rowFunction) calls rowFunction for each
+ * row of the physical nodes of the quantity, like PhysicalRows, but tile by tile with a
+ * policy, see forEachTile. With a parallel policy, rowFunction must only write the nodes
+ * of its row, and must not read the nodes written for other rows.
+ */
+template<typename GridLayout, typename Policy>
+struct TiledPhysicalRows
+{
+    template<HybridQuantity::Scalar quantity, typename RowFunction>
+    void operator()(QuantityTag<quantity>, RowFunction&& rowFunction) const
+    {
+        forEachTile(physicalBox<quantity>(layout), tileShape, policy,
+                    [&](Box<uint32, GridLayout::dimension> const& tile) {
+                        forEachRow(tile, rowFunction);
+                    });
+    }
+
+    GridLayout const& layout;
+    std::array<uint32, GridLayout::dimension> const& tileShape;
+    Policy const& policy;
+};
+
+
+} // namespace PHARE
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef PHARE_CORE_NUMERICS_STENCIL_LINEAR_COMBINATION_H
+#define PHARE_CORE_NUMERICS_STENCIL_LINEAR_COMBINATION_H
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "numerics/stencil/row_stencil.h"
+#include "utilities/box/box.h"
+#include "utilities/types.h"
+
+
+namespace PHARE
+{
+/** @brief RowLinearCombination is a linear combination of nodes of a field, given by one of
+ * the WeightPoint tables of the GridLayout (momentsToEx(), BzToEx(), ExToMoments(), ...), on
+ * a row of nodes of the quantity it is projected onto.
+ *
+ * combination is the function returning the table, e.g. &GridLayout::momentsToEx. The table
+ * is evaluated at compile time, so that the offsets and coefficients of its points are
+ * constants and the sum over the points is unrolled. Each point of a row is at a constant
+ * offset from the row, RowLinearCombination only keeps a pointer to the range of each point.
+ */
+template<auto combination>
+class RowLinearCombination
+{
+    static constexpr auto points = combination();
+
+public:
+    static constexpr std::size_t dimension = std::decay_t<decltype(points[0].indexes)>::dimension;
+    static constexpr std::size_t nbrPoints = points.size();
+
+
+    /** @param first is the index of the first node of the row, on the grid of the quantity
+     * the source is projected onto
+     */
+    template<typename Field>
+    RowLinearCombination(Field const& source, std::array<uint32, dimension> const& first)
+    {
+        for (auto iPoint = 0u; iPoint < nbrPoints; ++iPoint)
+        {
+            auto index = first;
+            for (auto iDir = 0u; iDir < dimension; ++iDir)
+            {
+                index[iDir] = static_cast<uint32>(static_cast<int>(index[iDir])
+                                                  + points[iPoint].indexes[iDir]);
+            }
+            nodes_[iPoint] = &nodeAt(source, index);
+        }
+    }
+
+
+    //! linear combination at the i-th node of the row
+    double operator[](std::size_t i) const
+    {
+        return sum_(i, std::make_index_sequence<nbrPoints>{});
+    }
+
+
+private:
+    template<std::size_t... iPoint>
+    double sum_(std::size_t i, std::index_sequence<iPoint...>) const
+    {
+        return (... + (points[iPoint].coef * nodes_[iPoint][i]));
+    }
+
+
+    std::array<double const*, nbrPoints> nodes_;
+};
+
+
+
+
+/** @brief sets the nodes of a box of destination to the linear combination of the nodes of
+ * source given by combination, see RowLinearCombination. The box is in the indexes of
+ * destination, its upper bound excluded. The points of the combination around the box must
+ * be nodes of source, ghost nodes included.
+ *
+ * e.g. projecting the ion density onto Ex on the physical nodes of Ex:
+ *
+ *     applyLinearCombination<&GridLayout::momentsToEx>(rho, rhoOnEx,
+ *                                                     physicalBox<Scalar::Ex>(layout));
+ */
+template<auto combination, typename SourceField, typename DestinationField, std::size_t dim>
+void applyLinearCombination(SourceField const& source, DestinationField& destination,
+                            Box<uint32, dim> const& box)
+{
+    static_assert(RowLinearCombination<combination>::dimension == dim,
+                  "Error - the combination and the box must have the same dimension");
+
+    forEachRow(box, [&](std::array<uint32, dim> const& first, uint32 size) {
+        RowLinearCombination<combination> const combined{source, first};
+        auto* row = &nodeAt(destination, first);
+
+        for (auto i = 0u; i < size; ++i)
+        {
+            row[i] = combined[i];
+        }
+    });
+}
+
+
+} // namespace PHARE
+
+#endif
@@ -0,0 +1,205 @@
+#ifndef PHARE_CORE_NUMERICS_STENCIL_ROW_STENCIL_H
+#define PHARE_CORE_NUMERICS_STENCIL_ROW_STENCIL_H
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+#include "data/grid/gridlayoutdefs.h"
+#include "hybrid/hybrid_quantities.h"
+#include "utilities/box/box.h"
+#include "utilities/types.h"
+
+
+namespace PHARE
+{
+/* Fields are stored with their last index contiguous in memory. A row is the set of
+ * nodes of a field that only differ by their last index: it is contiguous, and described
+ * by the index of its first node and its number of nodes.
+ */
+
+
+//! returns the node of a field at a multidimensional index given as an array
+template<typename Field, std::size_t dim>
+auto& nodeAt(Field& field, std::array<uint32, dim> const& index)
+{
+    static_assert(dim >= 1 && dim <= 3, "Error - nodeAt is only valid for dim 1, 2 or 3");
+
+    if constexpr (dim == 1)
+    {
+        return field(index[0]);
+    }
+    else if constexpr (dim == 2)
+    {
+        return field(index[0], index[1]);
+    }
+    else
+    {
+        return field(index[0], index[1], index[2]);
+    }
+}
+
+
+
+
+/** @brief calls rowFunction(first, size) for each row of the nodes of a box, first being
+ * the index of the first node of the row and size its number of nodes. The upper bound of
+ * the box is excluded, an empty box has no row.
+ */
+template<std::size_t dim, typename RowFunction>
+void forEachRow(Box<uint32, dim> const& box, RowFunction&& rowFunction)
+{
+    for (auto iDir = 0u; iDir < dim; ++iDir)
+    {
+        if (box.lower[iDir] >= box.upper[iDir])
+        {
+            return;
+        }
+    }
+
+    uint32 const rowSize = box.upper[dim - 1] - box.lower[dim - 1];
+
+    std::array<uint32, dim> first;
+    for (auto iDir = 0u; iDir < dim; ++iDir)
+    {
+        first[iDir] = box.lower[iDir];
+    }
+
+    if constexpr (dim == 1)
+    {
+        rowFunction(first, rowSize);
+    }
+    else if constexpr (dim == 2)
+    {
+        for (first[0] = box.lower[0]; first[0] < box.upper[0]; ++first[0])
+        {
+            rowFunction(first, rowSize);
+        }
+    }
+    else if constexpr (dim == 3)
+    {
+        for (first[0] = box.lower[0]; first[0] < box.upper[0]; ++first[0])
+        {
+            for (first[1] = box.lower[1]; first[1] < box.upper[1]; ++first[1])
+            {
+                rowFunction(first, rowSize);
+            }
+        }
+    }
+}
+
+
+
+
+//! returns the box of the physical nodes of a quantity, its upper bound excluded
+template<HybridQuantity::Scalar quantity, typename GridLayout>
+Box<uint32, GridLayout::dimension> physicalBox(GridLayout const& layout)
+{
+    constexpr std::array<Direction, 3> directions{{Direction::X, Direction::Y, Direction::Z}};
+
+    Box<uint32, GridLayout::dimension> box;
+    for (auto iDir = 0u; iDir < GridLayout::dimension; ++iDir)
+    {
+        box.lower[iDir] = layout.physicalStartIndex(quantity, directions[iDir]);
+        box.upper[iDir] = layout.physicalEndIndex(quantity, directions[iDir]) + 1;
+    }
+    return box;
+}
+
+
+
+
+//! calls rowFunction(first, size) for each row of the physical nodes of a quantity
+template<HybridQuantity::Scalar quantity, typename GridLayout, typename RowFunction>
+void forEachPhysicalRow(GridLayout const& layout, RowFunction&& rowFunction)
+{
+    forEachRow(physicalBox<quantity>(layout), std::forward<RowFunction>(rowFunction));
+}
+
+
+
+
+template<HybridQuantity::Scalar value>
+struct QuantityTag
+{
+    static constexpr auto quantity = value;
+};
+
+
+
+
+/** @brief PhysicalRows(QuantityTag<quantity>{}, rowFunction) calls rowFunction for each row
+ * of the physical nodes of the quantity.
+ *
+ * Operators computing a field row by row take such a function, that gives the rows of each
+ * quantity to compute. Other ones compute the same operator on a part of the nodes only.
+ */
+template<typename GridLayout>
+struct PhysicalRows
+{
+    template<HybridQuantity::Scalar quantity, typename RowFunction>
+    void operator()(QuantityTag<quantity>, RowFunction&& rowFunction) const
+    {
+        forEachPhysicalRow<quantity>(layout, std::forward<RowFunction>(rowFunction));
+    }
+
+    GridLayout const& layout;
+};
+
+
+
+
+/** @brief RowDerivative is the first derivative of a quantity in a given direction, on a
+ * row of nodes of the derived quantity. It computes the same thing as GridLayout::deriv.
+ *
+ * The centering of the quantity is known at compile time, so the next and prev nodes of
+ * the derivative are two contiguous ranges of the operand, at constant offsets from the
+ * row. RowDerivative only keeps pointers to these two ranges, so that loops over a row
+ * using it have no index computation nor branch, and are vectorized by the compiler.
+ */
+template<typename GridLayout, HybridQuantity::Scalar quantity, Direction direction>
+class RowDerivative
+{
+public:
+    static constexpr std::size_t dimension = GridLayout::dimension;
+    static constexpr auto dirIndex         = static_cast<std::size_t>(direction);
+    static constexpr auto centering        = GridLayout::centering(quantity)[dirIndex];
+
+    static constexpr int nextShift = GridLayout::nextIndexShift(centering);
+    static constexpr int prevShift = GridLayout::prevIndexShift(centering);
+
+
+    /** @param first is the index of the first node of the row, on the grid of the
+     * derivative
+     */
+    template<typename Field>
+    RowDerivative(GridLayout const& layout, Field const& operand,
+                  std::array<uint32, dimension> const& first)
+        : next_{&nodeAt(operand, shifted_(first, nextShift))}
+        , prev_{&nodeAt(operand, shifted_(first, prevShift))}
+        , inverseMeshSize_{layout.inverseMeshSize(direction)}
+    {
+    }
+
+
+    //! derivative at the i-th node of the row
+    double operator[](std::size_t i) const { return inverseMeshSize_ * (next_[i] - prev_[i]); }
+
+
+private:
+    static std::array<uint32, dimension> shifted_(std::array<uint32, dimension> index, int shift)
+    {
+        index[dirIndex] = static_cast<uint32>(static_cast<int>(index[dirIndex]) + shift);
+        return index;
+    }
+
+
+    double const* next_;
+    double const* prev_;
+    double inverseMeshSize_;
+};
+
+
+} // namespace PHARE
+
+#endif
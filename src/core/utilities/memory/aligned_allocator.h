@@ -0,0 +1,75 @@
+#ifndef PHARE_CORE_UTILITIES_MEMORY_ALIGNED_ALLOCATOR_H
+#define PHARE_CORE_UTILITIES_MEMORY_ALIGNED_ALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+
+namespace PHARE
+{
+//! alignment, in bytes, of the arrays used in compute kernels (one cache line, one AVX-512 register)
+constexpr std::size_t simdAlignment{64};
+
+
+
+/** @brief AlignedAllocator is a standard allocator that returns memory aligned
+ * on 'alignment' bytes.
+ *
+ * It is used for the arrays that compute kernels stream through (e.g. particle attributes)
+ * so that the first element of each array starts on a cache line and the compiler
+ * can use aligned vector loads.
+ */
+template<typename T, std::size_t alignment = simdAlignment>
+class AlignedAllocator
+{
+public:
+    static_assert(alignment >= alignof(T), "Error - alignment must be at least alignof(T)");
+
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    template<typename U>
+    AlignedAllocator(AlignedAllocator<U, alignment> const&)
+    {
+    }
+
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignment}));
+    }
+
+
+    void deallocate(T* p, std::size_t) { ::operator delete(p, std::align_val_t{alignment}); }
+};
+
+
+template<typename T, typename U, std::size_t alignment>
+bool operator==(AlignedAllocator<T, alignment> const&, AlignedAllocator<U, alignment> const&)
+{
+    return true;
+}
+
+template<typename T, typename U, std::size_t alignment>
+bool operator!=(AlignedAllocator<T, alignment> const&, AlignedAllocator<U, alignment> const&)
+{
+    return false;
+}
+
+
+
+template<typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+
+} // namespace PHARE
+
+#endif
@@ -0,0 +1,347 @@
+#ifndef PHARE_CORE_UTILITIES_MEMORY_MEMORY_POOL_H
+#define PHARE_CORE_UTILITIES_MEMORY_MEMORY_POOL_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <vector>
+
+#include "utilities/memory/aligned_allocator.h"
+
+
+namespace PHARE
+{
+/** @brief MemoryPool keeps the memory blocks given back by containers so that they can be
+ * reused by the next containers of similar size instead of going back to the system.
+ *
+ * Blocks are sorted by size classes, each class holding blocks of a power of two
+ * bytes, from minBlockSize to maxBlockSize. All blocks are aligned on simdAlignment bytes.
+ * Blocks larger than maxBlockSize are neither rounded up nor cached, they are taken from
+ * and given back to the system directly, so that large arrays do not cost up to twice
+ * their size and their memory is returned as soon as they are freed.
+ *
+ * There is one pool per thread (see threadLocal()), so that allocating and deallocating
+ * never needs a lock. A block can be deallocated by another thread than the one that
+ * allocated it, it is then cached by the pool of the deallocating thread.
+ *
+ * A pool never caches more than capacity() bytes, defaultCapacity unless set otherwise,
+ * so that the blocks recycled from one step to the next stay bounded. Cached blocks are
+ * given back to the system by release(), and when the thread ends. releaseAll() asks the
+ * pools of all threads to release their blocks, which the integrator does after a regrid,
+ * when the buffers of the previous hierarchy are not needed anymore. Memory deallocated
+ * after the pool of the thread has been destroyed (e.g. by static objects) goes directly
+ * to the system.
+ */
+class MemoryPool
+{
+public:
+    static constexpr std::size_t minBlockSize    = 64;
+    static constexpr std::size_t nbrSizeClasses  = 18;
+    static constexpr std::size_t maxBlockSize    = minBlockSize << (nbrSizeClasses - 1);
+    static constexpr std::size_t defaultCapacity = std::size_t{32} << 20;
+
+
+    //! pool of the calling thread, nullptr once it has been destroyed at the end of the thread
+    static MemoryPool* threadLocal();
+
+
+    /** @brief gives the cached blocks of the pool of the calling thread back to the system
+     * now, and those of the pools of the other threads the next time they are used
+     */
+    static void releaseAll()
+    {
+        ++releaseGeneration_();
+        if (auto pool = threadLocal())
+        {
+            pool->release();
+        }
+    }
+
+
+    MemoryPool() = default;
+
+    MemoryPool(MemoryPool const&) = delete;
+    MemoryPool& operator=(MemoryPool const&) = delete;
+
+    ~MemoryPool() { release(); }
+
+
+
+
+    void* allocate(std::size_t bytes)
+    {
+        releaseIfAsked_();
+
+        if (bytes > maxBlockSize)
+        {
+            ++nbrSystemAllocations_;
+            return systemAllocate(bytes);
+        }
+
+        auto iClass  = sizeClass(bytes);
+        auto& blocks = freeBlocks_[iClass];
+
+        if (blocks.empty())
+        {
+            ++nbrSystemAllocations_;
+            return systemAllocate(blockSize(iClass));
+        }
+
+        void* block = blocks.back();
+        blocks.pop_back();
+        cachedBytes_ -= blockSize(iClass);
+        return block;
+    }
+
+
+
+
+    void deallocate(void* block, std::size_t bytes)
+    {
+        releaseIfAsked_();
+
+        if (bytes > maxBlockSize)
+        {
+            systemDeallocate(block);
+            return;
+        }
+
+        auto iClass = sizeClass(bytes);
+        if (cachedBytes_ + blockSize(iClass) > capacity_)
+        {
+            systemDeallocate(block);
+            return;
+        }
+
+        freeBlocks_[iClass].push_back(block);
+        cachedBytes_ += blockSize(iClass);
+    }
+
+
+
+
+    //! gives all cached blocks back to the system
+    void release()
+    {
+        for (auto& blocks : freeBlocks_)
+        {
+            for (auto block : blocks)
+            {
+                systemDeallocate(block);
+            }
+            blocks.clear();
+        }
+        cachedBytes_        = 0;
+        releasedGeneration_ = releaseGeneration_().load(std::memory_order_relaxed);
+    }
+
+
+    /** @brief gives one block deallocated with the given number of bytes back to the system
+     * if the pool caches it, the other cached blocks are kept
+     */
+    void releaseBlock(void* block, std::size_t bytes)
+    {
+        if (bytes == 0 || bytes > maxBlockSize)
+        {
+            return;
+        }
+
+        auto iClass  = sizeClass(bytes);
+        auto& blocks = freeBlocks_[iClass];
+
+        // the block has most likely just been deallocated, it is then the last one
+        auto cached = std::find(blocks.rbegin(), blocks.rend(), block);
+        if (cached != blocks.rend())
+        {
+            blocks.erase(std::next(cached).base());
+            cachedBytes_ -= blockSize(iClass);
+            systemDeallocate(block);
+        }
+    }
+
+
+    std::size_t cachedBytes() const { return cachedBytes_; }
+
+    std::size_t capacity() const { return capacity_; }
+
+    void setCapacity(std::size_t capacity)
+    {
+        capacity_ = capacity;
+        if (cachedBytes_ > capacity_)
+        {
+            release();
+        }
+    }
+
+    //! number of blocks that had to be asked to the system since the pool was created
+    std::size_t nbrSystemAllocations() const { return nbrSystemAllocations_; }
+
+
+
+
+    static std::size_t sizeClass(std::size_t bytes)
+    {
+        std::size_t iClass = 0;
+        while (blockSize(iClass) < bytes)
+        {
+            ++iClass;
+        }
+        return iClass;
+    }
+
+    static constexpr std::size_t blockSize(std::size_t iClass) { return minBlockSize << iClass; }
+
+    //! bytes of the block actually held by an allocation of the given number of bytes
+    static std::size_t allocatedSize(std::size_t bytes)
+    {
+        if (bytes == 0 || bytes > maxBlockSize)
+        {
+            return bytes;
+        }
+        return blockSize(sizeClass(bytes));
+    }
+
+
+    static void* systemAllocate(std::size_t bytes)
+    {
+        return ::operator new(bytes, std::align_val_t{simdAlignment});
+    }
+
+    static void systemDeallocate(void* block)
+    {
+        ::operator delete(block, std::align_val_t{simdAlignment});
+    }
+
+
+
+private:
+    //! incremented by releaseAll(), shared by the pools of all threads
+    static std::atomic<std::size_t>& releaseGeneration_()
+    {
+        static std::atomic<std::size_t> generation{0};
+        return generation;
+    }
+
+    void releaseIfAsked_()
+    {
+        if (releasedGeneration_ != releaseGeneration_().load(std::memory_order_relaxed))
+        {
+            release();
+        }
+    }
+
+
+    std::array<std::vector<void*>, nbrSizeClasses> freeBlocks_;
+    std::size_t cachedBytes_{0};
+    std::size_t capacity_{defaultCapacity};
+    std::size_t nbrSystemAllocations_{0};
+    std::size_t releasedGeneration_{0};
+};
+
+
+
+namespace detail
+{
+    enum class PoolState { NotCreated, Alive, Destroyed };
+
+    struct ThreadMemoryPool
+    {
+        explicit ThreadMemoryPool(PoolState& state_)
+            : state{state_}
+        {
+            state = PoolState::Alive;
+        }
+
+        ~ThreadMemoryPool() { state = PoolState::Destroyed; }
+
+        PoolState& state;
+        MemoryPool pool;
+    };
+} // namespace detail
+
+
+
+inline MemoryPool* MemoryPool::threadLocal()
+{
+    // the state is trivially destructible so it can still be read
+    // after the pool of the thread has been destroyed
+    thread_local detail::PoolState state = detail::PoolState::NotCreated;
+    if (state == detail::PoolState::Destroyed)
+    {
+        return nullptr;
+    }
+
+    thread_local detail::ThreadMemoryPool threadPool{state};
+    return &threadPool.pool;
+}
+
+
+
+
+/** @brief PoolAllocator is a standard allocator taking its memory from the MemoryPool
+ * of the current thread. Memory is aligned on simdAlignment bytes, as with AlignedAllocator.
+ */
+template<typename T>
+class PoolAllocator
+{
+public:
+    static_assert(simdAlignment >= alignof(T), "Error - simdAlignment must be at least alignof(T)");
+
+    using value_type = T;
+
+    PoolAllocator() = default;
+
+    template<typename U>
+    PoolAllocator(PoolAllocator<U> const&)
+    {
+    }
+
+
+    T* allocate(std::size_t n)
+    {
+        if (auto pool = MemoryPool::threadLocal())
+        {
+            return static_cast<T*>(pool->allocate(n * sizeof(T)));
+        }
+        return static_cast<T*>(MemoryPool::systemAllocate(n * sizeof(T)));
+    }
+
+
+    void deallocate(T* p, std::size_t n)
+    {
+        if (auto pool = MemoryPool::threadLocal())
+        {
+            pool->deallocate(p, n * sizeof(T));
+        }
+        else
+        {
+            MemoryPool::systemDeallocate(p);
+        }
+    }
+};
+
+
+template<typename T, typename U>
+bool operator==(PoolAllocator<T> const&, PoolAllocator<U> const&)
+{
+    return true;
+}
+
+template<typename T, typename U>
+bool operator!=(PoolAllocator<T> const&, PoolAllocator<U> const&)
+{
+    return false;
+}
+
+
+
+template<typename T>
+using PooledVector = std::vector<T, PoolAllocator<T>>;
+
+
+} // namespace PHARE
+
+#endif
@@ -58,9 +58,9 @@ public:
 
     constexpr Point() { r.fill(static_cast<Type>(0)); }
 
-    type& operator[](std::size_t i) { return r[i]; }
+    constexpr type& operator[](std::size_t i) { return r[i]; }
 
-    type const& operator[](std::size_t i) const { return r[i]; }
+    constexpr type const& operator[](std::size_t i) const { return r[i]; }
 
 private:
     std::array<Type, dim> r;
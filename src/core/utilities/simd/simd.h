@@ -0,0 +1,31 @@
+#ifndef PHARE_CORE_UTILITIES_SIMD_SIMD_H
+#define PHARE_CORE_UTILITIES_SIMD_SIMD_H
+
+#include <cstddef>
+
+
+namespace PHARE
+{
+/** size in bytes of the vector registers of the instruction set the code is compiled for.
+ * It is decided at build time: compile with -mavx2, -mavx512f or -march=native (see the
+ * nativeArch CMake option) to get the wider registers, SSE2 is the default on x86-64.
+ */
+#if defined(__AVX512F__)
+constexpr std::size_t simdRegisterSize{64};
+#elif defined(__AVX__)
+constexpr std::size_t simdRegisterSize{32};
+#elif defined(__SSE2__) || defined(__ARM_NEON)
+constexpr std::size_t simdRegisterSize{16};
+#else
+constexpr std::size_t simdRegisterSize{sizeof(double)};
+#endif
+
+
+//! number of values of type T held by one vector register, i.e. lanes of a simd kernel
+template<typename T>
+constexpr std::size_t simdWidth = simdRegisterSize / sizeof(T) > 0 ? simdRegisterSize / sizeof(T) : 1;
+
+
+} // namespace PHARE
+
+#endif
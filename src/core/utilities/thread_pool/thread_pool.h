@@ -0,0 +1,176 @@
+#ifndef PHARE_CORE_UTILITIES_THREAD_POOL_THREAD_POOL_H
+#define PHARE_CORE_UTILITIES_THREAD_POOL_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace PHARE
+{
+/** @brief ThreadPool runs the iterations of a loop on a set of threads created once.
+ *
+ * parallelFor(nbrTasks, task) calls task(iTask) for iTask in [0, nbrTasks[ and returns
+ * when all calls are done. Tasks are taken in order by the threads of the pool as they
+ * become free, the calling thread being one of them, so a pool of size() == 1 has no
+ * worker thread and runs the tasks serially.
+ *
+ * If tasks throw, the first exception is rethrown by parallelFor() once all tasks
+ * are done. parallelFor() called from a task runs serially on the calling thread.
+ */
+class ThreadPool
+{
+public:
+    explicit ThreadPool(std::size_t nbrThreads = std::thread::hardware_concurrency())
+    {
+        for (auto iThread = 1u; iThread < std::max(nbrThreads, std::size_t{1}); ++iThread)
+        {
+            workers_.emplace_back([this]() { workerLoop_(); });
+        }
+    }
+
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            stop_ = true;
+        }
+        wakeUp_.notify_all();
+        for (auto& worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+
+
+    //! number of threads running the tasks, including the calling thread
+    std::size_t size() const { return workers_.size() + 1; }
+
+
+
+    template<typename Task>
+    void parallelFor(std::size_t nbrTasks, Task&& task)
+    {
+        if (workers_.empty() || nbrTasks <= 1 || isInTask_())
+        {
+            for (auto iTask = 0u; iTask < nbrTasks; ++iTask)
+            {
+                task(iTask);
+            }
+            return;
+        }
+
+        std::function<void(std::size_t)> job = std::ref(task);
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            job_       = &job;
+            nbrTasks_  = nbrTasks;
+            nextTask_  = 0;
+            nbrActive_ = workers_.size();
+            exception_ = nullptr;
+            ++generation_;
+        }
+        wakeUp_.notify_all();
+
+        runTasks_();
+
+        std::unique_lock<std::mutex> lock{mutex_};
+        done_.wait(lock, [this]() { return nbrActive_ == 0; });
+        job_ = nullptr;
+
+        if (exception_)
+        {
+            std::rethrow_exception(std::exchange(exception_, nullptr));
+        }
+    }
+
+
+
+
+private:
+    static bool& isInTask_()
+    {
+        thread_local bool inTask = false;
+        return inTask;
+    }
+
+
+    void runTasks_()
+    {
+        isInTask_() = true;
+        for (auto iTask = nextTask_++; iTask < nbrTasks_; iTask = nextTask_++)
+        {
+            try
+            {
+                (*job_)(iTask);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+                if (!exception_)
+                {
+                    exception_ = std::current_exception();
+                }
+            }
+        }
+        isInTask_() = false;
+    }
+
+
+    void workerLoop_()
+    {
+        std::size_t lastGeneration = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock{mutex_};
+                wakeUp_.wait(lock, [&]() { return stop_ || generation_ != lastGeneration; });
+                if (stop_)
+                {
+                    return;
+                }
+                lastGeneration = generation_;
+            }
+
+            runTasks_();
+
+            {
+                std::lock_guard<std::mutex> lock{mutex_};
+                --nbrActive_;
+            }
+            done_.notify_one();
+        }
+    }
+
+
+
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable wakeUp_;
+    std::condition_variable done_;
+
+    std::function<void(std::size_t)>* job_{nullptr};
+    std::size_t nbrTasks_{0};
+    std::atomic<std::size_t> nextTask_{0};
+    std::size_t nbrActive_{0};
+    std::size_t generation_{0};
+    std::exception_ptr exception_;
+    bool stop_{false};
+};
+
+
+} // namespace PHARE
+
+#endif
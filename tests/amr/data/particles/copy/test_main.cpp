@@ -34,7 +34,6 @@ struct AParticlesData1D : public testing::Test
     AParticlesData1D()
     {
         particle.weight = 1.0;
-        particle.charge = 1.0;
         particle.v      = {1.0, 1.0, 1.0};
     }
 };
@@ -103,13 +102,6 @@ TEST_F(AParticlesData1D, PreservesAllParticleAttributesAfterCopy)
     EXPECT_THAT(destData.domainParticles[0].iCell, Eq(particle.iCell));
     EXPECT_THAT(destData.domainParticles[0].delta, Eq(particle.delta));
     EXPECT_THAT(destData.domainParticles[0].weight, Eq(particle.weight));
-    EXPECT_THAT(destData.domainParticles[0].charge, Eq(particle.charge));
-    EXPECT_DOUBLE_EQ(destData.domainParticles[0].Ex, particle.Ex);
-    EXPECT_DOUBLE_EQ(destData.domainParticles[0].Ey, particle.Ey);
-    EXPECT_DOUBLE_EQ(destData.domainParticles[0].Ez, particle.Ez);
-    EXPECT_DOUBLE_EQ(destData.domainParticles[0].Bx, particle.Bx);
-    EXPECT_DOUBLE_EQ(destData.domainParticles[0].By, particle.By);
-    EXPECT_DOUBLE_EQ(destData.domainParticles[0].Bz, particle.Bz);
 
 
     particle.iCell = {{6}};
@@ -120,13 +112,6 @@ TEST_F(AParticlesData1D, PreservesAllParticleAttributesAfterCopy)
     EXPECT_THAT(destData.ghostParticles[0].iCell, Eq(particle.iCell));
     EXPECT_THAT(destData.ghostParticles[0].delta, Eq(particle.delta));
     EXPECT_THAT(destData.ghostParticles[0].weight, Eq(particle.weight));
-    EXPECT_THAT(destData.ghostParticles[0].charge, Eq(particle.charge));
-    EXPECT_DOUBLE_EQ(destData.ghostParticles[0].Ex, particle.Ex);
-    EXPECT_DOUBLE_EQ(destData.ghostParticles[0].Ey, particle.Ey);
-    EXPECT_DOUBLE_EQ(destData.ghostParticles[0].Ez, particle.Ez);
-    EXPECT_DOUBLE_EQ(destData.ghostParticles[0].Bx, particle.Bx);
-    EXPECT_DOUBLE_EQ(destData.ghostParticles[0].By, particle.By);
-    EXPECT_DOUBLE_EQ(destData.ghostParticles[0].Bz, particle.Bz);
 }
 
 
@@ -65,7 +65,6 @@ struct twoParticlesDatasTouchingPeriodicBorders : public testing::Test
     twoParticlesDatasTouchingPeriodicBorders()
     {
         particle.weight = 1.0;
-        particle.charge = 1.0;
         particle.v      = {{1.0, 1.0, 1.0}};
     }
 };
@@ -106,13 +105,6 @@ TEST_F(twoParticlesDatasTouchingPeriodicBorders, preserveParticleAttributesInCop
     // EXPECT_THAT(destPdat.ghostParticles[0].iCell, Eq(-1));
     EXPECT_THAT(destPdat.ghostParticles[0].delta, Eq(particle.delta));
     EXPECT_THAT(destPdat.ghostParticles[0].weight, Eq(particle.weight));
-    EXPECT_THAT(destPdat.ghostParticles[0].charge, Eq(particle.charge));
-    EXPECT_DOUBLE_EQ(destPdat.ghostParticles[0].Ex, particle.Ex);
-    EXPECT_DOUBLE_EQ(destPdat.ghostParticles[0].Ey, particle.Ey);
-    EXPECT_DOUBLE_EQ(destPdat.ghostParticles[0].Ez, particle.Ez);
-    EXPECT_DOUBLE_EQ(destPdat.ghostParticles[0].Bx, particle.Bx);
-    EXPECT_DOUBLE_EQ(destPdat.ghostParticles[0].By, particle.By);
-    EXPECT_DOUBLE_EQ(destPdat.ghostParticles[0].Bz, particle.Bz);
 }
 
 
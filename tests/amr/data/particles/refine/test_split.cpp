@@ -71,9 +71,9 @@ public:
 
 
 
-    std::vector<Particle<dimension>> getRefinedL0Particles()
+    PooledVector<Particle<dimension>> getRefinedL0Particles()
     {
-        std::vector<Particle<dimension>> refinedParticles;
+        PooledVector<Particle<dimension>> refinedParticles;
 
         auto split
             = Split<dimension, interpOrder>(Point<int32, dimension>{ratio}, refineParticlesNbr);
@@ -120,7 +120,7 @@ public:
     static constexpr std::size_t dimension = BaseType::dimension;
 
     std::vector<Particle<dimension>>
-    filterCoarseToFineParticles(std::vector<Particle<dimension>> const& refinedParticles,
+    filterCoarseToFineParticles(PooledVector<Particle<dimension>> const& refinedParticles,
                                 std::shared_ptr<SAMRAI::hier::Patch> const& patch)
     {
         std::vector<Particle<dimension>> coarseToFines;
@@ -170,7 +170,7 @@ public:
     static constexpr std::size_t dimension = BaseType::dimension;
 
     std::vector<Particle<dimension>>
-    filterInteriorParticles(std::vector<Particle<dimension>> const& refinedParticles,
+    filterInteriorParticles(PooledVector<Particle<dimension>> const& refinedParticles,
                             std::shared_ptr<SAMRAI::hier::Patch> const& patch)
     {
         std::vector<Particle<dimension>> interiors;
@@ -35,7 +35,6 @@ std::vector<Particle<dimension>> loadCell(int iCell)
     std::vector<Particle<dimension>> particles;
 
     tmpParticle.weight = 1.;
-    tmpParticle.charge = 1.;
     tmpParticle.v      = {{1.0, 0.0, 0.0}};
 
     tmpParticle.iCell[dirX] = iCell;
@@ -88,7 +88,6 @@ public:
                         Particle<dimension> particle;
 
                         particle.weight = 1.;
-                        particle.charge = 1.;
                         particle.v      = {{1.0, 0.0, 0.0}};
 
                         particle.iCell[dirX] = iCellPos;
@@ -66,7 +66,6 @@ struct AParticlesData1D : public testing::Test
     AParticlesData1D()
     {
         particle.weight = 1.0;
-        particle.charge = 1.0;
         particle.v      = {1.0, 1.0, 1.0};
     }
 };
@@ -170,13 +169,6 @@ TEST_F(AParticlesData1D, PreserveParticleAttributesWhenPackingWithPeriodicsFromG
     EXPECT_THAT(destData.domainParticles[0].iCell[0], Eq(0));
     EXPECT_THAT(destData.domainParticles[0].delta, Eq(particle.delta));
     EXPECT_THAT(destData.domainParticles[0].weight, Eq(particle.weight));
-    EXPECT_THAT(destData.domainParticles[0].charge, Eq(particle.charge));
-    EXPECT_DOUBLE_EQ(destData.domainParticles[0].Ex, particle.Ex);
-    EXPECT_DOUBLE_EQ(destData.domainParticles[0].Ey, particle.Ey);
-    EXPECT_DOUBLE_EQ(destData.domainParticles[0].Ez, particle.Ez);
-    EXPECT_DOUBLE_EQ(destData.domainParticles[0].Bx, particle.Bx);
-    EXPECT_DOUBLE_EQ(destData.domainParticles[0].By, particle.By);
-    EXPECT_DOUBLE_EQ(destData.domainParticles[0].Bz, particle.Bz);
 }
 
 
@@ -202,13 +194,58 @@ TEST_F(AParticlesData1D, PreserveParticleAttributesWhenPackingWithPeriodicsFromD
     EXPECT_THAT(destData.ghostParticles[0].iCell[0], Eq(-1));
     EXPECT_THAT(destData.ghostParticles[0].delta, Eq(particle.delta));
     EXPECT_THAT(destData.ghostParticles[0].weight, Eq(particle.weight));
-    EXPECT_THAT(destData.ghostParticles[0].charge, Eq(particle.charge));
-    EXPECT_DOUBLE_EQ(destData.ghostParticles[0].Ex, particle.Ex);
-    EXPECT_DOUBLE_EQ(destData.ghostParticles[0].Ey, particle.Ey);
-    EXPECT_DOUBLE_EQ(destData.ghostParticles[0].Ez, particle.Ez);
-    EXPECT_DOUBLE_EQ(destData.ghostParticles[0].Bx, particle.Bx);
-    EXPECT_DOUBLE_EQ(destData.ghostParticles[0].By, particle.By);
-    EXPECT_DOUBLE_EQ(destData.ghostParticles[0].Bz, particle.Bz);
+}
+
+
+
+
+TEST_F(AParticlesData1D, WritesNoMoreThanItsEstimatedStreamSize)
+{
+    particle.iCell = {{15}};
+    sourceData.domainParticles.push_back(particle);
+    particle.iCell = {{16}};
+    sourceData.ghostParticles.push_back(particle);
+
+    SAMRAI::tbox::MessageStream particlesWriteStream;
+
+    sourceData.packStream(particlesWriteStream, *cellOverlap);
+
+    EXPECT_LE(particlesWriteStream.getCurrentSize(), sourceData.getDataStreamSize(*cellOverlap));
+}
+
+
+
+
+TEST_F(AParticlesData1D, CanStreamVelocitiesInSinglePrecision)
+{
+    particle.iCell = {{15}};
+    particle.v     = {0.1, 0.2, 0.3};
+    sourceData.domainParticles.push_back(particle);
+
+    SAMRAI::tbox::MessageStream doubleWriteStream;
+    sourceData.packStream(doubleWriteStream, *cellOverlap);
+
+    ParticlesData<1>::streamVelocitiesAsFloat = true;
+
+    SAMRAI::tbox::MessageStream particlesWriteStream;
+    sourceData.packStream(particlesWriteStream, *cellOverlap);
+
+    ParticlesData<1>::streamVelocitiesAsFloat = false;
+
+    EXPECT_LT(particlesWriteStream.getCurrentSize(), doubleWriteStream.getCurrentSize());
+
+    SAMRAI::tbox::MessageStream particlesReadStream{particlesWriteStream.getCurrentSize(),
+                                                    SAMRAI::tbox::MessageStream::Read,
+                                                    particlesWriteStream.getBufferStart()};
+
+    destData.unpackStream(particlesReadStream, *cellOverlap);
+
+    ASSERT_THAT(destData.ghostParticles.size(), Eq(1));
+    for (auto iComp = 0u; iComp < 3; ++iComp)
+    {
+        EXPECT_FLOAT_EQ(static_cast<float>(particle.v[iComp]), destData.ghostParticles[0].v[iComp]);
+    }
+    EXPECT_THAT(destData.ghostParticles[0].iCell[0], Eq(-1));
 }
 
 
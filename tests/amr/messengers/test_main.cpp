@@ -92,8 +92,9 @@ std::array<double, 3> thermalVelocity(double x)
 auto getIonsInit() // TODO refactor this getIonInit used in several tests
 {
     IonsInit1D ionsInit;
-    ionsInit.name   = "Ions";
-    ionsInit.masses = {{0.1, 0.3}};
+    ionsInit.name    = "Ions";
+    ionsInit.masses  = {{0.1, 0.3}};
+    ionsInit.charges = {{-1., -1.}};
 
     ionsInit.names.emplace_back("specie1");
     ionsInit.names.emplace_back("specie2");
@@ -103,12 +104,12 @@ auto getIonsInit() // TODO refactor this getIonInit used in several tests
     ionsInit.particleInitializers.push_back(std::make_unique<FluidParticleInitializer1D>(
         std::make_unique<ScalarFunction<dim>>(density),
         std::make_unique<VectorFunction<dim>>(bulkVelocity),
-        std::make_unique<VectorFunction<dim>>(thermalVelocity), -1., 10));
+        std::make_unique<VectorFunction<dim>>(thermalVelocity), 10));
 
     ionsInit.particleInitializers.push_back(std::make_unique<FluidParticleInitializer1D>(
         std::make_unique<ScalarFunction<dim>>(density),
         std::make_unique<VectorFunction<dim>>(bulkVelocity),
-        std::make_unique<VectorFunction<dim>>(thermalVelocity), -1., 10));
+        std::make_unique<VectorFunction<dim>>(thermalVelocity), 10));
 
     return ionsInit;
 }
@@ -63,8 +63,9 @@ std::array<double, 3> thermalVelocity(double x)
 auto getIonsInit()
 {
     IonsInit1D ionsInit;
-    ionsInit.name   = "Ions";
-    ionsInit.masses = {{0.1, 0.3}};
+    ionsInit.name    = "Ions";
+    ionsInit.masses  = {{0.1, 0.3}};
+    ionsInit.charges = {{-1., -1.}};
 
     ionsInit.names.emplace_back("specie1");
     ionsInit.names.emplace_back("specie2");
@@ -74,12 +75,12 @@ auto getIonsInit()
     ionsInit.particleInitializers.push_back(std::make_unique<FluidParticleInitializer1D>(
         std::make_unique<ScalarFunction<dim>>(density),
         std::make_unique<VectorFunction<dim>>(bulkVelocity),
-        std::make_unique<VectorFunction<dim>>(thermalVelocity), -1., 10));
+        std::make_unique<VectorFunction<dim>>(thermalVelocity), 10));
 
     ionsInit.particleInitializers.push_back(std::make_unique<FluidParticleInitializer1D>(
         std::make_unique<ScalarFunction<dim>>(density),
         std::make_unique<VectorFunction<dim>>(bulkVelocity),
-        std::make_unique<VectorFunction<dim>>(thermalVelocity), -1., 10));
+        std::make_unique<VectorFunction<dim>>(thermalVelocity), 10));
 
     return ionsInit;
 }
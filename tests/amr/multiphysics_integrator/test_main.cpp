@@ -183,8 +183,9 @@ std::array<double, 3> thermalVelocity(double x)
 auto getIonsInit_()
 {
     IonsInit1D ionsInit;
-    ionsInit.name   = "Ions";
-    ionsInit.masses = {{0.1, 0.3}};
+    ionsInit.name    = "Ions";
+    ionsInit.masses  = {{0.1, 0.3}};
+    ionsInit.charges = {{-1., -1.}};
 
     ionsInit.names.emplace_back("specie1");
     ionsInit.names.emplace_back("specie2");
@@ -194,12 +195,12 @@ auto getIonsInit_()
     ionsInit.particleInitializers.push_back(std::make_unique<FluidParticleInitializer1D>(
         std::make_unique<ScalarFunction<dim>>(density),
         std::make_unique<VectorFunction<dim>>(bulkVelocity),
-        std::make_unique<VectorFunction<dim>>(thermalVelocity), -1., 10));
+        std::make_unique<VectorFunction<dim>>(thermalVelocity), 10));
 
     ionsInit.particleInitializers.push_back(std::make_unique<FluidParticleInitializer1D>(
         std::make_unique<ScalarFunction<dim>>(density),
         std::make_unique<VectorFunction<dim>>(bulkVelocity),
-        std::make_unique<VectorFunction<dim>>(thermalVelocity), -1., 10));
+        std::make_unique<VectorFunction<dim>>(thermalVelocity), 10));
 
     return ionsInit;
 }
@@ -502,8 +503,9 @@ TEST(aMessenger, isCreated)
 
 
     IonsInit1D ionsInit;
-    ionsInit.name   = "Ions";
-    ionsInit.masses = {{0.1, 0.3}};
+    ionsInit.name    = "Ions";
+    ionsInit.masses  = {{0.1, 0.3}};
+    ionsInit.charges = {{-1., -1.}};
 
     ionsInit.names.emplace_back("specie1");
     ionsInit.names.emplace_back("specie2");
@@ -513,12 +515,12 @@ TEST(aMessenger, isCreated)
     ionsInit.particleInitializers.push_back(std::make_unique<FluidParticleInitializer1D>(
         std::make_unique<ScalarFunction<dim>>(density),
         std::make_unique<VectorFunction<dim>>(bulkVelocity),
-        std::make_unique<VectorFunction<dim>>(thermalVelocity), -1., 10));
+        std::make_unique<VectorFunction<dim>>(thermalVelocity), 10));
 
     ionsInit.particleInitializers.push_back(std::make_unique<FluidParticleInitializer1D>(
         std::make_unique<ScalarFunction<dim>>(density),
         std::make_unique<VectorFunction<dim>>(bulkVelocity),
-        std::make_unique<VectorFunction<dim>>(thermalVelocity), -1., 10));
+        std::make_unique<VectorFunction<dim>>(thermalVelocity), 10));
 
 
     // HybridState need an ions initializers to create an ions
@@ -37,6 +37,7 @@ struct Ions1D_P
         IonsInitializer<ParticleArray<1>, GridLayoutMock> initializer;
 
         initializer.masses.push_back(1.);
+        initializer.charges.push_back(1.);
         initializer.names.push_back("protons");
         initializer.nbrPopulations = 1;
         initializer.name           = "TestIons";
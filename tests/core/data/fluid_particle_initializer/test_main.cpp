@@ -50,7 +50,7 @@ public:
         , initializer{std::make_unique<FluidParticleInitializer<ParticleArrayT, GridLayoutT>>(
               std::make_unique<ScalarFunction<1>>(density),
               std::make_unique<VectorFunction<1>>(bulkVelocity),
-              std::make_unique<VectorFunction<1>>(thermalvelocity), 1., nbrParticlesPerCell)}
+              std::make_unique<VectorFunction<1>>(thermalvelocity), nbrParticlesPerCell)}
     {
         //
     }
@@ -4,8 +4,11 @@
 
 
 
+#include "data/field/field.h"
 #include "data/ions/ion_population/ion_population.h"
+#include "data/ndarray/ndarray_vector.h"
 #include "data/particles/particle_array.h"
+#include "data/vecfield/vecfield.h"
 #include "hybrid/hybrid_quantities.h"
 
 #include "gmock/gmock.h"
@@ -34,7 +37,7 @@ struct DummyVecField
 
 struct AnIonPopulation : public ::testing::Test
 {
-    IonPopulation<ParticleArray<1>, DummyVecField> protons{"protons", 1.};
+    IonPopulation<ParticleArray<1>, DummyVecField> protons{"protons", 1., 1.};
     virtual ~AnIonPopulation();
 };
 
@@ -50,6 +53,14 @@ TEST_F(AnIonPopulation, hasAMass)
 
 
 
+TEST_F(AnIonPopulation, hasACharge)
+{
+    EXPECT_DOUBLE_EQ(1., protons.charge());
+}
+
+
+
+
 TEST_F(AnIonPopulation, hasAName)
 {
     EXPECT_EQ("protons", protons.name());
@@ -111,6 +122,120 @@ TEST_F(AnIonPopulation, hasAVecFieldSubResource)
 }
 
 
+TEST(AnIonPopulationWithoutSubcycling, isPushedAtEachStep)
+{
+    IonPopulation<ParticleArray<1>, DummyVecField> protons{"protons", 1., 1.};
+
+    EXPECT_FALSE(protons.isSubcycled());
+    EXPECT_TRUE(protons.isPushedAt(0));
+    EXPECT_TRUE(protons.isPushedAt(1));
+    EXPECT_DOUBLE_EQ(0.1, protons.pushTimeStep(0.1));
+    EXPECT_DOUBLE_EQ(1., protons.momentsWeight(1));
+    EXPECT_EQ(1, protons.getFieldNamesAndQuantities().size());
+}
+
+
+
+TEST(ASubcycledIonPopulation, isPushedEverySubcyclingStepsWithALargerTimeStep)
+{
+    IonPopulation<ParticleArray<1>, DummyVecField> oxygen{"oxygen", 16., 1., 4};
+
+    EXPECT_TRUE(oxygen.isSubcycled());
+    EXPECT_TRUE(oxygen.isPushedAt(0));
+    EXPECT_FALSE(oxygen.isPushedAt(1));
+    EXPECT_FALSE(oxygen.isPushedAt(3));
+    EXPECT_TRUE(oxygen.isPushedAt(8));
+    EXPECT_DOUBLE_EQ(0.4, oxygen.pushTimeStep(0.1));
+}
+
+
+
+TEST(ASubcycledIonPopulation, needsBuffersForItsPreviousMoments)
+{
+    IonPopulation<ParticleArray<1>, DummyVecField> oxygen{"oxygen", 16., 1., 4};
+
+    auto fieldProperties = oxygen.getFieldNamesAndQuantities();
+
+    ASSERT_EQ(5, fieldProperties.size());
+    EXPECT_EQ("oxygen_rhoPrevious", fieldProperties[1].name);
+    EXPECT_EQ(HybridQuantity::Scalar::Vz, fieldProperties[4].qty);
+}
+
+
+
+TEST(ASubcycledIonPopulation, cannotHaveANullSubcyclingFactor)
+{
+    using Population = IonPopulation<ParticleArray<1>, DummyVecField>;
+    EXPECT_THROW(Population("oxygen", 16., 1., 0), std::runtime_error);
+}
+
+
+
+TEST(ASubcycledIonPopulation, interpolatesItsMomentsBetweenTwoPushes)
+{
+    using VecField1D = VecField<NdArrayVector1D<>, HybridQuantity>;
+    using Field1D    = Field<NdArrayVector1D<>, HybridQuantity::Scalar>;
+
+    IonPopulation<ParticleArray<1>, VecField1D> oxygen{"oxygen", 16., 1., 4};
+    VecField1D& flux = std::get<0>(oxygen.getCompileTimeResourcesUserList());
+
+    std::vector<Field1D> fields;
+    for (auto const& property : oxygen.getFieldNamesAndQuantities())
+    {
+        fields.emplace_back(property.name, property.qty, 10u);
+    }
+    for (auto const& property : flux.getFieldNamesAndQuantities())
+    {
+        fields.emplace_back(property.name, property.qty, 10u);
+    }
+
+    ParticleArray<1> domain, ghost, coarseToFine;
+    ParticlesPack<ParticleArray<1>> pack{&domain, &ghost, &coarseToFine};
+    oxygen.setBuffer("oxygen", &pack);
+    for (auto iField = 0u; iField < 5; ++iField)
+    {
+        oxygen.setBuffer(fields[iField].name(), &fields[iField]);
+    }
+    for (auto iField = 5u; iField < fields.size(); ++iField)
+    {
+        flux.setBuffer(fields[iField].name(), &fields[iField]);
+    }
+    ASSERT_TRUE(oxygen.isUsable());
+
+    // density and flux are 1 before the push, 3 after it
+    std::fill(std::begin(oxygen.density()), std::end(oxygen.density()), 1.);
+    std::fill(std::begin(fields[5]), std::end(fields[5]), 1.);
+    oxygen.saveMoments();
+    std::fill(std::begin(oxygen.density()), std::end(oxygen.density()), 3.);
+    std::fill(std::begin(fields[5]), std::end(fields[5]), 3.);
+
+    Field1D rho{"rho", HybridQuantity::Scalar::rho, 10u};
+    VecField1D sum{"sum", HybridQuantity::Vector::V};
+    std::vector<Field1D> sumComponents;
+    for (auto const& property : sum.getFieldNamesAndQuantities())
+    {
+        sumComponents.emplace_back(property.name, property.qty, 10u);
+    }
+    for (auto& component : sumComponents)
+    {
+        sum.setBuffer(component.name(), &component);
+    }
+
+    auto values = [](Field1D const& field) {
+        return std::vector<double>(std::begin(field), std::end(field));
+    };
+
+    oxygen.addDensityAt(1, rho);
+    oxygen.addFluxAt(1, sum);
+    EXPECT_THAT(values(rho), ::testing::Each(::testing::DoubleEq(2.)));
+    EXPECT_THAT(values(sumComponents[0]), ::testing::Each(::testing::DoubleEq(2.)));
+
+    oxygen.addDensityAt(3, rho);
+    EXPECT_THAT(values(rho), ::testing::Each(::testing::DoubleEq(5.)));
+}
+
+
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -1,7 +1,10 @@
 
+#include <memory>
 #include <type_traits>
+#include <vector>
 
 
+#include "data/field/field.h"
 #include "data/ions/ion_initializer.h"
 #include "data/ions/ion_population/ion_population.h"
 #include "data/ions/ions.h"
@@ -33,6 +36,7 @@ protected:
         IonsInitializer<ParticleArray<1>, GridLayoutMock> initializer;
 
         initializer.masses.push_back(1.);
+        initializer.charges.push_back(1.);
         initializer.names.push_back("protons");
         initializer.nbrPopulations = 1;
         initializer.name           = "TestIons";
@@ -88,6 +92,81 @@ TEST_F(theIons, throwIfAccessingDensityWhileNotUsable)
 
 
 
+// the ions and their populations on fields of 10 nodes, with no particle
+class theAllocatedIons : public theIons
+{
+protected:
+    using Field1D = Field<NdArrayVector1D<>, HybridQuantity::Scalar>;
+
+    std::vector<std::unique_ptr<Field1D>> fields;
+    ParticleArray<1> domain, ghost, coarseToFine;
+    ParticlesPack<ParticleArray<1>> pack{&domain, &ghost, &coarseToFine};
+
+
+    template<typename ResourcesUser>
+    void allocate(ResourcesUser& user)
+    {
+        for (auto const& property : user.getFieldNamesAndQuantities())
+        {
+            fields.push_back(std::make_unique<Field1D>(property.name, property.qty, 10u));
+            user.setBuffer(property.name, fields.back().get());
+        }
+    }
+
+
+    theAllocatedIons()
+    {
+        allocate(ions);
+        allocate(std::get<0>(ions.getCompileTimeResourcesUserList()));
+        allocate(std::get<1>(ions.getCompileTimeResourcesUserList()));
+        for (auto& pop : ions)
+        {
+            allocate(pop);
+            allocate(std::get<0>(pop.getCompileTimeResourcesUserList()));
+            pop.setBuffer(pop.name(), &pack);
+        }
+    }
+};
+
+
+
+TEST_F(theAllocatedIons, computeTheirDensityAsTheSumOfThePopulationDensities)
+{
+    for (auto& pop : ions)
+    {
+        std::fill(std::begin(pop.density()), std::end(pop.density()), 2.);
+    }
+    ASSERT_TRUE(ions.isUsable());
+
+    ions.computeDensity();
+
+    EXPECT_THAT(std::vector<double>(std::begin(ions.density()), std::end(ions.density())),
+                ::testing::Each(::testing::DoubleEq(2.)));
+}
+
+
+
+TEST_F(theAllocatedIons, computeTheirBulkVelocityAsTheirFluxOverTheirDensity)
+{
+    auto& density = ions.density();
+    auto& fluxX   = ions.flux().getComponent(Component::X);
+    for (auto ix = 0u; ix < 10u; ++ix)
+    {
+        density(ix) = ix < 5u ? 0. : 2.;
+        fluxX(ix)   = 3.;
+    }
+
+    ions.computeBulkVelocity();
+
+    auto const& vx = ions.velocity().getComponent(Component::X);
+    for (auto ix = 0u; ix < 10u; ++ix)
+    {
+        EXPECT_DOUBLE_EQ(ix < 5u ? 0. : 1.5, vx(ix));
+    }
+}
+
+
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -1,13 +1,27 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <cstdint>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include "data/particles/cell_sorter.h"
 #include "data/particles/particle.h"
 #include "data/particles/particle_array.h"
+#include "data/particles/particle_memory.h"
+#include "data/particles/particle_tiles.h"
+#include "utilities/box/box.h"
 #include "utilities/point/point.h"
 
+using PHARE::Box;
 using PHARE::cellAsPoint;
+using PHARE::CellSorter;
+using PHARE::MemoryPool;
 using PHARE::Particle;
+using PHARE::ParticleArray;
+using PHARE::ParticleShrinkPolicy;
+using PHARE::ParticleTiles;
 using PHARE::Point;
 
 class AParticle : public ::testing::Test
@@ -17,39 +31,28 @@ protected:
 
 public:
     AParticle()
-        : part{0.01, 1, {{12, 24, 36}}, {{0.002f, 0.2f, 0.8f}}, {{1.8, 1.83, 2.28}}}
+        : part{0.01, {{12, 24, 36}}, {{0.002f, 0.2f, 0.8f}}, {{1.8, 1.83, 2.28}}}
     {
     }
 };
 
 
-TEST_F(AParticle, ParticleWeightIsWellInitialized)
-{
-    EXPECT_DOUBLE_EQ(0.01, part.weight);
-}
+// weights and velocities are stored with the precision of the particles, see particle.h
 
-TEST_F(AParticle, ParticleChargeIsInitiliazedOK)
-{
-    EXPECT_DOUBLE_EQ(1., part.charge);
-}
-
-TEST_F(AParticle, ParticleFieldsAreInitializedToZero)
+TEST_F(AParticle, ParticleWeightIsWellInitialized)
 {
-    EXPECT_DOUBLE_EQ(0.0, part.Ex);
-    EXPECT_DOUBLE_EQ(0.0, part.Ey);
-    EXPECT_DOUBLE_EQ(0.0, part.Ez);
+    using weight_type = Particle<3>::weight_type;
 
-    EXPECT_DOUBLE_EQ(0.0, part.Bx);
-    EXPECT_DOUBLE_EQ(0.0, part.By);
-    EXPECT_DOUBLE_EQ(0.0, part.Bz);
+    EXPECT_EQ(static_cast<weight_type>(0.01), part.weight);
 }
 
-
 TEST_F(AParticle, ParticleVelocityIsInitializedOk)
 {
-    EXPECT_DOUBLE_EQ(1.8, part.v[0]);
-    EXPECT_DOUBLE_EQ(1.83, part.v[1]);
-    EXPECT_DOUBLE_EQ(2.28, part.v[2]);
+    using velocity_type = Particle<3>::velocity_type;
+
+    EXPECT_EQ(static_cast<velocity_type>(1.8), part.v[0]);
+    EXPECT_EQ(static_cast<velocity_type>(1.83), part.v[1]);
+    EXPECT_EQ(static_cast<velocity_type>(2.28), part.v[2]);
 }
 
 TEST_F(AParticle, ParticleDeltaIsInitializedOk)
@@ -91,6 +94,508 @@ TEST_F(AParticle, CanBeReducedToAnAbsolutePositionPoint)
 
 
 
+class AParticleArray : public ::testing::Test
+{
+protected:
+    ParticleArray<3> particles;
+    Particle<3> part{0.01, {{12, 24, 36}}, {{0.002f, 0.2f, 0.8f}}, {{1.8, 1.83, 2.28}}};
+
+public:
+    AParticleArray()
+    {
+        for (auto i = 0; i < 10; ++i)
+        {
+            part.iCell[0] = i;
+            particles.push_back(part);
+        }
+    }
+};
+
+
+
+TEST_F(AParticleArray, returnsTheParticlesItWasGiven)
+{
+    EXPECT_EQ(10u, particles.size());
+
+    for (auto i = 0u; i < particles.size(); ++i)
+    {
+        Particle<3> p = particles[i];
+        EXPECT_EQ(static_cast<int>(i), p.iCell[0]);
+        EXPECT_EQ(part.iCell[1], p.iCell[1]);
+        EXPECT_EQ(part.delta, p.delta);
+        EXPECT_EQ(part.v, p.v);
+        EXPECT_DOUBLE_EQ(part.weight, p.weight);
+    }
+}
+
+
+
+TEST_F(AParticleArray, storesEachAttributeContiguouslyAndAligned)
+{
+    EXPECT_EQ(&particles.velocities()[1], &particles.velocities()[0] + 1);
+    EXPECT_EQ(&particles.weights()[1], &particles.weights()[0] + 1);
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(particles.velocities().data())
+                      % PHARE::simdAlignment);
+    EXPECT_EQ(0u,
+              reinterpret_cast<std::uintptr_t>(particles.weights().data()) % PHARE::simdAlignment);
+}
+
+
+
+TEST_F(AParticleArray, canBeModifiedThroughItsIterators)
+{
+    for (auto&& particle : particles)
+    {
+        particle.v[0] = 42.;
+    }
+    particles.begin()->weight = 3.;
+
+    EXPECT_TRUE(std::all_of(std::begin(particles), std::end(particles),
+                            [](auto const& particle) { return particle.v[0] == 42.; }));
+    EXPECT_DOUBLE_EQ(3., particles[0].weight);
+}
+
+
+
+TEST_F(AParticleArray, canBePartitionedWithStandardAlgorithms)
+{
+    auto pivot = std::partition(std::begin(particles), std::end(particles),
+                                [](auto const& particle) { return particle.iCell[0] % 2 == 0; });
+
+    EXPECT_EQ(5, pivot - std::begin(particles));
+    EXPECT_TRUE(std::all_of(std::begin(particles), pivot,
+                            [](auto const& particle) { return particle.iCell[0] % 2 == 0; }));
+    EXPECT_TRUE(std::all_of(pivot, std::end(particles),
+                            [](auto const& particle) { return particle.iCell[0] % 2 == 1; }));
+}
+
+
+
+TEST_F(AParticleArray, canEraseAndInsertParticles)
+{
+    particles.erase(std::begin(particles) + 2, std::end(particles));
+    EXPECT_EQ(2u, particles.size());
+
+    std::vector<Particle<3>> others(3, part);
+    particles.insert(std::begin(particles) + 1, std::begin(others), std::end(others));
+
+    EXPECT_EQ(5u, particles.size());
+    EXPECT_EQ(0, particles[0].iCell[0]);
+    EXPECT_EQ(part.iCell[0], particles[1].iCell[0]);
+    EXPECT_EQ(1, particles[4].iCell[0]);
+}
+
+
+
+TEST_F(AParticleArray, copiesParticlesIntoAnotherArray)
+{
+    ParticleArray<3> copies(particles.size());
+    std::copy(std::begin(particles), std::end(particles), std::begin(copies));
+
+    copies[0].v[0] = 12.;
+
+    EXPECT_EQ(particles[9].iCell, copies[9].iCell);
+    EXPECT_DOUBLE_EQ(part.v[0], particles[0].v[0]);
+}
+
+
+
+TEST(AParticleArrayWithUniformWeight, givesItsWeightToAllItsParticles)
+{
+    ParticleArray<1, true> particles;
+    particles.weights() = 0.5;
+
+    Particle<1> part{0.5, {{3}}, {{0.5f}}, {{1., 2., 3.}}};
+    for (auto i = 0; i < 10; ++i)
+    {
+        part.iCell[0] = i;
+        particles.push_back(part);
+    }
+
+    auto pivot = std::partition(std::begin(particles), std::end(particles),
+                                [](auto const& particle) { return particle.iCell[0] % 2 == 0; });
+
+    EXPECT_EQ(5, pivot - std::begin(particles));
+    EXPECT_TRUE(std::all_of(std::begin(particles), std::end(particles),
+                            [](auto const& particle) { return particle.weight == 0.5; }));
+
+    particles.weights() = 0.25;
+    Particle<1> copy    = particles[3];
+    EXPECT_DOUBLE_EQ(0.25, copy.weight);
+}
+
+
+
+TEST(AParticleArrayWithUniformWeight, cannotTakeAParticleOfAnotherWeight)
+{
+    ParticleArray<1, true> particles;
+    particles.weights() = 0.5;
+
+    Particle<1> part{0.5, {{3}}, {{0.5f}}, {{1., 2., 3.}}};
+    particles.push_back(part);
+
+    part.weight = 0.01;
+    EXPECT_ANY_THROW(particles.push_back(part));
+    EXPECT_ANY_THROW(particles[0] = part);
+    EXPECT_EQ(1u, particles.size());
+
+    ParticleArray<1> weighted;
+    weighted.push_back(part);
+    EXPECT_ANY_THROW(particles[0] = weighted[0]);
+}
+
+
+
+class ACellSorter : public ::testing::Test
+{
+protected:
+    ParticleArray<2> particles;
+    CellSorter<ParticleArray<2>> sorter{Box<int, 2>{Point<int, 2>{0, 0}, Point<int, 2>{4, 3}}};
+
+public:
+    ACellSorter()
+    {
+        // particles are numbered by their weight, in reverse cell order
+        // and with two particles per cell, plus two particles out of the box
+        auto weight = 0.;
+        for (auto ix = 3; ix >= 0; --ix)
+        {
+            for (auto iy = 2; iy >= 0; --iy)
+            {
+                for (auto i = 0; i < 2; ++i)
+                {
+                    particles.push_back({weight++, {{ix, iy}}, {{0.5f, 0.5f}}, {{1., 2., 3.}}});
+                }
+            }
+        }
+        particles.push_back({weight++, {{-1, 0}}, {{0.5f, 0.5f}}, {{1., 2., 3.}}});
+        particles.push_back({weight++, {{1, 3}}, {{0.5f, 0.5f}}, {{1., 2., 3.}}});
+
+        sorter.sort(particles);
+    }
+};
+
+
+
+TEST_F(ACellSorter, ordersParticlesByCellTheLastDirectionBeingTheFastest)
+{
+    for (auto iPart = 1u; iPart < 24; ++iPart)
+    {
+        auto const& previous = particles.iCells()[iPart - 1];
+        auto const& current  = particles.iCells()[iPart];
+
+        EXPECT_LE(previous[0] * 3 + previous[1], current[0] * 3 + current[1]);
+    }
+}
+
+
+
+TEST_F(ACellSorter, keepsTheOrderOfParticlesWithinACell)
+{
+    for (auto iPart = 0u; iPart < 24; iPart += 2)
+    {
+        EXPECT_EQ(particles.iCells()[iPart], particles.iCells()[iPart + 1]);
+        EXPECT_LT(particles[iPart].weight, particles[iPart + 1].weight);
+    }
+}
+
+
+
+TEST_F(ACellSorter, givesTheRangeOfParticlesOfEachCell)
+{
+    for (auto ix = 0; ix < 4; ++ix)
+    {
+        for (auto iy = 0; iy < 3; ++iy)
+        {
+            auto iCell = std::array<int, 2>{{ix, iy}};
+
+            EXPECT_EQ(2u, sorter.nbrParticlesInCell(iCell));
+            for (auto iPart = sorter.cellBegin(iCell); iPart < sorter.cellEnd(iCell); ++iPart)
+            {
+                EXPECT_EQ(iCell, particles.iCells()[iPart]);
+            }
+        }
+    }
+}
+
+
+
+TEST_F(ACellSorter, putsParticlesOutOfItsBoxAtTheEnd)
+{
+    EXPECT_EQ(24u, sorter.outsideBegin());
+    EXPECT_EQ(26u, particles.size());
+    EXPECT_DOUBLE_EQ(24., particles[24].weight);
+    EXPECT_DOUBLE_EQ(25., particles[25].weight);
+}
+
+
+
+TEST_F(ACellSorter, countsParticlesInABoxWithOneRangePerRow)
+{
+    auto nbrRanges = 0;
+    sorter.forEachRangeIn(Box<int, 2>{Point<int, 2>{1, 1}, Point<int, 2>{3, 3}},
+                          [&nbrRanges](std::size_t first, std::size_t last) {
+                              EXPECT_EQ(4u, last - first);
+                              ++nbrRanges;
+                          });
+
+    EXPECT_EQ(2, nbrRanges);
+    EXPECT_EQ(8u, sorter.nbrParticlesIn(Box<int, 2>{Point<int, 2>{1, 1}, Point<int, 2>{3, 3}}));
+    EXPECT_EQ(8u, sorter.nbrParticlesIn(Box<int, 2>{Point<int, 2>{-2, 2}, Point<int, 2>{10, 10}}));
+    EXPECT_EQ(0u, sorter.nbrParticlesIn(Box<int, 2>{Point<int, 2>{5, 0}, Point<int, 2>{6, 3}}));
+}
+
+
+
+TEST(ACellSorterOfUniformWeightParticles, keepsTheirWeight)
+{
+    ParticleArray<1, true> particles;
+    particles.weights() = 0.5;
+
+    for (auto i = 9; i >= 0; --i)
+    {
+        particles.push_back({0.5, {{i}}, {{0.5f}}, {{1., 2., 3.}}});
+    }
+
+    CellSorter<ParticleArray<1, true>> sorter{Box<int, 1>{Point<int, 1>{0}, Point<int, 1>{10}}};
+    sorter.sort(particles);
+
+    for (auto i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ(i, particles.iCells()[i][0]);
+    }
+    EXPECT_DOUBLE_EQ(0.5, particles.weights());
+}
+
+
+
+class ParticleTiles2D : public ::testing::Test
+{
+protected:
+    // 10x6 cells in tiles of 4x4 cells: 3x2 tiles, the last ones being smaller
+    ParticleTiles<ParticleArray<2>> tiles{Box<int, 2>{Point<int, 2>{0, 0}, Point<int, 2>{10, 6}},
+                                          {{4, 4}}};
+
+public:
+    ParticleTiles2D()
+    {
+        for (auto ix = 0; ix < 10; ++ix)
+        {
+            for (auto iy = 0; iy < 6; ++iy)
+            {
+                tiles.push_back({1., {{ix, iy}}, {{0.5f, 0.5f}}, {{1., 2., 3.}}});
+            }
+        }
+    }
+};
+
+
+
+TEST_F(ParticleTiles2D, putsEachParticleInTheTileOfItsCell)
+{
+    EXPECT_EQ(6u, tiles.nbrTiles());
+    EXPECT_EQ(60u, tiles.size());
+
+    for (auto iTile = 0u; iTile < tiles.nbrTiles(); ++iTile)
+    {
+        auto box = tiles.tileBox(iTile);
+        for (auto const& particle : tiles.tile(iTile))
+        {
+            EXPECT_TRUE(isIn(cellAsPoint(particle), box));
+        }
+    }
+
+    auto lastBox = tiles.tileBox(5);
+    EXPECT_EQ(8, lastBox.lower[0]);
+    EXPECT_EQ(10, lastBox.upper[0]);
+    EXPECT_EQ(4, lastBox.lower[1]);
+    EXPECT_EQ(6, lastBox.upper[1]);
+    EXPECT_EQ(4u, tiles.tile(5).size());
+}
+
+
+
+TEST_F(ParticleTiles2D, migratesParticlesThatChangedTile)
+{
+    // all particles move one cell in x, particles of the last column leave the box
+    tiles.forEachTile([](auto& tile, auto const&) {
+        for (auto&& particle : tile)
+        {
+            particle.iCell[0] += 1;
+        }
+    });
+
+    auto nbrMigrants = tiles.migrate();
+
+    EXPECT_EQ(18u, nbrMigrants);
+    EXPECT_EQ(60u, tiles.size());
+    EXPECT_EQ(6u, tiles.leaving().size());
+
+    for (auto iTile = 0u; iTile < tiles.nbrTiles(); ++iTile)
+    {
+        auto box = tiles.tileBox(iTile);
+        for (auto const& particle : tiles.tile(iTile))
+        {
+            EXPECT_TRUE(isIn(cellAsPoint(particle), box));
+        }
+    }
+}
+
+
+
+TEST_F(ParticleTiles2D, givesDifferentColorsToNeighborTiles)
+{
+    EXPECT_EQ(4u, decltype(tiles)::nbrColors);
+
+    for (auto iTile = 0u; iTile < tiles.nbrTiles(); ++iTile)
+    {
+        for (auto jTile = iTile + 1; jTile < tiles.nbrTiles(); ++jTile)
+        {
+            auto iBox = tiles.tileBox(iTile);
+            auto jBox = tiles.tileBox(jTile);
+
+            bool touching = true;
+            for (auto iDim = 0u; iDim < 2; ++iDim)
+            {
+                touching = touching && iBox.lower[iDim] <= jBox.upper[iDim]
+                           && jBox.lower[iDim] <= iBox.upper[iDim];
+            }
+            if (touching)
+            {
+                EXPECT_NE(tiles.colorOf(iTile), tiles.colorOf(jTile));
+            }
+        }
+    }
+}
+
+
+
+TEST_F(ParticleTiles2D, gathersAllParticlesBackInOneArray)
+{
+    ParticleArray<2> particles;
+    tiles.gather(particles);
+
+    EXPECT_EQ(60u, particles.size());
+}
+
+
+
+TEST(AParticleArrayMemoryUsage, reportsSizeCapacityAndHighWaterMark)
+{
+    ParticleArray<1> particles;
+    particles.reserve(100);
+
+    Particle<1> part{0.01, {{3}}, {{0.5f}}, {{1., 2., 3.}}};
+    for (auto i = 0; i < 40; ++i)
+    {
+        particles.push_back(part);
+    }
+    particles.resize(10);
+
+    auto usage = memoryUsageOf(particles);
+
+    using Particles = ParticleArray<1>;
+
+    auto const weightBytes   = sizeof(Particles::weight_type);
+    auto const velocityBytes = 3 * sizeof(Particles::velocity_type);
+
+    // each attribute array holds a block of the memory pool, a power of two bytes
+    auto const bytes = MemoryPool::allocatedSize(100 * weightBytes)
+                       + MemoryPool::allocatedSize(100 * sizeof(int))
+                       + MemoryPool::allocatedSize(100 * sizeof(float))
+                       + MemoryPool::allocatedSize(100 * velocityBytes);
+    auto const usedBytes = 10 * (weightBytes + sizeof(int) + sizeof(float) + velocityBytes);
+
+    EXPECT_EQ(10u, usage.size);
+    EXPECT_EQ(100u, usage.capacity);
+    EXPECT_EQ(40u, usage.highWaterMark);
+    EXPECT_EQ(512u, MemoryPool::allocatedSize(100 * sizeof(int)));
+    EXPECT_EQ(bytes, usage.bytes);
+    EXPECT_EQ(usedBytes, usage.usedBytes);
+    EXPECT_EQ(bytes - usedBytes, usage.slackBytes());
+}
+
+
+
+TEST(AParticleArrayMemoryUsage, isShrunkOnlyWhenItsSlackExceedsThePolicy)
+{
+    ParticleArray<1> particles;
+    particles.reserve(1000);
+    particles.resize(700);
+
+    ParticleShrinkPolicy policy;
+    policy.maxSlack = 0.5;
+    policy.headroom = 0.1;
+    policy.minBytes = 0;
+
+    EXPECT_FALSE(shrink(particles, policy));
+    EXPECT_EQ(1000u, particles.capacity());
+
+    particles.resize(100);
+    particles.velocities()[99] = {{1., 2., 3.}};
+
+    EXPECT_TRUE(shrink(particles, policy));
+    EXPECT_EQ(110u, particles.capacity());
+    EXPECT_EQ(100u, particles.size());
+    EXPECT_EQ(700u, particles.highWaterMark());
+    EXPECT_DOUBLE_EQ(3., particles[99].v[2]);
+
+    policy.minBytes = particles.memoryBytes() + 1;
+    particles.resize(10);
+    EXPECT_FALSE(shrink(particles, policy));
+}
+
+
+
+TEST(AParticleArrayMemoryUsage, isNotShrunkWhenItWouldKeepTheSameBlocks)
+{
+    ParticleArray<1> particles;
+    particles.reserve(1000);
+    particles.resize(700);
+
+    ParticleShrinkPolicy policy;
+    policy.maxSlack = 0.4;
+    policy.headroom = 0.;
+    policy.minBytes = 0;
+
+    // 700 particles need the same blocks of the memory pool as 1000
+    EXPECT_EQ(particles.memoryBytes(), particles.memoryBytes(700));
+    EXPECT_FALSE(shrink(particles, policy));
+    EXPECT_EQ(1000u, particles.capacity());
+}
+
+
+
+TEST(AParticleArrayMemoryUsage, givesOnlyTheBlocksOfTheShrunkArrayBackToTheSystem)
+{
+    std::size_t cachedBytes = 0;
+    std::size_t otherBytes  = 0;
+
+    // in a thread of its own, so that its pool only has the blocks of this test
+    std::thread shrinking{[&cachedBytes, &otherBytes]() {
+        auto pool = MemoryPool::threadLocal();
+
+        ParticleArray<1> particles;
+        particles.reserve(1000);
+        particles.resize(100);
+
+        // a block cached for another array, of the size class of the replaced weights,
+        // which the smaller arrays of the shrunk one do not take
+        otherBytes  = 1000 * sizeof(ParticleArray<1>::weight_type);
+        void* other = pool->allocate(otherBytes);
+        pool->deallocate(other, otherBytes);
+
+        particles.shrinkTo(100);
+
+        cachedBytes = pool->cachedBytes();
+    }};
+    shrinking.join();
+
+    EXPECT_EQ(MemoryPool::allocatedSize(otherBytes), cachedBytes);
+}
+
+
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -1,8 +1,12 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <array>
 #include <fstream>
 #include <memory>
+#include <random>
+#include <vector>
 
 
 #include "data/field/field.h"
@@ -12,6 +16,7 @@
 #include "data/vecfield/vecfield.h"
 #include "numerics/ampere/ampere.h"
 #include "utilities/index/index.h"
+#include "utilities/thread_pool/thread_pool.h"
 
 using namespace PHARE;
 
@@ -21,6 +26,9 @@ struct FieldMock
     double& operator()(uint32 i) { return data; }
     double& operator()(uint32 i, uint32 j) { return data; }
     double& operator()(uint32 i, uint32 j, uint32 k) { return data; }
+    double const& operator()(uint32 i) const { return data; }
+    double const& operator()(uint32 i, uint32 j) const { return data; }
+    double const& operator()(uint32 i, uint32 j, uint32 k) const { return data; }
     QtyCentering physicalQuantity() { return QtyCentering::dual; }
 };
 
@@ -38,6 +46,12 @@ struct GridLayoutMock1D
     double deriv(FieldMock const& f, MeshIndex<1> mi, DirectionTag<Direction::X>) { return 0; }
     int physicalStartIndex(FieldMock&, Direction dir) { return 0; }
     int physicalEndIndex(FieldMock&, Direction dir) { return 0; }
+    static constexpr std::array<QtyCentering, 1> centering(HybridQuantity::Scalar) { return {}; }
+    static constexpr int nextIndexShift(QtyCentering) { return 0; }
+    static constexpr int prevIndexShift(QtyCentering) { return 0; }
+    uint32 physicalStartIndex(HybridQuantity::Scalar, Direction) const { return 0; }
+    uint32 physicalEndIndex(HybridQuantity::Scalar, Direction) const { return 0; }
+    double inverseMeshSize(Direction) const { return 1.; }
 };
 
 struct GridLayoutMock2D
@@ -47,6 +61,12 @@ struct GridLayoutMock2D
     double deriv(FieldMock const& f, MeshIndex<2> mi, DirectionTag<Direction::Y>) { return 0; }
     int physicalStartIndex(FieldMock&, Direction dir) { return 0; }
     int physicalEndIndex(FieldMock&, Direction dir) { return 0; }
+    static constexpr std::array<QtyCentering, 2> centering(HybridQuantity::Scalar) { return {}; }
+    static constexpr int nextIndexShift(QtyCentering) { return 0; }
+    static constexpr int prevIndexShift(QtyCentering) { return 0; }
+    uint32 physicalStartIndex(HybridQuantity::Scalar, Direction) const { return 0; }
+    uint32 physicalEndIndex(HybridQuantity::Scalar, Direction) const { return 0; }
+    double inverseMeshSize(Direction) const { return 1.; }
 };
 
 struct GridLayoutMock3D
@@ -57,6 +77,12 @@ struct GridLayoutMock3D
     double deriv(FieldMock const& f, MeshIndex<3> mi, DirectionTag<Direction::Z>) { return 0; }
     int physicalStartIndex(FieldMock&, Direction dir) { return 0; }
     int physicalEndIndex(FieldMock&, Direction dir) { return 0; }
+    static constexpr std::array<QtyCentering, 3> centering(HybridQuantity::Scalar) { return {}; }
+    static constexpr int nextIndexShift(QtyCentering) { return 0; }
+    static constexpr int prevIndexShift(QtyCentering) { return 0; }
+    uint32 physicalStartIndex(HybridQuantity::Scalar, Direction) const { return 0; }
+    uint32 physicalEndIndex(HybridQuantity::Scalar, Direction) const { return 0; }
+    double inverseMeshSize(Direction) const { return 1.; }
 };
 
 
@@ -491,6 +517,85 @@ TEST_F(Ampere3DTest, ampere3DCalculatedOk)
 
 
 
+TEST_F(Ampere3DTest, givesTheSameCurrentAsPointwiseDerivatives)
+{
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<double> value(-1., 1.);
+    for (auto field : {&Bx, &By, &Bz})
+    {
+        std::generate(std::begin(*field), std::end(*field), [&]() { return value(gen); });
+    }
+
+    ampere.setLayout(&layout);
+    ampere(B, J);
+
+    auto expectSameAsDerivatives = [&](auto const& J_, auto const& expected) {
+        auto qty = J_.physicalQuantity();
+        for (auto ix = layout.physicalStartIndex(qty, Direction::X);
+             ix <= layout.physicalEndIndex(qty, Direction::X); ++ix)
+        {
+            for (auto iy = layout.physicalStartIndex(qty, Direction::Y);
+                 iy <= layout.physicalEndIndex(qty, Direction::Y); ++iy)
+            {
+                for (auto iz = layout.physicalStartIndex(qty, Direction::Z);
+                     iz <= layout.physicalEndIndex(qty, Direction::Z); ++iz)
+                {
+                    EXPECT_DOUBLE_EQ(expected(make_index(ix, iy, iz)), J_(ix, iy, iz));
+                }
+            }
+        }
+    };
+
+    expectSameAsDerivatives(Jx, [&](MeshIndex<3> index) {
+        return layout.deriv(Bz, index, DirectionTag<Direction::Y>{})
+               - layout.deriv(By, index, DirectionTag<Direction::Z>{});
+    });
+    expectSameAsDerivatives(Jy, [&](MeshIndex<3> index) {
+        return layout.deriv(Bx, index, DirectionTag<Direction::Z>{})
+               - layout.deriv(Bz, index, DirectionTag<Direction::X>{});
+    });
+    expectSameAsDerivatives(Jz, [&](MeshIndex<3> index) {
+        return layout.deriv(By, index, DirectionTag<Direction::X>{})
+               - layout.deriv(Bx, index, DirectionTag<Direction::Y>{});
+    });
+}
+
+
+
+TEST_F(Ampere3DTest, givesTheSameCurrentWithTilesComputedOnSeveralThreads)
+{
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<double> value(-1., 1.);
+    for (auto field : {&Bx, &By, &Bz})
+    {
+        std::generate(std::begin(*field), std::end(*field), [&]() { return value(gen); });
+    }
+
+    ampere.setLayout(&layout);
+    ampere(B, J);
+
+    std::vector<std::vector<double>> const expected{{std::begin(Jx), std::end(Jx)},
+                                                    {std::begin(Jy), std::end(Jy)},
+                                                    {std::begin(Jz), std::end(Jz)}};
+    for (auto field : {&Jx, &Jy, &Jz})
+    {
+        std::fill(std::begin(*field), std::end(*field), 0.);
+    }
+
+    Ampere<GridLayout<GridLayoutImpl>, ThreadPoolPolicy> tiledAmpere;
+    tiledAmpere.setLayout(&layout);
+    tiledAmpere.setPolicy(ThreadPoolPolicy{std::make_shared<ThreadPool>(4)});
+    tiledAmpere.setTileShape({{3, 4, 5}});
+    tiledAmpere(B, J);
+
+    EXPECT_EQ(expected[0], std::vector<double>(std::begin(Jx), std::end(Jx)));
+    EXPECT_EQ(expected[1], std::vector<double>(std::begin(Jy), std::end(Jy)));
+    EXPECT_EQ(expected[2], std::vector<double>(std::begin(Jz), std::end(Jz)));
+    EXPECT_ANY_THROW(tiledAmpere.setTileShape({{3, 0, 5}}));
+}
+
+
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -19,7 +19,7 @@ public:
         , leavingParticles_(10)
     {
         bc.setBoundaryBoxes(boundaryBoxes);
-        for (auto& part : leavingParticles_)
+        for (auto&& part : leavingParticles_)
         {
             part.iCell[0] = 5;  // these particles are out...
             part.iCell[1] = -1; // and not through the boundarybox
@@ -1,8 +1,12 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <array>
 #include <fstream>
 #include <memory>
+#include <random>
+#include <vector>
 
 
 #include "data/field/field.h"
@@ -12,6 +16,7 @@
 #include "data/vecfield/vecfield.h"
 #include "numerics/faraday/faraday.h"
 #include "utilities/index/index.h"
+#include "utilities/thread_pool/thread_pool.h"
 
 using namespace PHARE;
 
@@ -37,6 +42,12 @@ struct GridLayoutMock1D
     double deriv(FieldMock const& f, MeshIndex<1> mi, DirectionTag<Direction::X>) {}
     int physicalStartIndex(FieldMock&, Direction dir) { return 0; }
     int physicalEndIndex(FieldMock&, Direction dir) { return 0; }
+    static constexpr std::array<QtyCentering, 1> centering(HybridQuantity::Scalar) { return {}; }
+    static constexpr int nextIndexShift(QtyCentering) { return 0; }
+    static constexpr int prevIndexShift(QtyCentering) { return 0; }
+    uint32 physicalStartIndex(HybridQuantity::Scalar, Direction) const { return 0; }
+    uint32 physicalEndIndex(HybridQuantity::Scalar, Direction) const { return 0; }
+    double inverseMeshSize(Direction) const { return 1.; }
 };
 
 struct GridLayoutMock2D
@@ -46,6 +57,12 @@ struct GridLayoutMock2D
     double deriv(FieldMock const& f, MeshIndex<2> mi, DirectionTag<Direction::Y>) { return 0; }
     int physicalStartIndex(FieldMock&, Direction dir) { return 0; }
     int physicalEndIndex(FieldMock&, Direction dir) { return 0; }
+    static constexpr std::array<QtyCentering, 2> centering(HybridQuantity::Scalar) { return {}; }
+    static constexpr int nextIndexShift(QtyCentering) { return 0; }
+    static constexpr int prevIndexShift(QtyCentering) { return 0; }
+    uint32 physicalStartIndex(HybridQuantity::Scalar, Direction) const { return 0; }
+    uint32 physicalEndIndex(HybridQuantity::Scalar, Direction) const { return 0; }
+    double inverseMeshSize(Direction) const { return 1.; }
 };
 
 struct GridLayoutMock3D
@@ -56,6 +73,12 @@ struct GridLayoutMock3D
     double deriv(FieldMock const& f, MeshIndex<3> mi, DirectionTag<Direction::Z>) { return 0; }
     int physicalStartIndex(FieldMock&, Direction dir) { return 0; }
     int physicalEndIndex(FieldMock&, Direction dir) { return 0; }
+    static constexpr std::array<QtyCentering, 3> centering(HybridQuantity::Scalar) { return {}; }
+    static constexpr int nextIndexShift(QtyCentering) { return 0; }
+    static constexpr int prevIndexShift(QtyCentering) { return 0; }
+    uint32 physicalStartIndex(HybridQuantity::Scalar, Direction) const { return 0; }
+    uint32 physicalEndIndex(HybridQuantity::Scalar, Direction) const { return 0; }
+    double inverseMeshSize(Direction) const { return 1.; }
 };
 
 
@@ -99,6 +122,21 @@ TEST(Faraday, shouldBeGivenAGridLayoutPointerToBeOperational)
 }
 
 
+TEST(Faraday, needsAPositiveTimeStepAndAtLeastOneSubstep)
+{
+    Faraday<GridLayoutMock1D> faraday;
+
+    EXPECT_ANY_THROW(faraday.setTimeStep(0.));
+    EXPECT_ANY_THROW(faraday.setTimeStep(-0.1));
+    EXPECT_ANY_THROW(faraday.setNbrSubsteps(0));
+
+    faraday.setTimeStep(0.1);
+    faraday.setNbrSubsteps(4);
+    EXPECT_DOUBLE_EQ(0.1, faraday.timeStep());
+    EXPECT_EQ(4u, faraday.nbrSubsteps());
+}
+
+
 
 
 std::vector<double> read(std::string filename)
@@ -606,6 +644,213 @@ TEST_F(Faraday3DTest, Faraday3DCalculatedOk)
 
 
 
+TEST_F(Faraday3DTest, givesTheSameFieldAsPointwiseDerivatives)
+{
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<double> value(-1., 1.);
+    for (auto field : {&Bx, &By, &Bz, &Ex, &Ey, &Ez})
+    {
+        std::generate(std::begin(*field), std::end(*field), [&]() { return value(gen); });
+    }
+
+    faraday.setLayout(&layout);
+    faraday(B, E, Bnew);
+
+    auto expectSameAsDerivatives = [&](auto const& Bnew_, auto const& expected) {
+        auto qty = Bnew_.physicalQuantity();
+        for (auto ix = layout.physicalStartIndex(qty, Direction::X);
+             ix <= layout.physicalEndIndex(qty, Direction::X); ++ix)
+        {
+            for (auto iy = layout.physicalStartIndex(qty, Direction::Y);
+                 iy <= layout.physicalEndIndex(qty, Direction::Y); ++iy)
+            {
+                for (auto iz = layout.physicalStartIndex(qty, Direction::Z);
+                     iz <= layout.physicalEndIndex(qty, Direction::Z); ++iz)
+                {
+                    EXPECT_DOUBLE_EQ(expected(make_index(ix, iy, iz)), Bnew_(ix, iy, iz));
+                }
+            }
+        }
+    };
+
+    // dt is 1
+    expectSameAsDerivatives(Bxnew, [&](MeshIndex<3> index) {
+        return Bx(index.i, index.j, index.k) - layout.deriv(Ez, index, DirectionTag<Direction::Y>{})
+               + layout.deriv(Ey, index, DirectionTag<Direction::Z>{});
+    });
+    expectSameAsDerivatives(Bynew, [&](MeshIndex<3> index) {
+        return By(index.i, index.j, index.k) - layout.deriv(Ex, index, DirectionTag<Direction::Z>{})
+               + layout.deriv(Ez, index, DirectionTag<Direction::X>{});
+    });
+    expectSameAsDerivatives(Bznew, [&](MeshIndex<3> index) {
+        return Bz(index.i, index.j, index.k) - layout.deriv(Ey, index, DirectionTag<Direction::X>{})
+               + layout.deriv(Ex, index, DirectionTag<Direction::Y>{});
+    });
+}
+
+
+
+
+TEST_F(Faraday3DTest, scalesTheCurlWithTheTimeStep)
+{
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<double> value(-1., 1.);
+    for (auto field : {&Bx, &By, &Bz, &Ex, &Ey, &Ez})
+    {
+        std::generate(std::begin(*field), std::end(*field), [&]() { return value(gen); });
+    }
+
+    faraday.setLayout(&layout);
+    faraday(B, E, Bnew);
+    std::vector<double> const BxnewUnitStep(std::begin(Bxnew), std::end(Bxnew));
+
+    faraday.setTimeStep(0.25);
+    faraday(B, E, Bnew);
+
+    auto const qty       = Bxnew.physicalQuantity();
+    auto const allocSize = layout.allocSize(qty);
+    for (auto ix = layout.physicalStartIndex(qty, Direction::X);
+         ix <= layout.physicalEndIndex(qty, Direction::X); ++ix)
+    {
+        for (auto iy = layout.physicalStartIndex(qty, Direction::Y);
+             iy <= layout.physicalEndIndex(qty, Direction::Y); ++iy)
+        {
+            for (auto iz = layout.physicalStartIndex(qty, Direction::Z);
+                 iz <= layout.physicalEndIndex(qty, Direction::Z); ++iz)
+            {
+                auto const i = (ix * allocSize[1] + iy) * allocSize[2] + iz;
+                EXPECT_NEAR(0.25 * (BxnewUnitStep[i] - Bx(ix, iy, iz)),
+                            Bxnew(ix, iy, iz) - Bx(ix, iy, iz), 1e-12);
+            }
+        }
+    }
+}
+
+
+
+
+TEST_F(Faraday3DTest, subcyclesWithTheTimeStepSplitInSubsteps)
+{
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<double> value(-1., 1.);
+    for (auto field : {&Bx, &By, &Bz, &Ex, &Ey, &Ez})
+    {
+        std::generate(std::begin(*field), std::end(*field), [&]() { return value(gen); });
+    }
+
+    std::vector<std::vector<double>> const initialE{{std::begin(Ex), std::end(Ex)},
+                                                    {std::begin(Ey), std::end(Ey)},
+                                                    {std::begin(Ez), std::end(Ez)}};
+    auto resetE = [&]() {
+        std::copy(std::begin(initialE[0]), std::end(initialE[0]), std::begin(Ex));
+        std::copy(std::begin(initialE[1]), std::end(initialE[1]), std::begin(Ey));
+        std::copy(std::begin(initialE[2]), std::end(initialE[2]), std::begin(Ez));
+    };
+
+    // any update of E from B will do, it only has to change E between the substeps
+    auto nbrUpdates = 0u;
+    auto updateE    = [&](auto const& Bsubstep, auto& Esubstep) {
+        ++nbrUpdates;
+        for (auto component : {Component::X, Component::Y, Component::Z})
+        {
+            auto& Ei = Esubstep.getComponent(component);
+            std::transform(std::begin(Ei), std::end(Ei), std::begin(Ei),
+                           [](double e) { return 0.5 * e; });
+        }
+        EXPECT_EQ(&Bxnew, &Bsubstep.getComponent(Component::X));
+    };
+
+    // reference: three Faraday steps of dt/3, E being updated in between
+    Faraday<GridLayout<GridLayoutImpl>> substepFaraday;
+    substepFaraday.setLayout(&layout);
+    substepFaraday.setTimeStep(0.3 / 3);
+    substepFaraday(B, E, Bnew);
+    updateE(Bnew, E);
+    substepFaraday(Bnew, E, Bnew);
+    updateE(Bnew, E);
+    substepFaraday(Bnew, E, Bnew);
+
+    std::vector<std::vector<double>> const expected{{std::begin(Bxnew), std::end(Bxnew)},
+                                                    {std::begin(Bynew), std::end(Bynew)},
+                                                    {std::begin(Bznew), std::end(Bznew)}};
+
+    resetE();
+    nbrUpdates = 0;
+
+    faraday.setLayout(&layout);
+    faraday.setTimeStep(0.3);
+    faraday.setNbrSubsteps(3);
+    faraday.subcycle(B, E, Bnew, updateE);
+
+    EXPECT_EQ(2u, nbrUpdates);
+    EXPECT_EQ(expected[0], std::vector<double>(std::begin(Bxnew), std::end(Bxnew)));
+    EXPECT_EQ(expected[1], std::vector<double>(std::begin(Bynew), std::end(Bynew)));
+    EXPECT_EQ(expected[2], std::vector<double>(std::begin(Bznew), std::end(Bznew)));
+}
+
+
+
+
+TEST_F(Faraday3DTest, subcyclesWithASingleSubstepAsOneStep)
+{
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<double> value(-1., 1.);
+    for (auto field : {&Bx, &By, &Bz, &Ex, &Ey, &Ez})
+    {
+        std::generate(std::begin(*field), std::end(*field), [&]() { return value(gen); });
+    }
+
+    faraday.setLayout(&layout);
+    faraday.setTimeStep(0.2);
+    faraday(B, E, Bnew);
+    std::vector<double> const expected(std::begin(Bznew), std::end(Bznew));
+
+    std::fill(std::begin(Bznew), std::end(Bznew), 0.);
+    faraday.subcycle(B, E, Bnew, [](auto const&, auto&) { FAIL() << "E is not updated"; });
+
+    EXPECT_EQ(expected, std::vector<double>(std::begin(Bznew), std::end(Bznew)));
+}
+
+
+
+
+TEST_F(Faraday3DTest, givesTheSameFieldWithTilesComputedOnSeveralThreads)
+{
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<double> value(-1., 1.);
+    for (auto field : {&Bx, &By, &Bz, &Ex, &Ey, &Ez})
+    {
+        std::generate(std::begin(*field), std::end(*field), [&]() { return value(gen); });
+    }
+
+    faraday.setLayout(&layout);
+    faraday.setTimeStep(0.2);
+    faraday(B, E, Bnew);
+
+    std::vector<std::vector<double>> const expected{{std::begin(Bxnew), std::end(Bxnew)},
+                                                    {std::begin(Bynew), std::end(Bynew)},
+                                                    {std::begin(Bznew), std::end(Bznew)}};
+    for (auto field : {&Bxnew, &Bynew, &Bznew})
+    {
+        std::fill(std::begin(*field), std::end(*field), 0.);
+    }
+
+    Faraday<GridLayout<GridLayoutImpl>, ThreadPoolPolicy> tiledFaraday;
+    tiledFaraday.setLayout(&layout);
+    tiledFaraday.setTimeStep(0.2);
+    tiledFaraday.setPolicy(ThreadPoolPolicy{std::make_shared<ThreadPool>(4)});
+    tiledFaraday.setTileShape({{3, 4, 5}});
+    tiledFaraday(B, E, Bnew);
+
+    EXPECT_EQ(expected[0], std::vector<double>(std::begin(Bxnew), std::end(Bxnew)));
+    EXPECT_EQ(expected[1], std::vector<double>(std::begin(Bynew), std::end(Bynew)));
+    EXPECT_EQ(expected[2], std::vector<double>(std::begin(Bznew), std::end(Bznew)));
+    EXPECT_ANY_THROW(tiledFaraday.setTileShape({{3, 0, 5}}));
+}
+
+
+
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
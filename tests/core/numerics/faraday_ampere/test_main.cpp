@@ -0,0 +1,229 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "data/field/field.h"
+#include "data/grid/gridlayout.h"
+#include "data/grid/gridlayout_impl.h"
+#include "data/ndarray/ndarray_vector.h"
+#include "data/vecfield/vecfield.h"
+#include "hybrid/hybrid_quantities.h"
+#include "numerics/ampere/ampere.h"
+#include "numerics/faraday/faraday.h"
+#include "numerics/faraday_ampere/faraday_ampere.h"
+
+
+using namespace PHARE;
+
+
+
+template<typename GridLayoutImpl>
+class FaradayThenAmpere : public ::testing::Test
+{
+public:
+    static constexpr std::size_t dim = GridLayoutImpl::dimension;
+
+    using GridLayoutT = GridLayout<GridLayoutImpl>;
+    using NdArray     = std::conditional_t<
+        dim == 1, NdArrayVector1D<>,
+        std::conditional_t<dim == 2, NdArrayVector2D<>, NdArrayVector3D<>>>;
+    using FieldT    = Field<NdArray, HybridQuantity::Scalar>;
+    using VecFieldT = VecField<NdArray, HybridQuantity>;
+
+
+    GridLayoutT layout{meshSize(), nbrCells(), Point<double, dim>{}};
+    std::vector<std::unique_ptr<FieldT>> fields;
+
+    VecFieldT B{"B", HybridQuantity::Vector::B};
+    VecFieldT E{"E", HybridQuantity::Vector::E};
+    VecFieldT BnewRef{"BnewRef", HybridQuantity::Vector::B};
+    VecFieldT JRef{"JRef", HybridQuantity::Vector::J};
+    VecFieldT Bnew{"Bnew", HybridQuantity::Vector::B};
+    VecFieldT J{"J", HybridQuantity::Vector::J};
+
+    Faraday<GridLayoutT> faraday;
+    Ampere<GridLayoutT> ampere;
+    FaradayAmpere<GridLayoutT> faradayAmpere;
+
+
+    static std::array<double, dim> meshSize()
+    {
+        std::array<double, dim> meshSize;
+        for (auto iDir = 0u; iDir < dim; ++iDir)
+        {
+            meshSize[iDir] = 0.1 * (iDir + 1);
+        }
+        return meshSize;
+    }
+
+    static std::array<uint32, dim> nbrCells()
+    {
+        std::array<uint32, dim> nbrCells;
+        for (auto iDir = 0u; iDir < dim; ++iDir)
+        {
+            nbrCells[iDir] = 11 - 3 * iDir;
+        }
+        return nbrCells;
+    }
+
+
+    /** allocates the components of the vecfield with random values, the same for the
+     * vecfields with the same seed. Ghost nodes of Bnew and BnewRef get the same values, as
+     * if they had been filled by the messengers.
+     */
+    void allocate(VecFieldT& vecfield, uint32 seed)
+    {
+        std::mt19937 valueGen{seed};
+        std::uniform_real_distribution<double> value(-1., 1.);
+
+        for (auto const& property : vecfield.getFieldNamesAndQuantities())
+        {
+            fields.push_back(std::make_unique<FieldT>(property.name, property.qty,
+                                                      layout.allocSize(property.qty)));
+            std::generate(std::begin(*fields.back()), std::end(*fields.back()),
+                          [&]() { return value(valueGen); });
+            vecfield.setBuffer(property.name, fields.back().get());
+        }
+    }
+
+
+    FaradayThenAmpere()
+    {
+        allocate(B, 1);
+        allocate(E, 2);
+        allocate(BnewRef, 3);
+        allocate(Bnew, 3);
+        allocate(JRef, 4);
+        allocate(J, 4);
+
+        faraday.setLayout(&layout);
+        ampere.setLayout(&layout);
+        faradayAmpere.setLayout(&layout);
+    }
+
+
+    void computeReference()
+    {
+        faraday(B, E, BnewRef);
+        ampere(BnewRef, JRef);
+    }
+
+
+    static std::vector<double> values(VecFieldT const& vecfield)
+    {
+        std::vector<double> values;
+        for (auto component : {Component::X, Component::Y, Component::Z})
+        {
+            auto const& field = vecfield.getComponent(component);
+            values.insert(std::end(values), std::begin(field), std::end(field));
+        }
+        return values;
+    }
+};
+
+
+using LayoutsToTest = ::testing::Types<GridLayoutImplYee<1, 1>, GridLayoutImplYee<2, 1>,
+                                       GridLayoutImplYee<3, 1>, GridLayoutImplYee<3, 2>>;
+
+TYPED_TEST_CASE(FaradayThenAmpere, LayoutsToTest);
+
+
+
+
+TYPED_TEST(FaradayThenAmpere, giveTheSameFieldsAsTheFusedSweep)
+{
+    this->computeReference();
+
+    std::array<uint32, TestFixture::dim> tileShape;
+    tileShape.fill(3);
+    this->faradayAmpere.setTileShape(tileShape);
+
+    this->faradayAmpere(this->B, this->E, this->Bnew, this->J);
+    this->faradayAmpere.completeCurrent(this->Bnew, this->J);
+
+    EXPECT_EQ(this->values(this->BnewRef), this->values(this->Bnew));
+    EXPECT_EQ(this->values(this->JRef), this->values(this->J));
+}
+
+
+
+
+TYPED_TEST(FaradayThenAmpere, giveTheSameFieldsAsTheFusedSweepWithTilesLargerThanThePatch)
+{
+    this->computeReference();
+
+    std::array<uint32, TestFixture::dim> tileShape;
+    tileShape.fill(100);
+    this->faradayAmpere.setTileShape(tileShape);
+
+    this->faradayAmpere(this->B, this->E, this->Bnew, this->J);
+    this->faradayAmpere.completeCurrent(this->Bnew, this->J);
+
+    EXPECT_EQ(this->values(this->BnewRef), this->values(this->Bnew));
+    EXPECT_EQ(this->values(this->JRef), this->values(this->J));
+}
+
+
+
+
+TYPED_TEST(FaradayThenAmpere, giveTheSameFieldsAsTheFusedSweepWithDefaultTiles)
+{
+    this->computeReference();
+
+    this->faradayAmpere(this->B, this->E, this->Bnew, this->J);
+    this->faradayAmpere.completeCurrent(this->Bnew, this->J);
+
+    EXPECT_EQ(this->values(this->BnewRef), this->values(this->Bnew));
+    EXPECT_EQ(this->values(this->JRef), this->values(this->J));
+}
+
+
+
+
+TYPED_TEST(FaradayThenAmpere, giveTheSameCurrentInsideThePatchBeforeItIsCompleted)
+{
+    this->computeReference();
+
+    this->faradayAmpere(this->B, this->E, this->Bnew, this->J);
+
+    // the current on the boundary of the patch is not computed yet
+    EXPECT_NE(this->values(this->JRef), this->values(this->J));
+
+    auto const& Jz    = this->J.getComponent(Component::Z);
+    auto const& JzRef = this->JRef.getComponent(Component::Z);
+
+    std::array<uint32, TestFixture::dim> middle;
+    for (auto iDir = 0u; iDir < TestFixture::dim; ++iDir)
+    {
+        middle[iDir] = this->layout.physicalStartIndex(Jz, static_cast<Direction>(iDir))
+                       + this->nbrCells()[iDir] / 2;
+    }
+    EXPECT_EQ(nodeAt(JzRef, middle), nodeAt(Jz, middle));
+}
+
+
+
+
+TEST(FaradayAmpere, cannotHaveEmptyTiles)
+{
+    FaradayAmpere<GridLayout<GridLayoutImplYee<2, 1>>> faradayAmpere;
+
+    EXPECT_ANY_THROW(faradayAmpere.setTileShape({{4, 0}}));
+}
+
+
+
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
@@ -7,17 +7,26 @@
 #include <cstddef>
 #include <fstream>
 #include <list>
+#include <memory>
 #include <random>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 #include "data/electromag/electromag.h"
+#include "data/electromag/electromag_at_particles.h"
+#include "data/electromag/electromag_gather_cache.h"
 #include "data/field/field.h"
 #include "data/grid/gridlayout_impl.h"
 #include "data/ndarray/ndarray_vector.h"
 #include "data/particles/particle.h"
 #include "data/particles/particle_array.h"
+#include "data/particles/particle_tiles.h"
 #include "data/vecfield/vecfield.h"
 #include "hybrid/hybrid_quantities.h"
+#include "utilities/thread_pool/thread_pool.h"
 #include <numerics/interpolator/interpolator.h>
+#include <numerics/interpolator/parallel_deposit.h>
 
 
 using namespace PHARE;
@@ -84,6 +93,39 @@ TYPED_TEST(AWeighter, ComputesWeightThatSumIsOne)
 
 
 
+TYPED_TEST(AWeighter, computesTheSameStartIndexesAndWeightsForABatchOfParticles)
+{
+    constexpr auto nbrPoints = nbrPointsSupport(TypeParam::interp_order);
+    auto const nbrParticles  = this->normalizedPositions.size();
+
+    std::vector<int> startIndexes(nbrParticles);
+    std::array<std::vector<double>, nbrPoints> batchWeights;
+    std::array<double*, nbrPoints> weightPointers;
+    for (auto ik = 0u; ik < nbrPoints; ++ik)
+    {
+        batchWeights[ik].resize(nbrParticles);
+        weightPointers[ik] = batchWeights[ik].data();
+    }
+
+    this->weighter.computeWeights(this->normalizedPositions.data(), nbrParticles,
+                                  startIndexes.data(), weightPointers);
+
+    for (auto iPart = 0u; iPart < nbrParticles; ++iPart)
+    {
+        auto startIndex
+            = computeStartIndex<TypeParam::interp_order>(this->normalizedPositions[iPart]);
+        ASSERT_EQ(startIndex, startIndexes[iPart]);
+
+        for (auto ik = 0u; ik < nbrPoints; ++ik)
+        {
+            ASSERT_DOUBLE_EQ(this->weights[iPart][ik], batchWeights[ik][iPart]);
+        }
+    }
+}
+
+
+
+
 TEST(Weights, NbrPointsInBSplineSupportIsCorrect)
 {
     EXPECT_EQ(2, nbrPointsSupport(1));
@@ -216,7 +258,7 @@ public:
             ez1d_(ix) = ez0;
         }
 
-        for (auto& part : particles)
+        for (auto&& part : particles)
         {
             part.iCell[0] = 5;
             part.delta[0] = 0.32f;
@@ -244,31 +286,28 @@ TYPED_TEST(A1DInterpolator, canComputeAllEMfieldsAtParticle)
     this->em.B.setBuffer("EM_B_y", &this->by1d_);
     this->em.B.setBuffer("EM_B_z", &this->bz1d_);
 
-    this->interp(std::begin(this->particles), std::end(this->particles), this->em);
+    ElectromagAtParticles emAtParticles(this->particles.size());
 
-    EXPECT_TRUE(std::all_of(
-        std::begin(this->particles), std::end(this->particles),
-        [this](Particle<1> const& part) { return std::abs(part.Ex - this->ex0) < 1e-8; }));
+    this->interp(std::begin(this->particles), std::end(this->particles), this->em,
+                 emAtParticles);
 
-    EXPECT_TRUE(std::all_of(
-        std::begin(this->particles), std::end(this->particles),
-        [this](Particle<1> const& part) { return std::abs(part.Ey - this->ey0) < 1e-8; }));
+    EXPECT_TRUE(std::all_of(std::begin(emAtParticles.Ex), std::end(emAtParticles.Ex),
+                            [this](double ex) { return std::abs(ex - this->ex0) < 1e-8; }));
 
-    EXPECT_TRUE(std::all_of(
-        std::begin(this->particles), std::end(this->particles),
-        [this](Particle<1> const& part) { return std::abs(part.Ez - this->ez0) < 1e-8; }));
+    EXPECT_TRUE(std::all_of(std::begin(emAtParticles.Ey), std::end(emAtParticles.Ey),
+                            [this](double ey) { return std::abs(ey - this->ey0) < 1e-8; }));
 
-    EXPECT_TRUE(std::all_of(
-        std::begin(this->particles), std::end(this->particles),
-        [this](Particle<1> const& part) { return std::abs(part.Bx - this->bx0) < 1e-8; }));
+    EXPECT_TRUE(std::all_of(std::begin(emAtParticles.Ez), std::end(emAtParticles.Ez),
+                            [this](double ez) { return std::abs(ez - this->ez0) < 1e-8; }));
 
-    EXPECT_TRUE(std::all_of(
-        std::begin(this->particles), std::end(this->particles),
-        [this](Particle<1> const& part) { return std::abs(part.By - this->by0) < 1e-8; }));
+    EXPECT_TRUE(std::all_of(std::begin(emAtParticles.Bx), std::end(emAtParticles.Bx),
+                            [this](double bx) { return std::abs(bx - this->bx0) < 1e-8; }));
 
-    EXPECT_TRUE(std::all_of(
-        std::begin(this->particles), std::end(this->particles),
-        [this](Particle<1> const& part) { return std::abs(part.Bz - this->bz0) < 1e-8; }));
+    EXPECT_TRUE(std::all_of(std::begin(emAtParticles.By), std::end(emAtParticles.By),
+                            [this](double by) { return std::abs(by - this->by0) < 1e-8; }));
+
+    EXPECT_TRUE(std::all_of(std::begin(emAtParticles.Bz), std::end(emAtParticles.Bz),
+                            [this](double bz) { return std::abs(bz - this->bz0) < 1e-8; }));
 
 
     this->em.E.setBuffer("EM_E_x", nullptr);
@@ -332,7 +371,7 @@ public:
             }
         }
 
-        for (auto& part : particles)
+        for (auto&& part : particles)
         {
             part.iCell[0] = 5;
             part.delta[0] = 0.32f;
@@ -360,31 +399,28 @@ TYPED_TEST(A2DInterpolator, canComputeAllEMfieldsAtParticle)
     this->em.B.setBuffer("EM_B_y", &this->by_);
     this->em.B.setBuffer("EM_B_z", &this->bz_);
 
-    this->interp(std::begin(this->particles), std::end(this->particles), this->em);
+    ElectromagAtParticles emAtParticles(this->particles.size());
+
+    this->interp(std::begin(this->particles), std::end(this->particles), this->em,
+                 emAtParticles);
 
-    EXPECT_TRUE(std::all_of(
-        std::begin(this->particles), std::end(this->particles),
-        [this](Particle<2> const& part) { return std::abs(part.Ex - this->ex0) < 1e-8; }));
+    EXPECT_TRUE(std::all_of(std::begin(emAtParticles.Ex), std::end(emAtParticles.Ex),
+                            [this](double ex) { return std::abs(ex - this->ex0) < 1e-8; }));
 
-    EXPECT_TRUE(std::all_of(
-        std::begin(this->particles), std::end(this->particles),
-        [this](Particle<2> const& part) { return std::abs(part.Ey - this->ey0) < 1e-8; }));
+    EXPECT_TRUE(std::all_of(std::begin(emAtParticles.Ey), std::end(emAtParticles.Ey),
+                            [this](double ey) { return std::abs(ey - this->ey0) < 1e-8; }));
 
-    EXPECT_TRUE(std::all_of(
-        std::begin(this->particles), std::end(this->particles),
-        [this](Particle<2> const& part) { return std::abs(part.Ez - this->ez0) < 1e-8; }));
+    EXPECT_TRUE(std::all_of(std::begin(emAtParticles.Ez), std::end(emAtParticles.Ez),
+                            [this](double ez) { return std::abs(ez - this->ez0) < 1e-8; }));
 
-    EXPECT_TRUE(std::all_of(
-        std::begin(this->particles), std::end(this->particles),
-        [this](Particle<2> const& part) { return std::abs(part.Bx - this->bx0) < 1e-8; }));
+    EXPECT_TRUE(std::all_of(std::begin(emAtParticles.Bx), std::end(emAtParticles.Bx),
+                            [this](double bx) { return std::abs(bx - this->bx0) < 1e-8; }));
 
-    EXPECT_TRUE(std::all_of(
-        std::begin(this->particles), std::end(this->particles),
-        [this](Particle<2> const& part) { return std::abs(part.By - this->by0) < 1e-8; }));
+    EXPECT_TRUE(std::all_of(std::begin(emAtParticles.By), std::end(emAtParticles.By),
+                            [this](double by) { return std::abs(by - this->by0) < 1e-8; }));
 
-    EXPECT_TRUE(std::all_of(
-        std::begin(this->particles), std::end(this->particles),
-        [this](Particle<2> const& part) { return std::abs(part.Bz - this->bz0) < 1e-8; }));
+    EXPECT_TRUE(std::all_of(std::begin(emAtParticles.Bz), std::end(emAtParticles.Bz),
+                            [this](double bz) { return std::abs(bz - this->bz0) < 1e-8; }));
 
 
     this->em.E.setBuffer("EM_E_x", nullptr);
@@ -452,7 +488,7 @@ public:
             }
         }
 
-        for (auto& part : particles)
+        for (auto&& part : particles)
         {
             part.iCell[0] = 5;
             part.delta[0] = 0.32f;
@@ -480,31 +516,28 @@ TYPED_TEST(A3DInterpolator, canComputeAllEMfieldsAtParticle)
     this->em.B.setBuffer("EM_B_y", &this->by_);
     this->em.B.setBuffer("EM_B_z", &this->bz_);
 
-    this->interp(std::begin(this->particles), std::end(this->particles), this->em);
+    ElectromagAtParticles emAtParticles(this->particles.size());
 
-    EXPECT_TRUE(std::all_of(
-        std::begin(this->particles), std::end(this->particles),
-        [this](Particle<3> const& part) { return std::abs(part.Ex - this->ex0) < 1e-8; }));
+    this->interp(std::begin(this->particles), std::end(this->particles), this->em,
+                 emAtParticles);
 
-    EXPECT_TRUE(std::all_of(
-        std::begin(this->particles), std::end(this->particles),
-        [this](Particle<3> const& part) { return std::abs(part.Ey - this->ey0) < 1e-8; }));
+    EXPECT_TRUE(std::all_of(std::begin(emAtParticles.Ex), std::end(emAtParticles.Ex),
+                            [this](double ex) { return std::abs(ex - this->ex0) < 1e-8; }));
 
-    EXPECT_TRUE(std::all_of(
-        std::begin(this->particles), std::end(this->particles),
-        [this](Particle<3> const& part) { return std::abs(part.Ez - this->ez0) < 1e-8; }));
+    EXPECT_TRUE(std::all_of(std::begin(emAtParticles.Ey), std::end(emAtParticles.Ey),
+                            [this](double ey) { return std::abs(ey - this->ey0) < 1e-8; }));
 
-    EXPECT_TRUE(std::all_of(
-        std::begin(this->particles), std::end(this->particles),
-        [this](Particle<3> const& part) { return std::abs(part.Bx - this->bx0) < 1e-8; }));
+    EXPECT_TRUE(std::all_of(std::begin(emAtParticles.Ez), std::end(emAtParticles.Ez),
+                            [this](double ez) { return std::abs(ez - this->ez0) < 1e-8; }));
 
-    EXPECT_TRUE(std::all_of(
-        std::begin(this->particles), std::end(this->particles),
-        [this](Particle<3> const& part) { return std::abs(part.By - this->by0) < 1e-8; }));
+    EXPECT_TRUE(std::all_of(std::begin(emAtParticles.Bx), std::end(emAtParticles.Bx),
+                            [this](double bx) { return std::abs(bx - this->bx0) < 1e-8; }));
 
-    EXPECT_TRUE(std::all_of(
-        std::begin(this->particles), std::end(this->particles),
-        [this](Particle<3> const& part) { return std::abs(part.Bz - this->bz0) < 1e-8; }));
+    EXPECT_TRUE(std::all_of(std::begin(emAtParticles.By), std::end(emAtParticles.By),
+                            [this](double by) { return std::abs(by - this->by0) < 1e-8; }));
+
+    EXPECT_TRUE(std::all_of(std::begin(emAtParticles.Bz), std::end(emAtParticles.Bz),
+                            [this](double bz) { return std::abs(bz - this->bz0) < 1e-8; }));
 
 
     this->em.E.setBuffer("EM_E_x", nullptr);
@@ -517,6 +550,178 @@ TYPED_TEST(A3DInterpolator, canComputeAllEMfieldsAtParticle)
 
 
 
+// fills the six fields of the fixture with values that differ at each node and for each
+// component, places particles all over the fields, and sets the fields on the Electromag
+template<typename Fixture>
+void setVaryingFieldsAndParticles(Fixture& fixture)
+{
+    auto fields = std::array<decltype(&fixture.ex_), 6>{
+        {&fixture.ex_, &fixture.ey_, &fixture.ez_, &fixture.bx_, &fixture.by_, &fixture.bz_}};
+
+    for (auto iField = 0u; iField < fields.size(); ++iField)
+    {
+        auto& field = *fields[iField];
+        auto index  = 0u;
+        for (auto& value : field)
+        {
+            value = iField + std::sin(0.1 * index++);
+        }
+    }
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> cell(5, 40);
+    std::uniform_real_distribution<float> delta(0, 1);
+
+    fixture.particles.resize(100);
+    for (auto&& part : fixture.particles)
+    {
+        for (auto iDim = 0u; iDim < part.iCell.size(); ++iDim)
+        {
+            part.iCell[iDim] = cell(gen);
+            part.delta[iDim] = delta(gen);
+        }
+    }
+
+    fixture.em.E.setBuffer("EM_E_x", &fixture.ex_);
+    fixture.em.E.setBuffer("EM_E_y", &fixture.ey_);
+    fixture.em.E.setBuffer("EM_E_z", &fixture.ez_);
+    fixture.em.B.setBuffer("EM_B_x", &fixture.bx_);
+    fixture.em.B.setBuffer("EM_B_y", &fixture.by_);
+    fixture.em.B.setBuffer("EM_B_z", &fixture.bz_);
+}
+
+
+
+// the cache holds the same values as the fields, and they are read in the same order
+// so the interpolated fields must be exactly the same
+template<typename Fixture>
+void expectTheSameFieldsFromTheGatherCache(Fixture& fixture)
+{
+    setVaryingFieldsAndParticles(fixture);
+
+    auto const nbrParticles = fixture.particles.size();
+    ElectromagAtParticles fromFields(nbrParticles);
+    ElectromagAtParticles fromCache(nbrParticles);
+
+    fixture.interp(std::begin(fixture.particles), std::end(fixture.particles), fixture.em,
+                   fromFields);
+
+    ElectromagGatherCache<std::decay_t<decltype(fixture.particles)>::dimension> cache;
+    cache.update(fixture.em);
+    fixture.interp.gather(std::begin(fixture.particles), std::end(fixture.particles), cache,
+                          fromCache);
+
+    EXPECT_EQ(fromFields.Ex, fromCache.Ex);
+    EXPECT_EQ(fromFields.Ey, fromCache.Ey);
+    EXPECT_EQ(fromFields.Ez, fromCache.Ez);
+    EXPECT_EQ(fromFields.Bx, fromCache.Bx);
+    EXPECT_EQ(fromFields.By, fromCache.By);
+    EXPECT_EQ(fromFields.Bz, fromCache.Bz);
+}
+
+
+
+TYPED_TEST(A2DInterpolator, givesTheSameFieldsFromTheGatherCache)
+{
+    expectTheSameFieldsFromTheGatherCache(*this);
+}
+
+
+
+TYPED_TEST(A3DInterpolator, givesTheSameFieldsFromTheGatherCache)
+{
+    expectTheSameFieldsFromTheGatherCache(*this);
+}
+
+
+
+TYPED_TEST(A3DInterpolator, readsTheCachedFieldsUntilTheCacheIsUpdated)
+{
+    setVaryingFieldsAndParticles(*this);
+
+    ElectromagGatherCache<3> cache;
+    cache.update(this->em);
+
+    Field<NdArrayVector3D<>, typename HybridQuantity::Scalar> otherBz{
+        "field", HybridQuantity::Scalar::Bz, this->nx, this->ny, this->nz};
+    for (auto& value : otherBz)
+    {
+        value = -1.;
+    }
+    this->em.B.setBuffer("EM_B_z", &otherBz);
+
+    ElectromagAtParticles fromCache(this->particles.size());
+    ElectromagAtParticles fromFields(this->particles.size());
+    ElectromagAtParticles fromUpdatedCache(this->particles.size());
+
+    this->interp.gather(std::begin(this->particles), std::end(this->particles), cache, fromCache);
+    this->interp(std::begin(this->particles), std::end(this->particles), this->em, fromFields);
+
+    cache.update(this->em);
+    this->interp.gather(std::begin(this->particles), std::end(this->particles), cache,
+                        fromUpdatedCache);
+
+    auto isMinusOne = [](double bz) { return std::abs(bz + 1.) < 1e-12; };
+
+    EXPECT_TRUE(std::all_of(std::begin(fromCache.Bz), std::end(fromCache.Bz),
+                            [](double bz) { return bz > 0.; }));
+    EXPECT_TRUE(std::all_of(std::begin(fromFields.Bz), std::end(fromFields.Bz), isMinusOne));
+    EXPECT_TRUE(
+        std::all_of(std::begin(fromUpdatedCache.Bz), std::end(fromUpdatedCache.Bz), isMinusOne));
+}
+
+
+
+TEST(AnElectromagGatherCache, padsComponentsSmallerThanTheOthersWithZeros)
+{
+    using VF     = VecField<NdArrayVector1D<>, HybridQuantity>;
+    using FieldT = Field<NdArrayVector1D<>, typename HybridQuantity::Scalar>;
+
+    uint32_t const nbrPrimal = 10;
+
+    std::vector<FieldT> fields;
+    for (auto qty : {HybridQuantity::Scalar::Ex, HybridQuantity::Scalar::Ey,
+                     HybridQuantity::Scalar::Ez, HybridQuantity::Scalar::Bx,
+                     HybridQuantity::Scalar::By, HybridQuantity::Scalar::Bz})
+    {
+        // Ex, By and Bz are dual in 1D, they have one node less
+        bool isDual = qty == HybridQuantity::Scalar::Ex || qty == HybridQuantity::Scalar::By
+                      || qty == HybridQuantity::Scalar::Bz;
+        fields.emplace_back("field", qty, isDual ? nbrPrimal - 1 : nbrPrimal);
+    }
+    for (auto iField = 0u; iField < fields.size(); ++iField)
+    {
+        for (auto& value : fields[iField])
+        {
+            value = iField + 1.;
+        }
+    }
+
+    Electromag<VF> em{"EM"};
+    em.E.setBuffer("EM_E_x", &fields[0]);
+    em.E.setBuffer("EM_E_y", &fields[1]);
+    em.E.setBuffer("EM_E_z", &fields[2]);
+    em.B.setBuffer("EM_B_x", &fields[3]);
+    em.B.setBuffer("EM_B_y", &fields[4]);
+    em.B.setBuffer("EM_B_z", &fields[5]);
+
+    ElectromagGatherCache<1> cache;
+    cache.update(em);
+
+    EXPECT_EQ(nbrPrimal, cache.shape()[0]);
+    for (auto iComponent = 0u; iComponent < 6; ++iComponent)
+    {
+        auto const component = cache.component(iComponent);
+        EXPECT_EQ(iComponent + 1., component(0));
+        EXPECT_EQ(iComponent + 1., component(nbrPrimal - 2));
+    }
+    EXPECT_EQ(0., cache.component(0)(nbrPrimal - 1));
+    EXPECT_EQ(2., cache.component(1)(nbrPrimal - 1));
+    EXPECT_EQ(0., cache.component(5)(nbrPrimal - 1));
+}
+
+
+
 template<typename Weighter>
 class ASingleParticle : public ::testing::Test
 {
@@ -773,20 +978,403 @@ protected:
 TYPED_TEST_CASE(ACollectionOfParticles, Weighters);
 
 
+// the deposited moments are exact to the precision of the weights and velocities of the
+// particles, which are single precision with PHARE_MIXED_PRECISION_PARTICLES
+void expectDepositedMoment(double expected, double deposited)
+{
+    using Particles = ParticleArray<1>;
+
+    if constexpr (std::is_same_v<Particles::weight_type, double>
+                  && std::is_same_v<Particles::velocity_type, double>)
+    {
+        EXPECT_DOUBLE_EQ(expected, deposited);
+    }
+    else
+    {
+        EXPECT_FLOAT_EQ(static_cast<float>(expected), static_cast<float>(deposited));
+    }
+}
+
+
 TYPED_TEST(ACollectionOfParticles, DepositCorrectlyTheirWeight)
 {
-    EXPECT_DOUBLE_EQ(this->rho(20), 1.0);
+    expectDepositedMoment(1.0, this->rho(20));
 }
 
 
 TYPED_TEST(ACollectionOfParticles, DepositCorrectlyTheirVelocity)
 {
-    EXPECT_DOUBLE_EQ(this->vx(20), 2.0);
-    EXPECT_DOUBLE_EQ(this->vy(20), -1.0);
-    EXPECT_DOUBLE_EQ(this->vz(20), 1.0);
+    expectDepositedMoment(2.0, this->vx(20));
+    expectDepositedMoment(-1.0, this->vy(20));
+    expectDepositedMoment(1.0, this->vz(20));
+}
+
+
+TYPED_TEST(ACollectionOfParticles, AreDepositedByTheInterpolator)
+{
+    using FieldT = Field<NdArrayVector1D<>, typename HybridQuantity::Scalar>;
+
+    FieldT density{"rho", HybridQuantity::Scalar::rho, this->nx};
+    FieldT fluxX{"flux_x", HybridQuantity::Scalar::Vx, this->nx};
+    FieldT fluxY{"flux_y", HybridQuantity::Scalar::Vy, this->nx};
+    FieldT fluxZ{"flux_z", HybridQuantity::Scalar::Vz, this->nx};
+    VecField<NdArrayVector1D<>, HybridQuantity> flux{"flux", HybridQuantity::Vector::V};
+    flux.setBuffer("flux_x", &fluxX);
+    flux.setBuffer("flux_y", &fluxY);
+    flux.setBuffer("flux_z", &fluxZ);
+
+    Interpolator<GridLayoutImplYee<1, TypeParam::interp_order>> interpolator;
+    interpolator(std::begin(this->particles), std::end(this->particles), density, flux);
+
+    for (auto ix = 0u; ix < this->nx; ++ix)
+    {
+        EXPECT_DOUBLE_EQ(this->rho(ix), density(ix));
+        EXPECT_DOUBLE_EQ(this->vx(ix), fluxX(ix));
+        EXPECT_DOUBLE_EQ(this->vy(ix), fluxY(ix));
+        EXPECT_DOUBLE_EQ(this->vz(ix), fluxZ(ix));
+    }
+}
+
+
+
+template<typename Precision>
+auto depositedMoments(std::size_t nbrNodes, std::size_t nbrParticles)
+{
+    using FieldT = Field<NdArrayVector1D<>, typename HybridQuantity::Scalar>;
+
+    ParticleArray<1, false, Precision> particles;
+    for (auto iPart = 0; iPart < static_cast<int>(nbrParticles); ++iPart)
+    {
+        Particle<1, DoublePrecision> particle{1. / 3. + 1e-3 * iPart,
+                                              {{5 + iPart % 10}},
+                                              {{static_cast<float>(iPart % 7) / 7.f}},
+                                              {{0.1 + std::sin(iPart), std::cos(iPart), 1e-2}}};
+        particles.push_back(particle);
+    }
+
+    auto rho   = std::make_unique<FieldT>("rho", HybridQuantity::Scalar::rho, nbrNodes);
+    auto fluxX = std::make_unique<FieldT>("flux_x", HybridQuantity::Scalar::Vx, nbrNodes);
+    auto fluxY = std::make_unique<FieldT>("flux_y", HybridQuantity::Scalar::Vy, nbrNodes);
+    auto fluxZ = std::make_unique<FieldT>("flux_z", HybridQuantity::Scalar::Vz, nbrNodes);
+    VecField<NdArrayVector1D<>, HybridQuantity> flux{"flux", HybridQuantity::Vector::V};
+    flux.setBuffer("flux_x", fluxX.get());
+    flux.setBuffer("flux_y", fluxY.get());
+    flux.setBuffer("flux_z", fluxZ.get());
+
+    Interpolator<GridLayoutImplYee<1, 1>> interpolator;
+    interpolator(std::begin(particles), std::end(particles), *rho, flux);
+
+    return std::make_tuple(std::move(rho), std::move(fluxX), std::move(fluxY), std::move(fluxZ));
+}
+
+
+TEST(AMixedPrecisionParticleArray, isDepositedCloseToTheDoublePrecisionOne)
+{
+    std::size_t const nbrNodes = 25;
+
+    auto [doubleRho, doubleFluxX, doubleFluxY, doubleFluxZ]
+        = depositedMoments<DoublePrecision>(nbrNodes, 1000);
+    auto [mixedRho, mixedFluxX, mixedFluxY, mixedFluxZ]
+        = depositedMoments<MixedPrecision>(nbrNodes, 1000);
+
+    for (auto ix = 0u; ix < nbrNodes; ++ix)
+    {
+        auto const tolerance = 1e-6 * (*doubleRho)(ix);
+
+        EXPECT_NEAR((*doubleRho)(ix), (*mixedRho)(ix), tolerance);
+        EXPECT_NEAR((*doubleFluxX)(ix), (*mixedFluxX)(ix), tolerance);
+        EXPECT_NEAR((*doubleFluxY)(ix), (*mixedFluxY)(ix), tolerance);
+        EXPECT_NEAR((*doubleFluxZ)(ix), (*mixedFluxZ)(ix), tolerance);
+    }
+}
+
+
+
+
+template<typename GridLayout>
+class ACellSortedDeposit : public ::testing::Test
+{
+public:
+    static constexpr std::size_t dim = GridLayout::dimension;
+    static constexpr uint32_t nbrNodes = 20;
+
+    using Grid = std::conditional_t<dim == 1, NdArrayVector1D<>,
+                                    std::conditional_t<dim == 2, NdArrayVector2D<>,
+                                                       NdArrayVector3D<>>>;
+
+    ParticleArray<dim> particles;
+    Interpolator<GridLayout> interpolator;
+
+    ACellSortedDeposit()
+    {
+        std::mt19937 gen(2718);
+        std::uniform_int_distribution<int> cell(3, 15);
+        std::uniform_real_distribution<float> delta(0.f, 1.f);
+        std::uniform_real_distribution<double> value(-1., 1.);
+
+        std::vector<Particle<dim>> sorted(2000);
+        for (auto& particle : sorted)
+        {
+            particle.weight = 1. + value(gen);
+            for (auto iDim = 0u; iDim < dim; ++iDim)
+            {
+                particle.iCell[iDim] = cell(gen);
+                particle.delta[iDim] = delta(gen);
+            }
+            particle.v = {{value(gen), value(gen), value(gen)}};
+        }
+        std::sort(std::begin(sorted), std::end(sorted),
+                  [](auto const& a, auto const& b) { return a.iCell < b.iCell; });
+
+        for (auto const& particle : sorted)
+        {
+            particles.push_back(particle);
+        }
+    }
+
+    std::array<Grid, 4> makeGrids() const
+    {
+        std::array<uint32_t, dim> shape;
+        shape.fill(nbrNodes);
+        return {{Grid{shape}, Grid{shape}, Grid{shape}, Grid{shape}}};
+    }
+};
+
+
+using CellSortedDepositLayouts
+    = ::testing::Types<GridLayoutImplYee<1, 1>, GridLayoutImplYee<1, 3>, GridLayoutImplYee<2, 2>,
+                       GridLayoutImplYee<3, 1>, GridLayoutImplYee<3, 2>, GridLayoutImplYee<3, 3>>;
+
+TYPED_TEST_CASE(ACellSortedDeposit, CellSortedDepositLayouts);
+
+
+
+TYPED_TEST(ACellSortedDeposit, givesTheSameMomentsAsTheParticleDeposit)
+{
+    auto expected = this->makeGrids();
+    auto byCell   = this->makeGrids();
+
+    auto& sorted = this->particles;
+    this->interpolator.deposit(std::begin(sorted), std::end(sorted), expected[0], expected[1],
+                               expected[2], expected[3]);
+    this->interpolator.depositByCell(std::begin(sorted), std::end(sorted), byCell[0], byCell[1],
+                                     byCell[2], byCell[3]);
+
+    for (auto iQty = 0u; iQty < 4u; ++iQty)
+    {
+        auto node = std::begin(byCell[iQty]);
+        for (auto value : expected[iQty])
+        {
+            EXPECT_NEAR(value, *node++, 1e-12);
+        }
+    }
+}
+
+
+
+TYPED_TEST(ACellSortedDeposit, alsoDepositsParticlesThatAreNotSorted)
+{
+    auto& unsorted = this->particles;
+    std::reverse(std::begin(unsorted), std::end(unsorted));
+    swap(unsorted[0], unsorted[unsorted.size() / 2]);
+
+    auto expected = this->makeGrids();
+    auto byCell   = this->makeGrids();
+
+    this->interpolator.deposit(std::begin(unsorted), std::end(unsorted), expected[0], expected[1],
+                               expected[2], expected[3]);
+    this->interpolator.depositByCell(std::begin(unsorted), std::end(unsorted), byCell[0], byCell[1],
+                                     byCell[2], byCell[3]);
+
+    auto node = std::begin(byCell[0]);
+    for (auto value : expected[0])
+    {
+        EXPECT_NEAR(value, *node++, 1e-12);
+    }
 }
 
 
+
+
+// density and flux fields of a 2D patch, with their VecField
+struct Moments2D
+{
+    using FieldT = Field<NdArrayVector2D<>, typename HybridQuantity::Scalar>;
+
+    static constexpr uint32_t nx = 36;
+    static constexpr uint32_t ny = 36;
+
+    FieldT rho{"rho", HybridQuantity::Scalar::rho, nx, ny};
+    FieldT vx{"flux_x", HybridQuantity::Scalar::Vx, nx, ny};
+    FieldT vy{"flux_y", HybridQuantity::Scalar::Vy, nx, ny};
+    FieldT vz{"flux_z", HybridQuantity::Scalar::Vz, nx, ny};
+    VecField<NdArrayVector2D<>, HybridQuantity> flux{"flux", HybridQuantity::Vector::V};
+
+    Moments2D()
+    {
+        flux.setBuffer("flux_x", &vx);
+        flux.setBuffer("flux_y", &vy);
+        flux.setBuffer("flux_z", &vz);
+    }
+
+    std::array<FieldT const*, 4> fields() const { return {{&rho, &vx, &vy, &vz}}; }
+};
+
+
+
+
+class AParallelDeposit : public ::testing::Test
+{
+public:
+    using GridLayoutT = GridLayoutImplYee<2, 3>;
+
+    // tiles of 4x4 cells cover the cells [2, 30[, some particles are in cells 30 and 31
+    ParticleTiles<ParticleArray<2>> tiles{Box<int, 2>{Point<int, 2>{2, 2}, Point<int, 2>{30, 30}},
+                                          {{4, 4}}};
+    ParticleArray<2> particles;
+    Moments2D expected;
+
+    AParallelDeposit()
+    {
+        std::mt19937 gen(4321);
+        std::uniform_int_distribution<int> cell(2, 31);
+        std::uniform_real_distribution<float> delta(0.f, 1.f);
+        std::uniform_real_distribution<double> value(-1., 1.);
+
+        for (auto iPart = 0u; iPart < 10000u; ++iPart)
+        {
+            Particle<2> particle;
+            particle.weight = 1. + value(gen);
+            particle.iCell  = {{cell(gen), cell(gen)}};
+            particle.delta  = {{delta(gen), delta(gen)}};
+            particle.v      = {{value(gen), value(gen), value(gen)}};
+
+            particles.push_back(particle);
+            tiles.push_back(particle);
+        }
+
+        Interpolator<GridLayoutT> interpolator;
+        interpolator(std::begin(particles), std::end(particles), expected.rho, expected.flux);
+    }
+
+
+    void expectNearExpected(Moments2D const& moments)
+    {
+        for (auto iQty = 0u; iQty < 4u; ++iQty)
+        {
+            auto const& field         = *moments.fields()[iQty];
+            auto const& expectedField = *expected.fields()[iQty];
+
+            for (auto ix = 0u; ix < Moments2D::nx; ++ix)
+            {
+                for (auto iy = 0u; iy < Moments2D::ny; ++iy)
+                {
+                    EXPECT_NEAR(expectedField(ix, iy), field(ix, iy), 1e-12);
+                }
+            }
+        }
+    }
+
+
+    static bool areEqual(Moments2D const& moments, Moments2D const& others)
+    {
+        for (auto iQty = 0u; iQty < 4u; ++iQty)
+        {
+            auto const& field = *moments.fields()[iQty];
+            auto const& other = *others.fields()[iQty];
+            if (!std::equal(std::begin(field), std::end(field), std::begin(other)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+
+
+TEST_F(AParallelDeposit, depositsAsTheInterpolatorWithPrivateGrids)
+{
+    ParallelDeposit<GridLayoutT> deposit{std::make_shared<ThreadPool>(4)};
+    deposit.setStrategy(DepositStrategy::PrivateGrids);
+
+    Moments2D fromArray;
+    deposit(particles, fromArray.rho, fromArray.flux);
+    expectNearExpected(fromArray);
+
+    Moments2D fromTiles;
+    deposit(tiles, fromTiles.rho, fromTiles.flux);
+    expectNearExpected(fromTiles);
+}
+
+
+
+TEST_F(AParallelDeposit, depositsAsTheInterpolatorWithTileColoring)
+{
+    ParallelDeposit<GridLayoutT> deposit{std::make_shared<ThreadPool>(4)};
+    deposit.setStrategy(DepositStrategy::TileColoring);
+
+    Moments2D moments;
+    deposit(tiles, moments.rho, moments.flux);
+    expectNearExpected(moments);
+}
+
+
+
+TEST_F(AParallelDeposit, givesTheSameFieldsWhateverTheNumberOfThreads)
+{
+    for (auto strategy : {DepositStrategy::PrivateGrids, DepositStrategy::TileColoring})
+    {
+        ParallelDeposit<GridLayoutT> serialDeposit{nullptr};
+        ParallelDeposit<GridLayoutT> threadedDeposit{std::make_shared<ThreadPool>(3)};
+        serialDeposit.setStrategy(strategy);
+        threadedDeposit.setStrategy(strategy);
+
+        Moments2D serial;
+        Moments2D threaded;
+        serialDeposit(tiles, serial.rho, serial.flux);
+        threadedDeposit(tiles, threaded.rho, threaded.flux);
+
+        EXPECT_TRUE(areEqual(serial, threaded));
+    }
+}
+
+
+
+TEST_F(AParallelDeposit, choosesTileColoringForLargePatches)
+{
+    ParallelDeposit<GridLayoutT> automatic{nullptr};
+    ParallelDeposit<GridLayoutT> coloring{nullptr};
+    coloring.setStrategy(DepositStrategy::TileColoring);
+
+    // the 28x28 cells of the tiles are above the threshold
+    automatic.setTileColoringMinCells(28 * 28);
+
+    Moments2D fromAutomatic;
+    Moments2D fromColoring;
+    automatic(tiles, fromAutomatic.rho, fromAutomatic.flux);
+    coloring(tiles, fromColoring.rho, fromColoring.flux);
+
+    EXPECT_TRUE(areEqual(fromAutomatic, fromColoring));
+}
+
+
+
+TEST_F(AParallelDeposit, cannotColorTilesSmallerThanTheSupportOfTheParticles)
+{
+    ParticleTiles<ParticleArray<2>> smallTiles{
+        Box<int, 2>{Point<int, 2>{2, 2}, Point<int, 2>{30, 30}}, {{3, 4}}};
+
+    ParallelDeposit<GridLayoutT> deposit{nullptr};
+    deposit.setStrategy(DepositStrategy::TileColoring);
+
+    Moments2D moments;
+    EXPECT_ANY_THROW(deposit(smallTiles, moments.rho, moments.flux));
+}
+
+
+
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
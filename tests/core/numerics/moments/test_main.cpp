@@ -0,0 +1,226 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "data/field/field.h"
+#include "data/grid/gridlayout_impl.h"
+#include "data/ions/ion_initializer.h"
+#include "data/ions/ion_population/ion_population.h"
+#include "data/ions/ions.h"
+#include "data/ndarray/ndarray_vector.h"
+#include "data/particles/particle_array.h"
+#include "data/vecfield/vecfield.h"
+#include "hybrid/hybrid_quantities.h"
+#include "numerics/interpolator/interpolator.h"
+#include "numerics/moments/moments.h"
+
+
+using namespace PHARE;
+
+using GridLayoutT   = GridLayoutImplYee<1, 2>;
+using VecField1D    = VecField<NdArrayVector1D<>, HybridQuantity>;
+using Field1D       = Field<NdArrayVector1D<>, HybridQuantity::Scalar>;
+using Population    = IonPopulation<ParticleArray<1>, VecField1D>;
+using IonsT         = Ions<Population, GridLayoutT>;
+
+
+
+class IonMomentsOfTwoPopulations : public ::testing::Test
+{
+public:
+    static constexpr uint32 nx = 30;
+
+    IonsT ions{createInitializer()};
+    std::vector<std::unique_ptr<Field1D>> fields;
+    std::vector<std::array<ParticleArray<1>, 3>> particles;
+    std::vector<ParticlesPack<ParticleArray<1>>> packs;
+
+    IonMoments<GridLayoutT> ionMoments;
+
+
+    static IonsInitializer<ParticleArray<1>, GridLayoutT> createInitializer()
+    {
+        IonsInitializer<ParticleArray<1>, GridLayoutT> initializer;
+
+        initializer.name           = "ions";
+        initializer.names          = {"protons", "oxygen"};
+        initializer.masses         = {1., 16.};
+        initializer.charges        = {1., 1.};
+        initializer.subcycling     = {1, 2};
+        initializer.nbrPopulations = 2;
+
+        return initializer;
+    }
+
+
+    template<typename ResourcesUser>
+    void allocate(ResourcesUser& user)
+    {
+        for (auto const& property : user.getFieldNamesAndQuantities())
+        {
+            fields.push_back(std::make_unique<Field1D>(property.name, property.qty, nx));
+            user.setBuffer(property.name, fields.back().get());
+        }
+    }
+
+
+    IonMomentsOfTwoPopulations()
+    {
+        std::mt19937 gen(1234);
+        std::uniform_int_distribution<int> cell(3, 25);
+        std::uniform_real_distribution<float> delta(0.f, 1.f);
+        std::uniform_real_distribution<double> velocity(-1., 1.);
+
+        particles.resize(2);
+        packs.reserve(2);
+        for (auto iPop = 0u; iPop < 2; ++iPop)
+        {
+            for (auto& array : particles[iPop])
+            {
+                for (auto iPart = 0u; iPart < 100u; ++iPart)
+                {
+                    array.push_back(
+                        {0.1, {{cell(gen)}}, {{delta(gen)}}, {{velocity(gen), 0.5, -0.5}}});
+                }
+            }
+            packs.push_back({&particles[iPop][0], &particles[iPop][1], &particles[iPop][2]});
+        }
+
+        allocate(ions);
+        allocate(std::get<0>(ions.getCompileTimeResourcesUserList()));
+        allocate(std::get<1>(ions.getCompileTimeResourcesUserList()));
+
+        auto iPop = 0u;
+        for (auto& pop : ions)
+        {
+            allocate(pop);
+            allocate(std::get<0>(pop.getCompileTimeResourcesUserList()));
+            pop.setBuffer(pop.name(), &packs[iPop++]);
+        }
+    }
+
+
+    // deposits the particles of a population on its own fields, as IonMoments does
+    void depositAlone(Population& pop, Field1D& rho, VecField1D& flux)
+    {
+        Interpolator<GridLayoutT> interpolator;
+        for (auto particleArray :
+             {&pop.domainParticles(), &pop.ghostParticles(), &pop.coarseToFineParticles()})
+        {
+            interpolator(std::begin(*particleArray), std::end(*particleArray), rho, flux);
+        }
+    }
+
+
+    static std::vector<double> values(Field1D const& field)
+    {
+        return std::vector<double>(std::begin(field), std::end(field));
+    }
+};
+
+
+
+
+TEST_F(IonMomentsOfTwoPopulations, sumTheMomentsOfThePopulationsInTheTotalOnes)
+{
+    // oxygen is subcycled, its moments at step 0 are half of those saved before its push,
+    // which are null, and half of the deposited ones
+    ionMoments(ions, 0);
+
+    auto const& rho  = ions.density();
+    auto const& flux = ions.flux();
+
+    for (auto ix = 0u; ix < nx; ++ix)
+    {
+        double expectedRho  = 0.;
+        double expectedFlux = 0.;
+        for (auto const& pop : ions)
+        {
+            expectedRho += pop.momentsWeight(0) * pop.density()(ix);
+            expectedFlux += pop.momentsWeight(0) * pop.flux().getComponent(Component::X)(ix);
+        }
+
+        EXPECT_NEAR(expectedRho, rho(ix), 1e-12);
+        EXPECT_NEAR(expectedFlux, flux.getComponent(Component::X)(ix), 1e-12);
+    }
+}
+
+
+
+
+TEST_F(IonMomentsOfTwoPopulations, giveEachPopulationTheMomentsOfItsParticles)
+{
+    ionMoments(ions, 0);
+
+    for (auto& pop : ions)
+    {
+        Field1D rho{"rho", HybridQuantity::Scalar::rho, nx};
+        Field1D vx{"flux_x", HybridQuantity::Scalar::Vx, nx};
+        Field1D vy{"flux_y", HybridQuantity::Scalar::Vy, nx};
+        Field1D vz{"flux_z", HybridQuantity::Scalar::Vz, nx};
+        VecField1D flux{"flux", HybridQuantity::Vector::V};
+        flux.setBuffer("flux_x", &vx);
+        flux.setBuffer("flux_y", &vy);
+        flux.setBuffer("flux_z", &vz);
+
+        depositAlone(pop, rho, flux);
+
+        EXPECT_EQ(values(rho), values(pop.density()));
+        EXPECT_EQ(values(vx), values(pop.flux().getComponent(Component::X)));
+        EXPECT_EQ(values(vz), values(pop.flux().getComponent(Component::Z)));
+    }
+}
+
+
+
+
+TEST_F(IonMomentsOfTwoPopulations, giveANullBulkVelocityWhereThereIsNoIon)
+{
+    ionMoments(ions, 0);
+    ions.computeBulkVelocity();
+
+    // particles are in cells [3, 25], order 2 deposits from their cell - 1 to their cell + 2
+    EXPECT_DOUBLE_EQ(0., ions.density()(0));
+    EXPECT_DOUBLE_EQ(0., ions.velocity().getComponent(Component::Y)(0));
+    EXPECT_NEAR(0.5, ions.velocity().getComponent(Component::Y)(10), 1e-12);
+}
+
+
+
+
+TEST_F(IonMomentsOfTwoPopulations, doNotDepositSubcycledPopulationsWhenTheyAreNotPushed)
+{
+    ionMoments(ions, 0);
+
+    auto& oxygen              = *std::next(std::begin(ions));
+    auto const oxygenDensity  = values(oxygen.density());
+    auto const protonsDensity = values(std::begin(ions)->density());
+
+    // oxygen particles move, but oxygen is not pushed at step 1
+    for (auto&& particle : oxygen.domainParticles())
+    {
+        particle.delta[0] = 0.5f;
+    }
+    ionMoments(ions, 1);
+
+    EXPECT_EQ(oxygenDensity, values(oxygen.density()));
+    for (auto ix = 0u; ix < nx; ++ix)
+    {
+        EXPECT_NEAR(oxygenDensity[ix] + protonsDensity[ix], ions.density()(ix), 1e-12);
+    }
+}
+
+
+
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
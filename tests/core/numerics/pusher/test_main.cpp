@@ -1,24 +1,34 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include <cmath>
 #include <cstddef>
 #include <fstream>
 #include <iterator>
 #include <memory>
 #include <random>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#include "data/electromag/electromag_at_particles.h"
 #include "data/particles/particle_array.h"
 #include "numerics/boundary_condition/boundary_condition.h"
 #include "numerics/pusher/boris.h"
 #include "numerics/pusher/pusher_factory.h"
 #include "utilities/particle_selector/particle_selector.h"
 #include "utilities/range/range.h"
+#include "utilities/thread_pool/thread_pool.h"
 
 using namespace PHARE;
 
 
+// velocities stored in single precision accumulate more rounding errors over the steps
+// of the trajectories than the reference computed in double precision
+double const trajectoryTolerance
+    = std::is_same_v<Particle<1>::velocity_type, double> ? 1e-5 : 5e-4;
+
+
 struct Trajectory
 {
     std::vector<float> x;
@@ -75,16 +85,66 @@ class Interpolator
 {
 public:
     template<typename PartIterator, typename Electromag>
-    void operator()(PartIterator begin, PartIterator end, Electromag const& em)
+    void operator()(PartIterator begin, PartIterator end, Electromag const& em,
+                    ElectromagAtParticles& emAtParticles)
+    {
+        auto nbrParticles = static_cast<std::size_t>(std::distance(begin, end));
+        for (auto iPart = 0u; iPart < nbrParticles; ++iPart)
+        {
+            emAtParticles.Ex[iPart] = 0.01;
+            emAtParticles.Ey[iPart] = -0.05;
+            emAtParticles.Ez[iPart] = 0.05;
+            emAtParticles.Bx[iPart] = 1.;
+            emAtParticles.By[iPart] = 1.;
+            emAtParticles.Bz[iPart] = 1.;
+        }
+    }
+};
+
+
+// this mock gives each particle of a chunk different fields, which depend on its position
+class VaryingFieldsInterpolator
+{
+public:
+    template<typename PartIterator, typename Electromag>
+    void operator()(PartIterator begin, PartIterator end, Electromag const& em,
+                    ElectromagAtParticles& emAtParticles)
+    {
+        std::size_t iPart = 0;
+        for (auto it = begin; it != end; ++it, ++iPart)
+        {
+            double x                = it->iCell[0] + it->delta[0];
+            emAtParticles.Ex[iPart] = 0.01 * std::cos(x);
+            emAtParticles.Ey[iPart] = -0.05 + 0.001 * x;
+            emAtParticles.Ez[iPart] = 0.05 * std::sin(x);
+            emAtParticles.Bx[iPart] = 1. + 0.1 * std::sin(2 * x);
+            emAtParticles.By[iPart] = 0.5 * std::cos(x);
+            emAtParticles.Bz[iPart] = 1. - 0.01 * x;
+        }
+    }
+};
+
+
+// this mock gives all particles an electric field perpendicular to the magnetic field
+class CrossedFieldsInterpolator
+{
+public:
+    static constexpr double Ex = 0.05, Ey = -0.05, Ez = 0.;
+    static constexpr double Bx = 1., By = 1., Bz = 1.;
+
+    template<typename PartIterator, typename Electromag>
+    void operator()(PartIterator begin, PartIterator end, Electromag const& em,
+                    ElectromagAtParticles& emAtParticles)
     {
-        for (auto currPart = begin; currPart != end; ++currPart)
+        auto nbrParticles = static_cast<std::size_t>(std::distance(begin, end));
+        for (auto iPart = 0u; iPart < nbrParticles; ++iPart)
         {
-            currPart->Ex = 0.01;
-            currPart->Ey = -0.05;
-            currPart->Ez = 0.05;
-            currPart->Bx = 1.;
-            currPart->By = 1.;
-            currPart->Bz = 1.;
+            emAtParticles.Ex[iPart] = Ex;
+            emAtParticles.Ey[iPart] = Ey;
+            emAtParticles.Ez[iPart] = Ez;
+            emAtParticles.Bx[iPart] = Bx;
+            emAtParticles.By[iPart] = By;
+            emAtParticles.Bz[iPart] = Bz;
         }
     }
 };
@@ -122,6 +182,7 @@ public:
               BorisPusher<3, ParticleArray<3>::iterator, Electromag, Interpolator, DummySelector,
                           BoundaryCondition<3, 1>>>()}
         , mass{1}
+        , charge{1}
         , dt{0.0001}
         , tstart{0}
         , tend{10}
@@ -130,10 +191,9 @@ public:
         , yActual(nt)
         , zActual(nt)
     {
-        particlesIn[0].charge = 1;
-        particlesIn[0].iCell  = {{5, 5, 5}}; // arbitrary we don't care
-        particlesIn[0].v      = {{0, 10., 0}};
-        particlesIn[0].delta  = {{0.0, 0.0, 0.0}};
+        particlesIn[0].iCell = {{5, 5, 5}}; // arbitrary we don't care
+        particlesIn[0].v     = {{0, 10., 0}};
+        particlesIn[0].delta = {{0.0, 0.0, 0.0}};
         pusher->setMeshAndTimeStep({{dx, dy, dz}}, dt);
     }
 
@@ -146,6 +206,7 @@ protected:
                                 DummySelector, BoundaryCondition<3, 1>>>
         pusher;
     double mass;
+    double charge;
     double dt;
     double tstart;
     double tend;
@@ -175,6 +236,7 @@ public:
               BorisPusher<2, ParticleArray<2>::iterator, Electromag, Interpolator, DummySelector,
                           BoundaryCondition<2, 1>>>()}
         , mass{1}
+        , charge{1}
         , dt{0.0001}
         , tstart{0}
         , tend{10}
@@ -182,10 +244,9 @@ public:
         , xActual(nt)
         , yActual(nt)
     {
-        particlesIn[0].charge = 1;
-        particlesIn[0].iCell  = {{5, 5}}; // arbitrary we don't care
-        particlesIn[0].v      = {{0, 10., 0}};
-        particlesIn[0].delta  = {{0.0, 0.0}};
+        particlesIn[0].iCell = {{5, 5}}; // arbitrary we don't care
+        particlesIn[0].v     = {{0, 10., 0}};
+        particlesIn[0].delta = {{0.0, 0.0}};
         pusher->setMeshAndTimeStep({{dx, dy}}, dt);
     }
 
@@ -198,6 +259,7 @@ protected:
                                 DummySelector, BoundaryCondition<2, 1>>>
         pusher;
     double mass;
+    double charge;
     double dt;
     double tstart;
     double tend;
@@ -225,16 +287,16 @@ public:
               BorisPusher<1, ParticleArray<1>::iterator, Electromag, Interpolator, DummySelector,
                           BoundaryCondition<1, 1>>>()}
         , mass{1}
+        , charge{1}
         , dt{0.0001}
         , tstart{0}
         , tend{10}
         , nt{static_cast<std::size_t>((tend - tstart) / dt + 1)}
         , xActual(nt)
     {
-        particlesIn[0].charge = 1;
-        particlesIn[0].iCell  = {{5}}; // arbitrary we don't care
-        particlesIn[0].v      = {{0, 10., 0}};
-        particlesIn[0].delta  = {{0.0}};
+        particlesIn[0].iCell = {{5}}; // arbitrary we don't care
+        particlesIn[0].v     = {{0, 10., 0}};
+        particlesIn[0].delta = {{0.0}};
         pusher->setMeshAndTimeStep({{dx}}, dt);
     }
 
@@ -247,6 +309,7 @@ protected:
                                 DummySelector, BoundaryCondition<1, 1>>>
         pusher;
     double mass;
+    double charge;
     double dt;
     double tstart;
     double tend;
@@ -273,14 +336,17 @@ TEST_F(APusher3D, trajectoryIsOk)
         yActual[i] = (particlesOut[0].iCell[1] + particlesOut[0].delta[1]) * static_cast<float>(dy);
         zActual[i] = (particlesOut[0].iCell[2] + particlesOut[0].delta[2]) * static_cast<float>(dz);
 
-        pusher->move(rangeIn, rangeOut, em, mass, interpolator, selector);
+        pusher->move(rangeIn, rangeOut, em, mass, charge, interpolator, selector);
 
         std::copy(rangeOut.begin(), rangeOut.end(), rangeIn.begin());
     }
 
-    EXPECT_THAT(xActual, ::testing::Pointwise(::testing::DoubleNear(1e-5), expectedTrajectory.x));
-    EXPECT_THAT(yActual, ::testing::Pointwise(::testing::DoubleNear(1e-5), expectedTrajectory.y));
-    EXPECT_THAT(zActual, ::testing::Pointwise(::testing::DoubleNear(1e-5), expectedTrajectory.z));
+    EXPECT_THAT(xActual, ::testing::Pointwise(::testing::DoubleNear(trajectoryTolerance),
+                                              expectedTrajectory.x));
+    EXPECT_THAT(yActual, ::testing::Pointwise(::testing::DoubleNear(trajectoryTolerance),
+                                              expectedTrajectory.y));
+    EXPECT_THAT(zActual, ::testing::Pointwise(::testing::DoubleNear(trajectoryTolerance),
+                                              expectedTrajectory.z));
 }
 
 
@@ -297,13 +363,15 @@ TEST_F(APusher2D, trajectoryIsOk)
         xActual[i] = (particlesOut[0].iCell[0] + particlesOut[0].delta[0]) * static_cast<float>(dx);
         yActual[i] = (particlesOut[0].iCell[1] + particlesOut[0].delta[1]) * static_cast<float>(dy);
 
-        pusher->move(rangeIn, rangeOut, em, mass, interpolator, selector);
+        pusher->move(rangeIn, rangeOut, em, mass, charge, interpolator, selector);
 
         std::copy(rangeOut.begin(), rangeOut.end(), rangeIn.begin());
     }
 
-    EXPECT_THAT(xActual, ::testing::Pointwise(::testing::DoubleNear(1e-5), expectedTrajectory.x));
-    EXPECT_THAT(yActual, ::testing::Pointwise(::testing::DoubleNear(1e-5), expectedTrajectory.y));
+    EXPECT_THAT(xActual, ::testing::Pointwise(::testing::DoubleNear(trajectoryTolerance),
+                                              expectedTrajectory.x));
+    EXPECT_THAT(yActual, ::testing::Pointwise(::testing::DoubleNear(trajectoryTolerance),
+                                              expectedTrajectory.y));
 }
 
 
@@ -318,12 +386,44 @@ TEST_F(APusher1D, trajectoryIsOk)
     {
         xActual[i] = (particlesOut[0].iCell[0] + particlesOut[0].delta[0]) * static_cast<float>(dx);
 
-        pusher->move(rangeIn, rangeOut, em, mass, interpolator, selector);
+        pusher->move(rangeIn, rangeOut, em, mass, charge, interpolator, selector);
 
         std::copy(rangeOut.begin(), rangeOut.end(), rangeIn.begin());
     }
 
-    EXPECT_THAT(xActual, ::testing::Pointwise(::testing::DoubleNear(1e-5), expectedTrajectory.x));
+    EXPECT_THAT(xActual, ::testing::Pointwise(::testing::DoubleNear(trajectoryTolerance),
+                                              expectedTrajectory.x));
+}
+
+
+
+// the pusher interpolates and accelerates the particles by chunks
+// pushing more particles than a chunk holds must give each of them
+// the same trajectory as a single particle
+TEST_F(APusher1D, pushesParticlesOfAllChunksTheSameWay)
+{
+    std::size_t const nbrParticles = 2500;
+    ParticleArray<1> manyParticles;
+    for (auto iPart = 0u; iPart < nbrParticles; ++iPart)
+    {
+        manyParticles.push_back(particlesIn[0]);
+    }
+
+    auto rangeOne  = makeRange(std::begin(particlesIn), std::end(particlesIn));
+    auto rangeMany = makeRange(std::begin(manyParticles), std::end(manyParticles));
+
+    for (auto i = 0u; i < 100; ++i)
+    {
+        pusher->move(rangeOne, rangeOne, em, mass, charge, interpolator, selector);
+        pusher->move(rangeMany, rangeMany, em, mass, charge, interpolator, selector);
+    }
+
+    EXPECT_TRUE(std::all_of(std::begin(manyParticles), std::end(manyParticles),
+                            [this](Particle<1> const& part) {
+                                return part.iCell == particlesIn[0].iCell
+                                       && part.delta == particlesIn[0].delta
+                                       && part.v == particlesIn[0].v;
+                            }));
 }
 
 
@@ -343,6 +443,7 @@ public:
               BorisPusher<1, ParticleArray<1>::iterator, Electromag, Interpolator,
                           ParticleSelector<Box<int, 1>>, BoundaryCondition<1, 1>>>()}
         , mass{1}
+        , charge{1}
         , dt{0.0001}
         , tstart{0}
         , tend{10}
@@ -355,12 +456,11 @@ public:
         std::uniform_int_distribution<> dis(0, 1);
         std::uniform_real_distribution<float> delta(0, 1);
 
-        for (auto& part : particlesIn)
+        for (auto&& part : particlesIn)
         {
-            part.charge = 1;
-            part.v      = {{0, 10., 0.}};
-            part.delta  = {{delta(gen)}};
-            part.iCell  = {{dis(gen)}};
+            part.v     = {{0, 10., 0.}};
+            part.delta = {{delta(gen)}};
+            part.iCell = {{dis(gen)}};
         }
         pusher->setMeshAndTimeStep({{dx}}, dt);
     }
@@ -374,6 +474,7 @@ protected:
                                 ParticleSelector<Box<int, 1>>, BoundaryCondition<1, 1>>>
         pusher;
     double mass;
+    double charge;
     double dt;
     double tstart;
     double tend;
@@ -397,7 +498,7 @@ TEST_F(APusherWithLeavingParticles, splitLeavingFromNonLeavingParticles)
 
     for (decltype(nt) i = 0; i < nt; ++i)
     {
-        newEnd = pusher->move(rangeIn, rangeIn, em, mass, interpolator, selector);
+        newEnd = pusher->move(rangeIn, rangeIn, em, mass, charge, interpolator, selector);
         if (newEnd != std::end(particlesIn))
         {
             std::cout << "stopping integration at i = " << i << "\n";
@@ -427,8 +528,10 @@ TEST_F(APusherWithLeavingParticles, pusherWithOrWithingBCReturnsSameNbrOfStaying
 
     for (decltype(nt) i = 0; i < nt; ++i)
     {
-        newEndWithBC    = pusher->move(rangeIn, rangeOut1, em, mass, interpolator, selector, bc);
-        newEndWithoutBC = pusher->move(rangeIn, rangeOut2, em, mass, interpolator, selector);
+        newEndWithBC
+            = pusher->move(rangeIn, rangeOut1, em, mass, charge, interpolator, selector, bc);
+        newEndWithoutBC
+            = pusher->move(rangeIn, rangeOut2, em, mass, charge, interpolator, selector);
         auto s2         = rangeOut2.size();
         auto s1         = rangeOut1.size();
         auto s          = rangeIn.size();
@@ -464,8 +567,10 @@ TEST_F(APusherWithLeavingParticles, pusherWithOrWithingBCReturnsReturnEqualStayi
 
     for (decltype(nt) i = 0; i < nt; ++i)
     {
-        newEndWithBC    = pusher->move(rangeIn, rangeOut1, em, mass, interpolator, selector, bc);
-        newEndWithoutBC = pusher->move(rangeIn, rangeOut2, em, mass, interpolator, selector);
+        newEndWithBC
+            = pusher->move(rangeIn, rangeOut1, em, mass, charge, interpolator, selector, bc);
+        newEndWithoutBC
+            = pusher->move(rangeIn, rangeOut2, em, mass, charge, interpolator, selector);
         auto s2         = rangeOut2.size();
         auto s1         = rangeOut1.size();
         auto s          = rangeIn.size();
@@ -495,6 +600,252 @@ TEST_F(APusherWithLeavingParticles, pusherWithOrWithingBCReturnsReturnEqualStayi
 
 
 
+// particles are numbered with their weight, which the pusher does not change
+// so that their order can be checked after they have been partitioned
+TEST_F(APusherWithLeavingParticles, keepsTheOrderOfParticlesWithAStablePartition)
+{
+    pusher->setPartitionStrategy(PartitionStrategy::Stable);
+
+    for (auto iPart = 0u; iPart < particlesIn.size(); ++iPart)
+    {
+        particlesIn[iPart].weight = iPart;
+    }
+
+    auto rangeIn = makeRange(std::begin(particlesIn), std::end(particlesIn));
+    auto newEnd  = std::end(particlesIn);
+
+    for (decltype(nt) i = 0; i < nt && newEnd == std::end(particlesIn); ++i)
+    {
+        newEnd = pusher->move(rangeIn, rangeIn, em, mass, charge, interpolator, selector);
+    }
+
+    auto byWeight = [](Particle<1> const& part1, Particle<1> const& part2) {
+        return part1.weight < part2.weight;
+    };
+
+    ASSERT_NE(newEnd, std::end(particlesIn));
+    EXPECT_TRUE(std::all_of(std::begin(particlesIn), newEnd, selector));
+    EXPECT_TRUE(std::none_of(newEnd, std::end(particlesIn), selector));
+    EXPECT_TRUE(std::is_sorted(std::begin(particlesIn), newEnd, byWeight));
+    EXPECT_TRUE(std::is_sorted(newEnd, std::end(particlesIn), byWeight));
+}
+
+
+
+// with a stable partition, pushing the particles chunk by chunk must give the same
+// particles, in the same order, as pushing them step by step on the whole range
+TEST_F(APusherWithLeavingParticles, givesTheSameParticlesInFusedMode)
+{
+    BorisPusher<1, ParticleArray<1>::iterator, Electromag, Interpolator,
+                ParticleSelector<Box<int, 1>>, BoundaryCondition<1, 1>>
+        fusedPusher{PartitionStrategy::Stable};
+    fusedPusher.setFused(true);
+    fusedPusher.setMeshAndTimeStep({{dx}}, dt);
+    pusher->setPartitionStrategy(PartitionStrategy::Stable);
+
+    bc.setBoundaryBoxes(std::vector<Box<int, 1>>{});
+
+    std::copy(std::begin(particlesIn), std::end(particlesIn), std::begin(particlesOut1));
+    std::copy(std::begin(particlesIn), std::end(particlesIn), std::begin(particlesOut2));
+
+    auto rangeStaged = makeRange(std::begin(particlesOut1), std::end(particlesOut1));
+    auto rangeFused  = makeRange(std::begin(particlesOut2), std::end(particlesOut2));
+
+    auto endStaged = std::end(particlesOut1);
+    auto endFused  = std::end(particlesOut2);
+
+    for (decltype(nt) i = 0; i < nt && endStaged == std::end(particlesOut1); ++i)
+    {
+        endStaged = pusher->move(rangeStaged, rangeStaged, em, mass, charge, interpolator,
+                                 selector, bc);
+        endFused  = fusedPusher.move(rangeFused, rangeFused, em, mass, charge, interpolator,
+                                    selector, bc);
+    }
+
+    ASSERT_NE(endStaged, std::end(particlesOut1));
+    ASSERT_EQ(std::distance(std::begin(particlesOut1), endStaged),
+              std::distance(std::begin(particlesOut2), endFused));
+
+    for (auto iPart = 0; iPart < std::distance(std::begin(particlesOut1), endStaged); ++iPart)
+    {
+        EXPECT_EQ(particlesOut1[iPart].iCell, particlesOut2[iPart].iCell);
+        EXPECT_EQ(particlesOut1[iPart].delta, particlesOut2[iPart].delta);
+        EXPECT_EQ(particlesOut1[iPart].v, particlesOut2[iPart].v);
+    }
+    EXPECT_TRUE(std::none_of(endFused, std::end(particlesOut2), selector));
+}
+
+
+
+class AThreadedPusher : public ::testing::Test
+{
+public:
+    using Pusher_t = BorisPusher<1, ParticleArray<1>::iterator, Electromag, Interpolator,
+                                 ParticleSelector<Box<int, 1>>, BoundaryCondition<1, 1>>;
+
+    AThreadedPusher()
+        : domain{Point<int, 1>{0}, Point<int, 1>{10}}
+        , selector{domain}
+    {
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<> cell(0, 9);
+        std::uniform_real_distribution<float> delta(0, 1);
+        std::uniform_real_distribution<double> velocity(-50, 50);
+
+        // particles are numbered with their weight so that they can be identified
+        for (auto iPart = 0u; iPart < nbrParticles; ++iPart)
+        {
+            Particle<1> part;
+            part.weight = iPart;
+            part.iCell  = {{cell(gen)}};
+            part.delta  = {{delta(gen)}};
+            part.v      = {{velocity(gen), velocity(gen), velocity(gen)}};
+            particles.push_back(part);
+        }
+
+        serialPusher.setMeshAndTimeStep({{0.05}}, 0.001);
+        threadedPusher.setMeshAndTimeStep({{0.05}}, 0.001);
+        threadedPusher.setThreadPool(std::make_shared<ThreadPool>(4));
+    }
+
+
+    // pushes the particles with both pushers and returns the numbers of staying particles
+    std::pair<std::ptrdiff_t, std::ptrdiff_t> push(ParticleArray<1>& serialParticles,
+                                                   ParticleArray<1>& threadedParticles)
+    {
+        auto serialRange   = makeRange(std::begin(serialParticles), std::end(serialParticles));
+        auto threadedRange = makeRange(std::begin(threadedParticles), std::end(threadedParticles));
+
+        auto serialEnd
+            = serialPusher.move(serialRange, serialRange, em, 1., 1., interpolator, selector);
+        auto threadedEnd
+            = threadedPusher.move(threadedRange, threadedRange, em, 1., 1., interpolator, selector);
+
+        return {std::distance(std::begin(serialParticles), serialEnd),
+                std::distance(std::begin(threadedParticles), threadedEnd)};
+    }
+
+
+    static std::vector<double> weightsOf(ParticleArray<1>& particles, std::ptrdiff_t first,
+                                         std::ptrdiff_t last)
+    {
+        std::vector<double> weights(std::begin(particles.weights()) + first,
+                                    std::begin(particles.weights()) + last);
+        std::sort(std::begin(weights), std::end(weights));
+        return weights;
+    }
+
+
+protected:
+    std::size_t const nbrParticles = 10000;
+    ParticleArray<1> particles;
+    Pusher_t serialPusher;
+    Pusher_t threadedPusher;
+    Electromag em;
+    Interpolator interpolator;
+    Box<int, 1> domain;
+    ParticleSelector<Box<int, 1>> selector;
+};
+
+
+
+TEST_F(AThreadedPusher, givesTheSameParticlesInTheSameOrderWithAStablePartition)
+{
+    serialPusher.setPartitionStrategy(PartitionStrategy::Stable);
+    threadedPusher.setPartitionStrategy(PartitionStrategy::Stable);
+
+    auto serialParticles   = particles;
+    auto threadedParticles = particles;
+
+    auto [nbrSerial, nbrThreaded] = push(serialParticles, threadedParticles);
+
+    ASSERT_LT(nbrSerial, static_cast<std::ptrdiff_t>(nbrParticles));
+    ASSERT_EQ(nbrSerial, nbrThreaded);
+    for (auto iPart = 0; iPart < nbrSerial; ++iPart)
+    {
+        EXPECT_EQ(serialParticles[iPart].weight, threadedParticles[iPart].weight);
+        EXPECT_EQ(serialParticles[iPart].iCell, threadedParticles[iPart].iCell);
+        EXPECT_EQ(serialParticles[iPart].delta, threadedParticles[iPart].delta);
+        EXPECT_EQ(serialParticles[iPart].v, threadedParticles[iPart].v);
+    }
+}
+
+
+
+TEST_F(AThreadedPusher, givesTheSameStayingAndLeavingParticlesWithASwapPartition)
+{
+    auto serialParticles   = particles;
+    auto threadedParticles = particles;
+
+    auto [nbrSerial, nbrThreaded] = push(serialParticles, threadedParticles);
+    auto const nbr                = static_cast<std::ptrdiff_t>(nbrParticles);
+
+    ASSERT_LT(nbrSerial, nbr);
+    ASSERT_EQ(nbrSerial, nbrThreaded);
+    EXPECT_EQ(weightsOf(serialParticles, 0, nbrSerial), weightsOf(threadedParticles, 0, nbrSerial));
+    EXPECT_EQ(weightsOf(serialParticles, nbrSerial, nbr),
+              weightsOf(threadedParticles, nbrSerial, nbr));
+    EXPECT_TRUE(std::all_of(std::begin(threadedParticles),
+                            std::begin(threadedParticles) + nbrThreaded, selector));
+    EXPECT_TRUE(std::none_of(std::begin(threadedParticles) + nbrThreaded,
+                             std::end(threadedParticles), selector));
+}
+
+
+
+TEST(ABorisPusher, acceleratesParticleArraysAsOtherParticleContainers)
+{
+    std::size_t const nbrParticles = 1037; // not a multiple of the number of simd lanes
+
+    std::vector<Particle<1>> particleVector(nbrParticles);
+    for (auto iPart = 0u; iPart < nbrParticles; ++iPart)
+    {
+        auto& part = particleVector[iPart];
+        part.iCell = {{static_cast<int>(iPart % 50)}};
+        part.delta = {{0.37f}};
+        part.v     = {{1. + 0.01 * iPart, -2., 0.5 - 0.001 * iPart}};
+    }
+
+    ParticleArray<1> particleArray;
+    for (auto const& part : particleVector)
+    {
+        particleArray.push_back(part);
+    }
+
+    BorisPusher<1, std::vector<Particle<1>>::iterator, Electromag, VaryingFieldsInterpolator,
+                DummySelector, BoundaryCondition<1, 1>>
+        scalarPusher;
+    BorisPusher<1, ParticleArray<1>::iterator, Electromag, VaryingFieldsInterpolator,
+                DummySelector, BoundaryCondition<1, 1>>
+        simdPusher;
+
+    scalarPusher.setMeshAndTimeStep({{0.05}}, 0.01);
+    simdPusher.setMeshAndTimeStep({{0.05}}, 0.01);
+
+    Electromag em;
+    VaryingFieldsInterpolator interpolator;
+    DummySelector selector;
+
+    auto vectorRange = makeRange(std::begin(particleVector), std::end(particleVector));
+    auto arrayRange  = makeRange(std::begin(particleArray), std::end(particleArray));
+
+    for (auto i = 0u; i < 10; ++i)
+    {
+        scalarPusher.move(vectorRange, vectorRange, em, 1., 1., interpolator, selector);
+        simdPusher.move(arrayRange, arrayRange, em, 1., 1., interpolator, selector);
+    }
+
+    for (auto iPart = 0u; iPart < nbrParticles; ++iPart)
+    {
+        for (auto iComp = 0u; iComp < 3; ++iComp)
+        {
+            EXPECT_NEAR(particleVector[iPart].v[iComp], particleArray[iPart].v[iComp], 1e-12);
+        }
+    }
+}
+
+
+
 TEST(APusherFactory, canReturnABorisPusher)
 {
     auto pusher = PusherFactory::makePusher<1, ParticleArray<1>::iterator, Electromag, Interpolator,
@@ -505,6 +856,68 @@ TEST(APusherFactory, canReturnABorisPusher)
 
 
 
+TEST(APusherFactory, throwsIfThePusherNameIsUnknown)
+{
+    auto makePusher = PusherFactory::makePusher<1, ParticleArray<1>::iterator, Electromag,
+                                                Interpolator, DummySelector,
+                                                BoundaryCondition<1, 1>>;
+
+    EXPECT_THROW(makePusher("leapfrog"), std::runtime_error);
+}
+
+
+
+// the electric field being perpendicular to B, the kinetic energy in the frame drifting
+// at E x B / B^2 must be kept whatever the time step
+TEST(ABorisPusher, keepsTheKineticEnergyInTheDriftFrameWithALargeTimeStep)
+{
+    double const Ex = CrossedFieldsInterpolator::Ex, Ey = CrossedFieldsInterpolator::Ey,
+                 Ez = CrossedFieldsInterpolator::Ez;
+    double const Bx = CrossedFieldsInterpolator::Bx, By = CrossedFieldsInterpolator::By,
+                 Bz = CrossedFieldsInterpolator::Bz;
+    double const B2 = Bx * Bx + By * By + Bz * Bz;
+
+    std::array<double, 3> const drift
+        = {{(Ey * Bz - Ez * By) / B2, (Ez * Bx - Ex * Bz) / B2, (Ex * By - Ey * Bx) / B2}};
+
+    auto energyInDriftFrame = [&drift](Particle<1> const& part) {
+        double energy = 0.;
+        for (auto iComp = 0u; iComp < 3; ++iComp)
+        {
+            energy += (part.v[iComp] - drift[iComp]) * (part.v[iComp] - drift[iComp]);
+        }
+        return energy;
+    };
+
+    auto pusher = PusherFactory::makePusher<1, ParticleArray<1>::iterator, Electromag,
+                                            CrossedFieldsInterpolator, DummySelector,
+                                            BoundaryCondition<1, 1>>("boris");
+
+    // omega_c = sqrt(3), i.e. more than 3 radians per step
+    pusher->setMeshAndTimeStep({{0.05}}, 2.);
+
+    ParticleArray<1> particles(1);
+    particles[0].iCell = {{5}};
+    particles[0].delta = {{0.f}};
+    particles[0].v     = {{0., 10., 0.}};
+
+    auto const initialEnergy = energyInDriftFrame(particles[0]);
+
+    Electromag em;
+    CrossedFieldsInterpolator interpolator;
+    DummySelector selector;
+    auto range = makeRange(std::begin(particles), std::end(particles));
+
+    for (auto i = 0u; i < 1000; ++i)
+    {
+        pusher->move(range, range, em, 1., 1., interpolator, selector);
+    }
+
+    EXPECT_NEAR(initialEnergy, energyInDriftFrame(particles[0]), 1e-9 * initialEnergy);
+}
+
+
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
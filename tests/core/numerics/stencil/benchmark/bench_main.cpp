@@ -0,0 +1,144 @@
+// compares applyLinearCombination with a node by node evaluation of the same WeightPoint table
+//
+// for some tables of GridLayoutImplYee, the source is projected onto the physical nodes of
+// the destination of a patch of nbrCells cells in each direction, nbrRepetitions times, with
+// - pointwise: for each node, a loop over the points of the table and their indexes
+// - applyLinearCombination: the table known at compile time, row by row
+// and the benchmark reports the time taken per node.
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "data/field/field.h"
+#include "data/grid/gridlayout.h"
+#include "data/grid/gridlayout_impl.h"
+#include "data/ndarray/ndarray_vector.h"
+#include "hybrid/hybrid_quantities.h"
+#include "numerics/stencil/linear_combination.h"
+#include "numerics/stencil/row_stencil.h"
+
+using namespace PHARE;
+
+
+uint32 const nbrRepetitions = 20;
+
+using Scalar = HybridQuantity::Scalar;
+
+
+
+
+template<typename Field, typename Table, std::size_t dim>
+void pointwise(Field const& source, Field& destination, Table const& table,
+               Box<uint32, dim> const& box)
+{
+    forEachRow(box, [&](std::array<uint32, dim> const& first, uint32 size) {
+        auto index = first;
+        for (auto i = 0u; i < size; ++i, ++index[dim - 1])
+        {
+            double value = 0.;
+            for (auto const& point : table)
+            {
+                auto sourceIndex = index;
+                for (auto iDir = 0u; iDir < dim; ++iDir)
+                {
+                    sourceIndex[iDir] = static_cast<uint32>(static_cast<int>(index[iDir])
+                                                            + point.indexes[iDir]);
+                }
+                value += point.coef * nodeAt(source, sourceIndex);
+            }
+            nodeAt(destination, index) = value;
+        }
+    });
+}
+
+
+
+
+template<typename Function>
+double nanosecondsPerNode(Function&& function, std::size_t nbrNodes)
+{
+    function(); // warm up
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (auto iRepetition = 0u; iRepetition < nbrRepetitions; ++iRepetition)
+    {
+        function();
+    }
+    auto stop = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration<double, std::nano>(stop - start).count()
+           / (nbrRepetitions * nbrNodes);
+}
+
+
+
+
+template<std::size_t dim, std::size_t interpOrder, auto combination, Scalar sourceQuantity,
+         Scalar destinationQuantity>
+void benchmark(std::string const& name, uint32 nbrCells)
+{
+    using GridLayoutT = GridLayout<GridLayoutImplYee<dim, interpOrder>>;
+    using NdArray     = std::conditional_t<
+        dim == 1, NdArrayVector1D<>,
+        std::conditional_t<dim == 2, NdArrayVector2D<>, NdArrayVector3D<>>>;
+    using FieldT = Field<NdArray, Scalar>;
+
+    std::array<double, dim> meshSize;
+    std::array<uint32, dim> cells;
+    meshSize.fill(0.1);
+    cells.fill(nbrCells);
+    GridLayoutT layout{meshSize, cells, Point<double, dim>{}};
+
+    FieldT source{"source", sourceQuantity, layout.allocSize(sourceQuantity)};
+    FieldT destination{"destination", destinationQuantity, layout.allocSize(destinationQuantity)};
+
+    std::mt19937 gen{2019};
+    std::uniform_real_distribution<double> value{-1., 1.};
+    for (auto& node : source)
+    {
+        node = value(gen);
+    }
+
+    auto const box = physicalBox<destinationQuantity>(layout);
+
+    std::size_t nbrNodes = 1;
+    for (auto iDir = 0u; iDir < dim; ++iDir)
+    {
+        nbrNodes *= box.upper[iDir] - box.lower[iDir];
+    }
+
+    // the table is copied so that the pointwise evaluation does not know it at compile time
+    auto table = combination();
+
+    auto const pointwiseTime = nanosecondsPerNode(
+        [&]() { pointwise(source, destination, table, box); }, nbrNodes);
+    auto const combinationTime = nanosecondsPerNode(
+        [&]() { applyLinearCombination<combination>(source, destination, box); }, nbrNodes);
+
+    std::cout << dim << "D order " << interpOrder << " " << name << " (" << table.size()
+              << " points, " << nbrCells << " cells per direction): pointwise "
+              << pointwiseTime << " ns/node, applyLinearCombination " << combinationTime
+              << " ns/node\n";
+}
+
+
+
+
+int main()
+{
+    using Layout1D = GridLayout<GridLayoutImplYee<1, 1>>;
+    using Layout2D = GridLayout<GridLayoutImplYee<2, 1>>;
+    using Layout3D = GridLayout<GridLayoutImplYee<3, 1>>;
+
+    benchmark<1, 1, &Layout1D::momentsToEx, Scalar::rho, Scalar::Ex>("momentsToEx", 100000);
+    benchmark<2, 1, &Layout2D::momentsToEx, Scalar::rho, Scalar::Ex>("momentsToEx", 400);
+    benchmark<2, 1, &Layout2D::BzToEx, Scalar::Bz, Scalar::Ex>("BzToEx", 400);
+    benchmark<3, 1, &Layout3D::momentsToEx, Scalar::rho, Scalar::Ex>("momentsToEx", 64);
+    benchmark<3, 1, &Layout3D::ExToMoments, Scalar::Ex, Scalar::rho>("ExToMoments", 64);
+    benchmark<3, 1, &Layout3D::BzToEx, Scalar::Bz, Scalar::Ex>("BzToEx", 64);
+    benchmark<3, 1, &Layout3D::ByToEz, Scalar::By, Scalar::Ez>("ByToEz", 64);
+}
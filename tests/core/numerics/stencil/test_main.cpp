@@ -0,0 +1,344 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "data/field/field.h"
+#include "data/grid/gridlayout.h"
+#include "data/grid/gridlayout_impl.h"
+#include "data/ndarray/ndarray_vector.h"
+#include "hybrid/hybrid_quantities.h"
+#include "numerics/stencil/for_each_in_box.h"
+#include "numerics/stencil/linear_combination.h"
+#include "numerics/stencil/row_stencil.h"
+#include "utilities/thread_pool/thread_pool.h"
+
+
+using namespace PHARE;
+
+using Scalar = HybridQuantity::Scalar;
+
+
+
+template<typename GridLayoutImpl>
+class ALinearCombination : public ::testing::Test
+{
+public:
+    static constexpr std::size_t dim = GridLayoutImpl::dimension;
+
+    using GridLayoutT = GridLayout<GridLayoutImpl>;
+    using NdArray     = std::conditional_t<
+        dim == 1, NdArrayVector1D<>,
+        std::conditional_t<dim == 2, NdArrayVector2D<>, NdArrayVector3D<>>>;
+    using FieldT = Field<NdArray, Scalar>;
+
+
+    GridLayoutT layout{meshSize(), nbrCells(), Point<double, dim>{}};
+
+
+    static std::array<double, dim> meshSize()
+    {
+        std::array<double, dim> meshSize;
+        meshSize.fill(0.1);
+        return meshSize;
+    }
+
+    static std::array<uint32, dim> nbrCells()
+    {
+        std::array<uint32, dim> nbrCells;
+        for (auto iDir = 0u; iDir < dim; ++iDir)
+        {
+            nbrCells[iDir] = 9 - 2 * iDir;
+        }
+        return nbrCells;
+    }
+
+
+    FieldT randomField(Scalar quantity)
+    {
+        FieldT field{"source", quantity, layout.allocSize(quantity)};
+        std::generate(std::begin(field), std::end(field), [&]() { return value(gen); });
+        return field;
+    }
+
+
+    /** projects source onto the physical nodes of destination with combination, and compares
+     * it with the projection computed node by node from the same table
+     */
+    template<auto combination, Scalar sourceQuantity, Scalar destinationQuantity>
+    void expectSameAsPointwiseProjection()
+    {
+        auto const source = randomField(sourceQuantity);
+        FieldT actual{"actual", destinationQuantity, layout.allocSize(destinationQuantity)};
+        FieldT expected{"expected", destinationQuantity, layout.allocSize(destinationQuantity)};
+
+        auto const box = physicalBox<destinationQuantity>(layout);
+
+        applyLinearCombination<combination>(source, actual, box);
+
+        constexpr auto points = combination();
+        forEachRow(box, [&](std::array<uint32, dim> const& first, uint32 size) {
+            auto index = first;
+            for (auto i = 0u; i < size; ++i, ++index[dim - 1])
+            {
+                double projected = 0.;
+                for (auto const& point : points)
+                {
+                    auto sourceIndex = index;
+                    for (auto iDir = 0u; iDir < dim; ++iDir)
+                    {
+                        sourceIndex[iDir] = static_cast<uint32>(static_cast<int>(index[iDir])
+                                                                + point.indexes[iDir]);
+                    }
+                    projected += point.coef * nodeAt(source, sourceIndex);
+                }
+                nodeAt(expected, index) = projected;
+            }
+        });
+
+        EXPECT_THAT(std::vector<double>(std::begin(actual), std::end(actual)),
+                    ::testing::Pointwise(::testing::DoubleEq(),
+                                         std::vector<double>(std::begin(expected),
+                                                             std::end(expected))));
+    }
+
+
+private:
+    std::mt19937 gen{2019};
+    std::uniform_real_distribution<double> value{-1., 1.};
+};
+
+
+using LayoutsToTest
+    = ::testing::Types<GridLayoutImplYee<1, 1>, GridLayoutImplYee<1, 3>, GridLayoutImplYee<2, 1>,
+                       GridLayoutImplYee<2, 2>, GridLayoutImplYee<3, 1>, GridLayoutImplYee<3, 3>>;
+
+TYPED_TEST_CASE(ALinearCombination, LayoutsToTest);
+
+
+
+
+TYPED_TEST(ALinearCombination, projectsMomentsOntoE)
+{
+    this->template expectSameAsPointwiseProjection<&TestFixture::GridLayoutT::momentsToEx,
+                                                   Scalar::rho, Scalar::Ex>();
+    this->template expectSameAsPointwiseProjection<&TestFixture::GridLayoutT::momentsToEy,
+                                                   Scalar::rho, Scalar::Ey>();
+    this->template expectSameAsPointwiseProjection<&TestFixture::GridLayoutT::momentsToEz,
+                                                   Scalar::rho, Scalar::Ez>();
+}
+
+
+
+
+TYPED_TEST(ALinearCombination, projectsEOntoMoments)
+{
+    this->template expectSameAsPointwiseProjection<&TestFixture::GridLayoutT::ExToMoments,
+                                                   Scalar::Ex, Scalar::rho>();
+    this->template expectSameAsPointwiseProjection<&TestFixture::GridLayoutT::EyToMoments,
+                                                   Scalar::Ey, Scalar::rho>();
+    this->template expectSameAsPointwiseProjection<&TestFixture::GridLayoutT::EzToMoments,
+                                                   Scalar::Ez, Scalar::rho>();
+}
+
+
+
+
+TYPED_TEST(ALinearCombination, projectsBOntoE)
+{
+    this->template expectSameAsPointwiseProjection<&TestFixture::GridLayoutT::ByToEx,
+                                                   Scalar::By, Scalar::Ex>();
+    this->template expectSameAsPointwiseProjection<&TestFixture::GridLayoutT::BzToEx,
+                                                   Scalar::Bz, Scalar::Ex>();
+    this->template expectSameAsPointwiseProjection<&TestFixture::GridLayoutT::BxToEy,
+                                                   Scalar::Bx, Scalar::Ey>();
+    this->template expectSameAsPointwiseProjection<&TestFixture::GridLayoutT::BzToEy,
+                                                   Scalar::Bz, Scalar::Ey>();
+    this->template expectSameAsPointwiseProjection<&TestFixture::GridLayoutT::BxToEz,
+                                                   Scalar::Bx, Scalar::Ez>();
+    this->template expectSameAsPointwiseProjection<&TestFixture::GridLayoutT::ByToEz,
+                                                   Scalar::By, Scalar::Ez>();
+}
+
+
+
+
+TEST(ALinearCombination, onlyChangesTheNodesOfTheBox)
+{
+    using GridLayoutT = GridLayout<GridLayoutImplYee<2, 1>>;
+
+    GridLayoutT layout{{{0.1, 0.1}}, {{6, 5}}, Point<double, 2>{0., 0.}};
+
+    Field<NdArrayVector2D<>, Scalar> rho{"rho", Scalar::rho, layout.allocSize(Scalar::rho)};
+    Field<NdArrayVector2D<>, Scalar> Ex{"Ex", Scalar::Ex, layout.allocSize(Scalar::Ex)};
+    std::fill(std::begin(rho), std::end(rho), 2.);
+    std::fill(std::begin(Ex), std::end(Ex), -1.);
+
+    auto box     = physicalBox<Scalar::Ex>(layout);
+    box.lower[0] = box.lower[0] + 1;
+    box.upper[1] = box.upper[1] - 2;
+
+    applyLinearCombination<&GridLayoutT::momentsToEx>(rho, Ex, box);
+
+    auto const allocSize = layout.allocSize(Scalar::Ex);
+    for (auto ix = 0u; ix < allocSize[0]; ++ix)
+    {
+        for (auto iy = 0u; iy < allocSize[1]; ++iy)
+        {
+            bool const inBox = ix >= box.lower[0] && ix < box.upper[0] && iy >= box.lower[1]
+                               && iy < box.upper[1];
+            EXPECT_DOUBLE_EQ(inBox ? 2. : -1., Ex(ix, iy));
+        }
+    }
+}
+
+
+
+
+Box<uint32, 3> makeBox(std::array<uint32, 3> const& lower, std::array<uint32, 3> const& upper)
+{
+    Box<uint32, 3> box;
+    for (auto iDir = 0u; iDir < 3; ++iDir)
+    {
+        box.lower[iDir] = lower[iDir];
+        box.upper[iDir] = upper[iDir];
+    }
+    return box;
+}
+
+
+/** number of times each node of a 3D grid of shape nodes is visited by forEachInBox over
+ * box, 0 outside of box
+ */
+template<typename Policy>
+std::vector<int> nbrVisits(Box<uint32, 3> const& box, std::array<uint32, 3> const& tileShape,
+                           Policy const& policy)
+{
+    std::array<uint32, 3> const shape{{12, 11, 10}};
+    std::vector<int> visits(shape[0] * shape[1] * shape[2], 0);
+
+    forEachInBox(box, tileShape, policy, [&](std::array<uint32, 3> const& index) {
+        ++visits[(index[0] * shape[1] + index[1]) * shape[2] + index[2]];
+    });
+    return visits;
+}
+
+
+
+
+TEST(ForEachInBox, visitsEachNodeOfTheBoxOnceWithAllPolicies)
+{
+    auto const box = makeBox({{1, 2, 0}}, {{11, 9, 10}});
+    std::array<uint32, 3> const tileShape{{3, 4, 5}};
+
+    std::vector<int> expected(12 * 11 * 10, 0);
+    for (auto ix = 1u; ix < 11; ++ix)
+    {
+        for (auto iy = 2u; iy < 9; ++iy)
+        {
+            for (auto iz = 0u; iz < 10; ++iz)
+            {
+                expected[(ix * 11 + iy) * 10 + iz] = 1;
+            }
+        }
+    }
+
+    auto const pool = std::make_shared<ThreadPool>(4);
+
+    EXPECT_EQ(expected, nbrVisits(box, tileShape, SerialPolicy{}));
+    EXPECT_EQ(expected, nbrVisits(box, tileShape, OpenMPPolicy{Schedule::Static}));
+    EXPECT_EQ(expected, nbrVisits(box, tileShape, OpenMPPolicy{Schedule::Dynamic}));
+    EXPECT_EQ(expected, nbrVisits(box, tileShape, ThreadPoolPolicy{pool, Schedule::Static}));
+    EXPECT_EQ(expected, nbrVisits(box, tileShape, ThreadPoolPolicy{pool, Schedule::Dynamic}));
+    EXPECT_EQ(expected, nbrVisits(box, tileShape, ThreadPoolPolicy{nullptr}));
+}
+
+
+
+
+TEST(ForEachInBox, visitsTheNodesTileByTileInMemoryOrder)
+{
+    Box<uint32, 2> box;
+    box.lower[0] = 0;
+    box.lower[1] = 0;
+    box.upper[0] = 3;
+    box.upper[1] = 5;
+
+    std::vector<std::array<uint32, 2>> tiles;
+    forEachTile(box, {{2, 3}}, SerialPolicy{}, [&](Box<uint32, 2> const& tile) {
+        tiles.push_back({{tile.lower[0], tile.lower[1]}});
+        tiles.push_back({{tile.upper[0], tile.upper[1]}});
+    });
+
+    std::vector<std::array<uint32, 2>> const expectedTiles{
+        {{0, 0}}, {{2, 3}}, {{0, 3}}, {{2, 5}}, {{2, 0}}, {{3, 3}}, {{2, 3}}, {{3, 5}}};
+    EXPECT_EQ(expectedTiles, tiles);
+
+    std::vector<std::array<uint32, 2>> nodes;
+    forEachInBox(box, {{2, 3}}, SerialPolicy{},
+                 [&](std::array<uint32, 2> const& index) { nodes.push_back(index); });
+
+    std::vector<std::array<uint32, 2>> const expectedNodes{
+        {{0, 0}}, {{0, 1}}, {{0, 2}}, {{1, 0}}, {{1, 1}}, {{1, 2}}, {{0, 3}}, {{0, 4}},
+        {{1, 3}}, {{1, 4}}, {{2, 0}}, {{2, 1}}, {{2, 2}}, {{2, 3}}, {{2, 4}}};
+    EXPECT_EQ(expectedNodes, nodes);
+}
+
+
+
+
+TEST(ForEachInBox, doesNothingOnAnEmptyBox)
+{
+    auto const box = makeBox({{2, 2, 2}}, {{5, 2, 5}});
+
+    EXPECT_EQ(std::vector<int>(12 * 11 * 10, 0), nbrVisits(box, {{2, 2, 2}}, SerialPolicy{}));
+}
+
+
+
+
+TEST(ForEachInBox, cannotHaveEmptyTiles)
+{
+    auto const box = makeBox({{0, 0, 0}}, {{4, 4, 4}});
+
+    EXPECT_ANY_THROW(nbrVisits(box, {{2, 0, 2}}, SerialPolicy{}));
+}
+
+
+
+
+TEST(ForEachInBox, rethrowsTheExceptionOfANodeFunction)
+{
+    auto const box  = makeBox({{0, 0, 0}}, {{8, 8, 8}});
+    auto const pool = std::make_shared<ThreadPool>(4);
+
+    auto throwOnANode = [](std::array<uint32, 3> const& index) {
+        if (index[0] == 5 && index[1] == 2 && index[2] == 7)
+        {
+            throw std::runtime_error("Error - node function failed");
+        }
+    };
+
+    EXPECT_THROW(forEachInBox(box, {{2, 2, 2}}, SerialPolicy{}, throwOnANode),
+                 std::runtime_error);
+    EXPECT_THROW(forEachInBox(box, {{2, 2, 2}}, OpenMPPolicy{}, throwOnANode),
+                 std::runtime_error);
+    EXPECT_THROW(forEachInBox(box, {{2, 2, 2}}, ThreadPoolPolicy{pool}, throwOnANode),
+                 std::runtime_error);
+}
+
+
+
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
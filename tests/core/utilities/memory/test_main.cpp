@@ -0,0 +1,208 @@
+#include <cstdint>
+#include <thread>
+
+#include "utilities/memory/aligned_allocator.h"
+#include "utilities/memory/memory_pool.h"
+
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+
+using PHARE::AlignedVector;
+using PHARE::MemoryPool;
+using PHARE::PooledVector;
+using PHARE::simdAlignment;
+
+
+template<typename Vector>
+bool isAligned(Vector const& vector)
+{
+    return reinterpret_cast<std::uintptr_t>(vector.data()) % simdAlignment == 0;
+}
+
+
+
+TEST(AnAlignedVector, hasItsFirstElementOnASimdBoundary)
+{
+    AlignedVector<double> values(17);
+    EXPECT_TRUE(isAligned(values));
+}
+
+
+
+TEST(AMemoryPool, givesBlocksOfAPowerOfTwoBytes)
+{
+    EXPECT_EQ(0u, MemoryPool::sizeClass(1));
+    EXPECT_EQ(0u, MemoryPool::sizeClass(64));
+    EXPECT_EQ(1u, MemoryPool::sizeClass(65));
+    EXPECT_EQ(4u, MemoryPool::sizeClass(1000));
+    EXPECT_EQ(1024u, MemoryPool::blockSize(4));
+}
+
+
+
+TEST(AMemoryPool, reusesTheBlocksItWasGivenBack)
+{
+    MemoryPool pool;
+
+    void* first = pool.allocate(1000);
+    pool.deallocate(first, 1000);
+    EXPECT_EQ(1024u, pool.cachedBytes());
+
+    void* second = pool.allocate(900);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(1u, pool.nbrSystemAllocations());
+    EXPECT_EQ(0u, pool.cachedBytes());
+
+    pool.deallocate(second, 900);
+}
+
+
+
+TEST(AMemoryPool, doesNotCacheMoreThanItsCapacity)
+{
+    MemoryPool pool;
+    pool.setCapacity(1024);
+
+    void* first  = pool.allocate(1024);
+    void* second = pool.allocate(1024);
+    pool.deallocate(first, 1024);
+    pool.deallocate(second, 1024);
+
+    EXPECT_EQ(1024u, pool.cachedBytes());
+
+    pool.release();
+    EXPECT_EQ(0u, pool.cachedBytes());
+}
+
+
+
+TEST(AMemoryPool, givesLargeBlocksBackToTheSystemWithoutRoundingThem)
+{
+    MemoryPool pool;
+    auto const bytes = MemoryPool::maxBlockSize + 1000;
+
+    void* block = pool.allocate(bytes);
+    EXPECT_EQ(1u, pool.nbrSystemAllocations());
+
+    pool.deallocate(block, bytes);
+    EXPECT_EQ(0u, pool.cachedBytes());
+}
+
+
+
+TEST(AMemoryPool, reportsTheSizeOfTheBlocksItGives)
+{
+    auto const maxBlockSize = MemoryPool::maxBlockSize;
+
+    EXPECT_EQ(0u, MemoryPool::allocatedSize(0));
+    EXPECT_EQ(1024u, MemoryPool::allocatedSize(1000));
+    EXPECT_EQ(maxBlockSize, MemoryPool::allocatedSize(maxBlockSize - 1));
+    EXPECT_EQ(maxBlockSize + 1, MemoryPool::allocatedSize(maxBlockSize + 1));
+}
+
+
+
+TEST(AMemoryPool, canReleaseASingleCachedBlock)
+{
+    MemoryPool pool;
+
+    void* small  = pool.allocate(100);
+    void* large1 = pool.allocate(1000);
+    void* large2 = pool.allocate(1000);
+    pool.deallocate(small, 100);
+    pool.deallocate(large1, 1000);
+    pool.deallocate(large2, 1000);
+    EXPECT_EQ(128u + 2 * 1024u, pool.cachedBytes());
+
+    pool.releaseBlock(large1, 1000);
+    EXPECT_EQ(128u + 1024u, pool.cachedBytes());
+
+    // released blocks are not cached anymore, releasing them again does nothing
+    pool.releaseBlock(large1, 1000);
+    EXPECT_EQ(128u + 1024u, pool.cachedBytes());
+
+    // the block left in the size class is the one given back next
+    EXPECT_EQ(large2, pool.allocate(1000));
+    pool.deallocate(large2, 1000);
+}
+
+
+
+TEST(AMemoryPool, cachesAFewTensOfMegabytesByDefault)
+{
+    MemoryPool pool;
+
+    EXPECT_EQ(MemoryPool::defaultCapacity, pool.capacity());
+    EXPECT_LE(pool.capacity(), std::size_t{64} << 20);
+}
+
+
+
+TEST(AMemoryPool, releasesTheBlocksOfAllThreadsWhenAsked)
+{
+    std::size_t cachedBeforeRelease = 0;
+    std::size_t cachedAfterRelease  = 1;
+
+    std::thread other{[&]() {
+        auto& pool = *MemoryPool::threadLocal();
+        pool.deallocate(pool.allocate(1000), 1000);
+        cachedBeforeRelease = pool.cachedBytes();
+
+        // only the calling thread releases its pool at once, this one will at its next use
+        std::thread releasing{[]() { MemoryPool::releaseAll(); }};
+        releasing.join();
+
+        void* block        = pool.allocate(64);
+        cachedAfterRelease = pool.cachedBytes();
+        pool.deallocate(block, 64);
+    }};
+    other.join();
+
+    EXPECT_EQ(1024u, cachedBeforeRelease);
+    EXPECT_EQ(0u, cachedAfterRelease);
+}
+
+
+
+TEST(APooledVector, isAlignedAndReusesMemoryOfPreviousVectors)
+{
+    auto& pool = *MemoryPool::threadLocal();
+    pool.release();
+
+    double const* data = nullptr;
+    {
+        PooledVector<double> values(1000);
+        data = values.data();
+        EXPECT_TRUE(isAligned(values));
+    }
+
+    auto nbrSystemAllocations = pool.nbrSystemAllocations();
+
+    PooledVector<double> values(1000);
+    EXPECT_EQ(data, values.data());
+    EXPECT_EQ(nbrSystemAllocations, pool.nbrSystemAllocations());
+}
+
+
+
+TEST(APooledVector, canBeReleasedByAnotherThread)
+{
+    MemoryPool::threadLocal()->release();
+    auto values = new PooledVector<double>(1000);
+
+    std::thread other{[values]() { delete values; }};
+    other.join();
+
+    EXPECT_EQ(0u, MemoryPool::threadLocal()->cachedBytes());
+}
+
+
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
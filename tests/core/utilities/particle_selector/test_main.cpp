@@ -24,7 +24,7 @@ TEST(AParticleSelector1D, returnTrueForParticlesInBox)
     boxes.push_back(std::move(box1));
     boxes.push_back(std::move(box2));
 
-    Particle<1> part{0.01, 1, {{4}}, {{0.002f}}, {{1.8, 1.83, 2.28}}};
+    Particle<1> part{0.01, {{4}}, {{0.002f}}, {{1.8, 1.83, 2.28}}};
 
     auto selector = makeSelector(boxes);
 }
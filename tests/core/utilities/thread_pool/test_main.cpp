@@ -0,0 +1,99 @@
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "utilities/thread_pool/thread_pool.h"
+
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+
+using PHARE::ThreadPool;
+
+
+
+TEST(AThreadPool, runsEachTaskOnce)
+{
+    ThreadPool pool{4};
+    std::vector<int> nbrCalls(1000, 0);
+
+    pool.parallelFor(nbrCalls.size(), [&nbrCalls](std::size_t iTask) { ++nbrCalls[iTask]; });
+
+    EXPECT_THAT(nbrCalls, ::testing::Each(1));
+}
+
+
+
+TEST(AThreadPool, canRunSeveralLoopsInARow)
+{
+    ThreadPool pool{4};
+    std::atomic<std::size_t> sum{0};
+
+    for (auto iLoop = 0u; iLoop < 100; ++iLoop)
+    {
+        pool.parallelFor(10, [&sum](std::size_t iTask) { sum += iTask; });
+    }
+
+    EXPECT_EQ(100u * 45u, sum);
+}
+
+
+
+TEST(AThreadPool, ofOneThreadRunsTasksOnTheCallingThread)
+{
+    ThreadPool pool{1};
+    EXPECT_EQ(1u, pool.size());
+
+    std::vector<std::size_t> order;
+    pool.parallelFor(5, [&order](std::size_t iTask) { order.push_back(iTask); });
+
+    EXPECT_THAT(order, ::testing::ElementsAre(0, 1, 2, 3, 4));
+}
+
+
+
+TEST(AThreadPool, runsNestedLoopsSerially)
+{
+    ThreadPool pool{4};
+    std::atomic<std::size_t> nbrCalls{0};
+
+    pool.parallelFor(8, [&](std::size_t) {
+        pool.parallelFor(8, [&nbrCalls](std::size_t) { ++nbrCalls; });
+    });
+
+    EXPECT_EQ(64u, nbrCalls);
+}
+
+
+
+TEST(AThreadPool, rethrowsTheExceptionOfATask)
+{
+    ThreadPool pool{4};
+    std::atomic<std::size_t> nbrCalls{0};
+
+    EXPECT_THROW(pool.parallelFor(100,
+                                  [&nbrCalls](std::size_t iTask) {
+                                      ++nbrCalls;
+                                      if (iTask == 42)
+                                      {
+                                          throw std::runtime_error("Error - task failed");
+                                      }
+                                  }),
+                 std::runtime_error);
+    EXPECT_EQ(100u, nbrCalls);
+
+    // the pool can still be used after a failed loop
+    pool.parallelFor(10, [&nbrCalls](std::size_t) { ++nbrCalls; });
+    EXPECT_EQ(110u, nbrCalls);
+}
+
+
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}